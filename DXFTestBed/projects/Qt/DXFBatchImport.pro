@@ -0,0 +1,83 @@
+# Project file for DXFBatchImport
+#
+# Headless command line import of DXF files, used for benchmarking
+# remember to set DYLD_FALLBACK_LIBRARY_PATH on MacOSX
+# set LD_LIBRARY_PATH on Linux
+
+TARGET = DXFBatchImport
+TEMPLATE = app
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+greaterThan(QT_MAJOR_VERSION, 4) {
+contains(QT_ARCH, i386): {
+DIR_PREFIX =
+} else {
+DIR_PREFIX = _x64
+}
+} else {
+DIR_PREFIX =
+}
+
+CONFIG(debug, debug|release) {
+OBJECTS_DIR = debug$${DIR_PREFIX}
+DESTDIR = ../../../bin/debug$${DIR_PREFIX}
+}
+else {
+OBJECTS_DIR = release$${DIR_PREFIX}
+DESTDIR = ../../../bin/release$${DIR_PREFIX}
+}
+
+MOC_DIR = moc
+UI_DIR = ui
+
+win32-msvc* {
+QMAKE_CXXFLAGS += /wd4996
+QMAKE_CFLAGS += /wd4996
+DEFINES += _CRT_SECURE_NO_WARNINGS
+DEFINES += NOMINMAX
+}
+else {
+QMAKE_CXXFLAGS += -std=c++11
+}
+
+LIBS += -L../../../externals/lib_x64
+
+LIBS += \
+-lDXFImportPlugin \
+-llibdxfrw \
+-lTiCPP \
+-lIBKMK \
+-lIBK \
+-lglm
+
+win32:LIBS += -lpsapi
+
+INCLUDEPATH = \
+../../src \
+../../../externals/DXFImportPlugin/src \
+../../../externals/TiCPP/src \
+../../../externals/IBKMK/src \
+../../../externals/IBK/src \
+../../../externals/libdxfrw/src \
+../../../externals/libdxfrw/src/intern \
+../../../externals/glm/src \
+../../../externals/glm/src\glm \
+../../../externals/glm/src\gtx \
+../../../externals/QtExt/src
+
+DEPENDPATH = $${INCLUDEPATH}
+
+SOURCES += \
+../../src/BatchImport.cpp \
+../../src/BatchImportMain.cpp
+
+HEADERS += \
+../../src/BatchImport.h
+
+CODECFORSRC = UTF-8
@@ -0,0 +1,363 @@
+#include "BatchImport.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include <random>
+
+#include <tinyxml.h>
+
+#include <IBK_Exception.h>
+#include <IBK_messages.h>
+
+#include <Drawing.h>
+#include <ImportDXFDialog.h>
+
+#if defined(Q_OS_WIN32)
+	#include <Windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/resource.h>
+#endif
+
+
+// *** Allocation counter ***
+
+/* Global operator new is replaced in this executable so that allocations of the whole import
+   (plugin and libdxfrw included) can be counted. On Windows, DLLs keep their own allocator,
+   hence only allocations of the executable itself are counted there.
+*/
+
+static std::atomic<std::size_t> s_allocationCount(0);
+
+static void * countedAllocation(std::size_t size) {
+	s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (size == 0)
+		size = 1;
+	void * p = std::malloc(size);
+	if (p == nullptr)
+		throw std::bad_alloc();
+	return p;
+}
+
+void * operator new(std::size_t size) { return countedAllocation(size); }
+void * operator new[](std::size_t size) { return countedAllocation(size); }
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept {
+	try { return countedAllocation(size); } catch (...) { return nullptr; }
+}
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+	try { return countedAllocation(size); } catch (...) { return nullptr; }
+}
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete[](void * p) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void * p, std::size_t) noexcept { std::free(p); }
+void operator delete(void * p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void * p, const std::nothrow_t &) noexcept { std::free(p); }
+
+
+/*! Measures wall clock time and allocations of a single pipeline stage. */
+class StageTimer {
+public:
+	StageTimer() :
+		m_start(std::chrono::steady_clock::now()),
+		m_allocations(BatchImport::allocationCount())
+	{}
+
+	/*! Adds an entry for the stage to 'stages', adds elapsed time to totalMs and restarts the timer. */
+	void finish(const char * stage, QJsonObject & stages, double & totalMs) {
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		std::size_t allocations = BatchImport::allocationCount();
+		double ms = std::chrono::duration<double, std::milli>(now - m_start).count();
+		QJsonObject s;
+		s["ms"] = ms;
+		s["allocations"] = (double)(allocations - m_allocations);
+		stages[stage] = s;
+		totalMs += ms;
+		m_start = now;
+		m_allocations = allocations;
+	}
+
+private:
+	std::chrono::steady_clock::time_point	m_start;
+	std::size_t								m_allocations;
+};
+
+
+BatchImport::BatchImport(const Options & options) :
+	m_options(options)
+{
+	if (m_options.m_repeat == 0)
+		m_options.m_repeat = 1;
+}
+
+
+QJsonObject BatchImport::importFile(const QString & fname) const {
+	QJsonObject report;
+	report["file"] = fname;
+
+	QFileInfo finfo(fname);
+	if (!finfo.exists()) {
+		report["error"] = QString("File does not exist");
+		return report;
+	}
+	double sizeMB = finfo.size() / 1.0e6;
+	report["sizeMB"] = sizeMB;
+
+	resetPeakRSS();
+
+	QJsonObject bestStages;
+	QJsonObject counts;
+	QJsonObject lookupReport;
+	double bestTotalMs = -1;
+	try {
+		for (unsigned int i = 0; i < m_options.m_repeat; ++i) {
+			QJsonObject stages;
+			double totalMs = 0;
+			counts = runOnce(fname, stages, totalMs, lookupReport);
+			if (bestTotalMs < 0 || totalMs < bestTotalMs) {
+				bestTotalMs = totalMs;
+				bestStages = stages;
+			}
+		}
+	}
+	catch (std::exception & ex) {
+		report["error"] = QString::fromStdString(ex.what());
+		return report;
+	}
+
+	report["stages"] = bestStages;
+	report["totalMs"] = bestTotalMs;
+	report["entities"] = counts;
+	report["peakRSSMB"] = peakRSS() / 1.0e6;
+	if (!lookupReport.isEmpty())
+		report["lookupBenchmark"] = lookupReport;
+
+	double readMs = bestStages["read"].toObject()["ms"].toDouble();
+	if (readMs > 0)
+		report["readMBs"] = sizeMB / (readMs / 1000);
+	if (bestTotalMs > 0)
+		report["totalMBs"] = sizeMB / (bestTotalMs / 1000);
+
+	return report;
+}
+
+
+QJsonObject BatchImport::runOnce(const QString & fname, QJsonObject & stages, double & totalMs, QJsonObject & lookupReport) const {
+	FUNCID(BatchImport::runOnce);
+
+	Drawing drawing;
+	unsigned int nextId = 3;
+
+	StageTimer timer;
+
+	// *** quick scan, done by the dialog when the file is opened ***
+	DRW_ScanInfo scanInfo;
+	{
+		dxfRW dxf(fname.toStdString());
+		dxf.scan(&scanInfo);
+	}
+	timer.finish("prepass", stages, totalMs);
+
+	// *** conversion of the dialog, scaling factor is determined automatically ***
+	ImportDXFDialog::ConvertOptions options;
+	options.m_importText = m_options.m_importText;
+	options.m_simplifyTolerance = m_options.m_simplifyTolerance;
+	options.m_deduplicateTolerance = m_options.m_deduplicateTolerance;
+	options.m_stepFinished = [&](const char * step) {
+		timer.finish(step, stages, totalMs);
+	};
+	ImportDXFDialog::ConvertResults results;
+	ImportDXFDialog::convertDxfFile(fname, scanInfo, options, drawing, nextId, results);
+
+	// *** XML export, same document structure as DXFImportPlugin::import() ***
+	{
+		TiXmlDocument doc;
+		TiXmlDeclaration * decl = new TiXmlDeclaration( "1.1", "UTF-8", "" );
+		doc.LinkEndChild( decl );
+
+		TiXmlElement * root = new TiXmlElement( "VicusProject" );
+		doc.LinkEndChild(root);
+
+		TiXmlElement * e = new TiXmlElement("Project");
+		root->LinkEndChild(e);
+
+		TiXmlElement * drs = new TiXmlElement("Drawings");
+		e->LinkEndChild(drs);
+
+		drawing.writeXML(drs);
+
+		TiXmlPrinter printer;
+		doc.Accept(&printer);
+
+		if (!m_options.m_xmlDir.isEmpty()) {
+			QString xmlFile = QDir(m_options.m_xmlDir).absoluteFilePath(QFileInfo(fname).completeBaseName() + ".xml");
+			std::ofstream out(xmlFile.toStdString().c_str(), std::ios_base::binary);
+			out.write(printer.CStr(), printer.Size());
+			if (!out)
+				throw IBK::Exception(IBK::FormatString("Could not write '%1'.").arg(xmlFile.toStdString()), FUNC_ID);
+		}
+	}
+	timer.finish("writeXML", stages, totalMs);
+
+	// not part of the pipeline, hence not timed as stage
+	if (m_options.m_lookups > 0)
+		lookupReport = lookupBenchmark(drawing);
+
+	QJsonObject counts;
+	counts["layers"] = (int)drawing.m_drawingLayers.size();
+	counts["blocks"] = (int)drawing.m_blocks.size();
+	counts["points"] = (int)drawing.m_points.size();
+	counts["lines"] = (int)drawing.m_lines.size();
+	counts["polylines"] = (int)drawing.m_polylines.size();
+	counts["circles"] = (int)drawing.m_circles.size();
+	counts["ellipses"] = (int)drawing.m_ellipses.size();
+	counts["arcs"] = (int)drawing.m_arcs.size();
+	counts["solids"] = (int)drawing.m_solids.size();
+	counts["texts"] = (int)drawing.m_texts.size();
+	counts["linearDimensions"] = (int)drawing.m_linearDimensions.size();
+	counts["hatches"] = (int)drawing.m_hatches.size();
+	std::size_t hatchTriangles = 0;
+	for (const Drawing::Hatch & h : drawing.m_hatches)
+		hatchTriangles += h.triangles().size() / 3;
+	counts["hatchTriangles"] = (double)hatchTriangles;
+	counts["splines"] = (int)drawing.m_splines.size();
+	counts["dimensionStyles"] = (int)drawing.m_dimensionStyles.size();
+	counts["inserts"] = (int)drawing.m_inserts.size();
+	counts["scalingUnit"] = QString::fromStdString(results.m_dxfScalingUnit);
+	counts["scalingFactor"] = drawing.m_scalingFactor;
+	counts["boundingBox"] = QJsonArray() << results.m_bounding.m_x << results.m_bounding.m_y << results.m_bounding.m_z;
+	if (m_options.m_simplifyTolerance > 0) {
+		QJsonObject simplify;
+		simplify["tolerance"] = m_options.m_simplifyTolerance;
+		simplify["modifiedPolylines"] = (int)results.m_simplifyStats.m_modifiedPolylines;
+		simplify["vertices"] = (int)results.m_simplifyStats.m_vertices;
+		simplify["remainingVertices"] = (int)results.m_simplifyStats.remainingVertices();
+		simplify["duplicates"] = (int)results.m_simplifyStats.m_duplicates;
+		simplify["collinear"] = (int)results.m_simplifyStats.m_collinear;
+		simplify["simplified"] = (int)results.m_simplifyStats.m_simplified;
+		counts["polylineSimplification"] = simplify;
+	}
+	if (m_options.m_deduplicateTolerance > 0) {
+		QJsonObject deduplicate;
+		deduplicate["tolerance"] = m_options.m_deduplicateTolerance;
+		deduplicate["lines"] = (int)results.m_deduplicateStats.m_lines;
+		deduplicate["duplicates"] = (int)results.m_deduplicateStats.m_duplicates;
+		deduplicate["covered"] = (int)results.m_deduplicateStats.m_covered;
+		deduplicate["merged"] = (int)results.m_deduplicateStats.m_merged;
+		counts["lineDeduplication"] = deduplicate;
+	}
+	return counts;
+}
+
+
+template <typename t>
+static void collectObjects(const ChunkedVector<t> & objects,
+						   std::map<unsigned int, const Drawing::AbstractDrawingObject*> & objectMap)
+{
+	for (const t & obj : objects) {
+		if (obj.m_id != INVALID_ID)
+			objectMap[obj.m_id] = &obj;
+	}
+}
+
+
+QJsonObject BatchImport::lookupBenchmark(const Drawing & drawing) const {
+	FUNCID(BatchImport::lookupBenchmark);
+
+	std::map<unsigned int, const Drawing::AbstractDrawingObject*> objectMap;
+	collectObjects(drawing.m_points, objectMap);
+	collectObjects(drawing.m_lines, objectMap);
+	collectObjects(drawing.m_polylines, objectMap);
+	collectObjects(drawing.m_circles, objectMap);
+	collectObjects(drawing.m_ellipses, objectMap);
+	collectObjects(drawing.m_arcs, objectMap);
+	collectObjects(drawing.m_solids, objectMap);
+	collectObjects(drawing.m_texts, objectMap);
+	collectObjects(drawing.m_linearDimensions, objectMap);
+	collectObjects(drawing.m_hatches, objectMap);
+	collectObjects(drawing.m_splines, objectMap);
+
+	QJsonObject report;
+	report["lookups"] = (double)m_options.m_lookups;
+	report["objects"] = (double)objectMap.size();
+	if (objectMap.empty())
+		return report;
+
+	// random IDs, fixed seed so that runs are comparable
+	std::vector<unsigned int> ids;
+	ids.reserve(objectMap.size());
+	for (const auto & entry : objectMap)
+		ids.push_back(entry.first);
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<std::size_t> dist(0, ids.size() - 1);
+	std::vector<unsigned int> lookupIds(m_options.m_lookups);
+	for (unsigned int & id : lookupIds)
+		id = ids[dist(rng)];
+
+	// the checksums keep the compiler from dropping the lookups and verify both structures
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	unsigned long long mapChecksum = 0;
+	for (unsigned int id : lookupIds)
+		mapChecksum += objectMap.at(id)->m_id;
+	double mapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	start = std::chrono::steady_clock::now();
+	unsigned long long tableChecksum = 0;
+	for (unsigned int id : lookupIds)
+		tableChecksum += drawing.objectByID(id)->m_id;
+	double tableMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	if (mapChecksum != tableChecksum)
+		throw IBK::Exception(IBK::FormatString("Object table lookup does not match std::map lookup."), FUNC_ID);
+
+	report["mapMs"] = mapMs;
+	report["tableMs"] = tableMs;
+	if (tableMs > 0)
+		report["speedup"] = mapMs / tableMs;
+	return report;
+}
+
+
+std::size_t BatchImport::peakRSS() {
+#if defined(Q_OS_WIN32)
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+		return pmc.PeakWorkingSetSize;
+	return 0;
+#elif defined(Q_OS_LINUX)
+	// VmHWM can be reset through clear_refs, ru_maxrss cannot
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+	}
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+	return (std::size_t)usage.ru_maxrss; // bytes on MacOS
+#endif
+}
+
+
+void BatchImport::resetPeakRSS() {
+#if defined(Q_OS_LINUX)
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	clearRefs << "5";
+#endif
+}
+
+
+std::size_t BatchImport::allocationCount() {
+	return s_allocationCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,67 @@
+#ifndef BatchImportH
+#define BatchImportH
+
+#include <QString>
+#include <QJsonObject>
+
+#include <cstddef>
+
+class Drawing;
+
+/*! Headless import of DXF files for benchmarking and regression testing.
+
+	Runs the conversion of ImportDXFDialog (see ImportDXFDialog::convertDxfFile()) and the XML export of
+	DXFImportPlugin without any user interface and collects timings, allocation counts, peak memory and
+	entity counts per stage.
+*/
+class BatchImport {
+public:
+	/*! Options for the batch import. */
+	struct Options {
+		/*! If false, texts and dimensions are skipped while reading (like the dialog option). */
+		bool			m_importText = true;
+		/*! If not empty, the generated project XML is written into this directory, otherwise only into memory. */
+		QString			m_xmlDir;
+		/*! Number of runs per file, timings and allocations are reported for the fastest run. */
+		unsigned int	m_repeat = 1;
+		/*! If > 0, Drawing::objectByID() is benchmarked against a std::map with this number of random lookups. */
+		unsigned int	m_lookups = 0;
+		/*! If > 0, polylines are simplified with this tolerance in m (like the dialog option). */
+		double			m_simplifyTolerance = 0;
+		/*! If > 0, duplicate and overlapping lines on all layers are removed with this tolerance in m. */
+		double			m_deduplicateTolerance = 0;
+	};
+
+	explicit BatchImport(const Options & options);
+
+	/*! Imports a single file and returns the report as JSON object.
+		If the import fails, the report contains an "error" entry.
+	*/
+	QJsonObject importFile(const QString & fname) const;
+
+	/*! Returns peak resident set size of the process in bytes (0 if not available on this platform). */
+	static std::size_t peakRSS();
+
+	/*! Resets the peak resident set size so that the next call of peakRSS() only reports
+		the peak since this call. Only supported on Linux, elsewhere the peak is process wide.
+	*/
+	static void resetPeakRSS();
+
+	/*! Returns the number of calls to global operator new since program start. */
+	static std::size_t allocationCount();
+
+private:
+	/*! Runs the pipeline once and stores per-stage timings in stages. If enabled, the
+		result of the lookup benchmark is stored in lookupReport.
+	*/
+	QJsonObject runOnce(const QString & fname, QJsonObject & stages, double & totalMs, QJsonObject & lookupReport) const;
+
+	/*! Times m_options.m_lookups random lookups of entity IDs via Drawing::objectByID() and via a
+		std::map (the lookup structure used before the dense object table).
+	*/
+	QJsonObject lookupBenchmark(const Drawing & drawing) const;
+
+	Options		m_options;
+};
+
+#endif // BatchImportH
@@ -0,0 +1,92 @@
+/*	Headless batch import of DXF files.
+
+	Usage: DXFBatchImport [options] <file.dxf> [<file.dxf> ...]
+
+	Runs the import pipeline (prepass, read, references, updatePointer, bounds, center, [simplify, dedup,] writeXML)
+	on all given files and writes a JSON report with per-stage wall clock time,
+	allocation counts, peak RSS, entity counts and throughput to stdout or to a file.
+*/
+
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QFile>
+
+#include <iostream>
+
+#include "BatchImport.h"
+
+int main(int argc, char *argv[]) {
+	// Drawing uses QFont/QPainterPath for texts, which requires a gui application.
+	// Default to the offscreen platform so that no display is needed.
+	if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+		qputenv("QT_QPA_PLATFORM", QByteArray("offscreen"));
+
+	QGuiApplication a(argc, argv);
+	QGuiApplication::setApplicationName("DXFBatchImport");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Headless DXF import and benchmark");
+	parser.addHelpOption();
+	QCommandLineOption outputOption(QStringList() << "o" << "output", "Write JSON report to <file> instead of stdout.", "file");
+	QCommandLineOption xmlDirOption("xml-dir", "Write generated project XML files into <dir>.", "dir");
+	QCommandLineOption repeatOption("repeat", "Import each file <n> times and report the fastest run.", "n", "1");
+	QCommandLineOption noTextOption("no-text", "Skip texts and dimensions while reading.");
+	QCommandLineOption lookupOption("lookup-bench", "Benchmark object lookup by ID against a std::map with <n> random lookups.", "n", "1000000");
+	QCommandLineOption simplifyOption("simplify", "Simplify polylines with tolerance <m> in m after reading.", "m", "0.005");
+	QCommandLineOption dedupOption("dedup", "Remove duplicate and overlapping lines with tolerance <m> in m after reading.", "m", "0.001");
+	parser.addOption(outputOption);
+	parser.addOption(xmlDirOption);
+	parser.addOption(repeatOption);
+	parser.addOption(noTextOption);
+	parser.addOption(lookupOption);
+	parser.addOption(simplifyOption);
+	parser.addOption(dedupOption);
+	parser.addPositionalArgument("files", "DXF files to import.", "<file.dxf>...");
+	parser.process(a);
+
+	const QStringList files = parser.positionalArguments();
+	if (files.isEmpty())
+		parser.showHelp(1);
+
+	BatchImport::Options options;
+	options.m_importText = !parser.isSet(noTextOption);
+	options.m_xmlDir = parser.value(xmlDirOption);
+	options.m_repeat = parser.value(repeatOption).toUInt();
+	if (parser.isSet(lookupOption))
+		options.m_lookups = parser.value(lookupOption).toUInt();
+	if (parser.isSet(simplifyOption))
+		options.m_simplifyTolerance = parser.value(simplifyOption).toDouble();
+	if (parser.isSet(dedupOption))
+		options.m_deduplicateTolerance = parser.value(dedupOption).toDouble();
+
+	BatchImport batch(options);
+
+	QJsonArray reports;
+	bool success = true;
+	for (const QString & fname : files) {
+		QJsonObject report = batch.importFile(fname);
+		if (report.contains("error"))
+			success = false;
+		reports.append(report);
+	}
+
+	QJsonObject result;
+	result["files"] = reports;
+	QByteArray json = QJsonDocument(result).toJson();
+
+	if (parser.isSet(outputOption)) {
+		QFile out(parser.value(outputOption));
+		if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+			std::cerr << "Cannot write report file '" << out.fileName().toStdString() << "'" << std::endl;
+			return 1;
+		}
+		out.write(json);
+	}
+	else {
+		std::cout << json.constData();
+	}
+
+	return success ? 0 : 2;
+}
@@ -6,6 +6,7 @@ TEMPLATE=subdirs
 SUBDIRS += DXFImportPlugin \
             QtExt \
 			DXFTestBed \
+			DXFBatchImport \
 			libdxfrw \
 			IBK \
 			IBKMK \
@@ -13,6 +14,7 @@ SUBDIRS += DXFImportPlugin \
 			TiCPP
 
 DXFTestBed.file = ../../DXFTestBed/projects/Qt/DXFTestBed.pro
+DXFBatchImport.file = ../../DXFTestBed/projects/Qt/DXFBatchImport.pro
 DXFImportPlugin.file = ../../externals/DXFImportPlugin/projects/Qt/DXFImportPlugin.pro
 
 IBK.file = ../../externals/IBK/projects/Qt/IBK.pro
@@ -26,3 +28,4 @@ IBKMK.depends = IBK
 QtExt.depends = IBK
 DXFImportPlugin.depends = IBK IBKMK TiCPP QtExt libdxfrw glm
 DXFTestBed.depends = IBK IBKMK TiCPP QtExt libdxfrw DXFImportPlugin
+DXFBatchImport.depends = IBK IBKMK TiCPP QtExt libdxfrw DXFImportPlugin
@@ -66,20 +66,37 @@ UI_DIR = ui
 
 SOURCES += \
     ../../src/Constants.cpp \
+	../../src/CurveTessellation.cpp \
 	../../src/DXFImportPlugin.cpp  \
 	../../src/Drawing.cpp \
 	../../src/DrawingLayer.cpp \
+	../../src/GlyphOutlines.cpp \
+	../../src/HatchTessellation.cpp \
 	../../src/ImportDXFDialog.cpp \
+	../../src/LineDeduplication.cpp \
 	../../src/Object.cpp \
+	../../src/PointTransformation.cpp \
+	../../src/PolylineSimplification.cpp \
+	../../src/SplineTessellation.cpp \
 	../../src/Utilities.cpp
 
 HEADERS += \
     ../../src/Constants.h \
+	../../src/ChunkedVector.h \
+	../../src/CurveTessellation.h \
 	../../src/Drawing.h \
 	../../src/DrawingLayer.h \
+	../../src/GlyphOutlines.h \
+	../../src/HatchTessellation.h \
 	../../src/ImportDXFDialog.h \
+	../../src/LineDeduplication.h \
 	../../src/Object.h \
+	../../src/ParallelFor.h \
+	../../src/PointTransformation.h \
+	../../src/PolylineSimplification.h \
+	../../src/RadixSort.h \
 	../../src/RotationMatrix.h \
+	../../src/SplineTessellation.h \
 	../../src/SVCommonPluginInterface.h \
 	../../src/SVImportPluginInterface.h \
 	../../src/DXFImportPlugin.h \
@@ -0,0 +1,211 @@
+#ifndef ChunkedVectorH
+#define ChunkedVectorH
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*! A vector-like container that stores its elements in fixed size chunks.
+
+	Unlike std::vector, elements are never relocated when the container grows. Pointers and
+	references to elements stay valid on push_back(), emplace_back() and reserve(). Only erase()
+	and clear() invalidate pointers (erase() only those to elements behind the erased one).
+	Chunks hold 2^ChunkBits elements, index access is a shift and a mask.
+
+	The interface follows std::vector as far as it is used for drawing entities.
+*/
+template <typename T, unsigned int ChunkBits = 8>
+class ChunkedVector {
+public:
+	/*! Number of elements per chunk. */
+	static const std::size_t CHUNK_SIZE = std::size_t(1) << ChunkBits;
+
+	typedef T					value_type;
+	typedef std::size_t			size_type;
+	typedef std::ptrdiff_t		difference_type;
+	typedef T &					reference;
+	typedef const T &			const_reference;
+
+	/*! Random access iterator, stores container and index. */
+	template <typename Container, typename Value>
+	class Iterator {
+	public:
+		typedef std::random_access_iterator_tag		iterator_category;
+		typedef typename std::remove_const<Value>::type	value_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef Value *								pointer;
+		typedef Value &								reference;
+
+		Iterator() = default;
+		Iterator(Container * c, std::size_t idx) : m_container(c), m_idx(idx) {}
+		/*! Conversion from iterator to const_iterator. */
+		template <typename C2, typename V2,
+				  typename = typename std::enable_if<std::is_convertible<C2*, Container*>::value>::type>
+		Iterator(const Iterator<C2, V2> & other) : m_container(other.m_container), m_idx(other.m_idx) {}
+
+		reference operator*() const { return (*m_container)[m_idx]; }
+		pointer operator->() const { return &(*m_container)[m_idx]; }
+		reference operator[](difference_type n) const { return (*m_container)[m_idx + n]; }
+
+		Iterator & operator++() { ++m_idx; return *this; }
+		Iterator operator++(int) { Iterator tmp(*this); ++m_idx; return tmp; }
+		Iterator & operator--() { --m_idx; return *this; }
+		Iterator operator--(int) { Iterator tmp(*this); --m_idx; return tmp; }
+		Iterator & operator+=(difference_type n) { m_idx += n; return *this; }
+		Iterator & operator-=(difference_type n) { m_idx -= n; return *this; }
+		Iterator operator+(difference_type n) const { return Iterator(m_container, m_idx + n); }
+		Iterator operator-(difference_type n) const { return Iterator(m_container, m_idx - n); }
+		friend Iterator operator+(difference_type n, const Iterator & it) { return it + n; }
+
+		// comparison also works between iterator and const_iterator
+		template <typename C2, typename V2>
+		difference_type operator-(const Iterator<C2, V2> & other) const { return difference_type(m_idx) - difference_type(other.m_idx); }
+		template <typename C2, typename V2>
+		bool operator==(const Iterator<C2, V2> & other) const { return m_idx == other.m_idx; }
+		template <typename C2, typename V2>
+		bool operator!=(const Iterator<C2, V2> & other) const { return m_idx != other.m_idx; }
+		template <typename C2, typename V2>
+		bool operator<(const Iterator<C2, V2> & other) const { return m_idx < other.m_idx; }
+		template <typename C2, typename V2>
+		bool operator>(const Iterator<C2, V2> & other) const { return m_idx > other.m_idx; }
+		template <typename C2, typename V2>
+		bool operator<=(const Iterator<C2, V2> & other) const { return m_idx <= other.m_idx; }
+		template <typename C2, typename V2>
+		bool operator>=(const Iterator<C2, V2> & other) const { return m_idx >= other.m_idx; }
+
+		/*! Index of element in container. */
+		std::size_t index() const { return m_idx; }
+
+	private:
+		template <typename C2, typename V2> friend class Iterator;
+
+		Container	*m_container = nullptr;
+		std::size_t	m_idx = 0;
+	};
+
+	typedef Iterator<ChunkedVector, T>				iterator;
+	typedef Iterator<const ChunkedVector, const T>	const_iterator;
+
+	ChunkedVector() = default;
+
+	ChunkedVector(const ChunkedVector & other) {
+		reserve(other.m_size);
+		for (std::size_t i = 0; i < other.m_size; ++i)
+			push_back(other[i]);
+	}
+
+	ChunkedVector(ChunkedVector && other) noexcept :
+		m_chunks(std::move(other.m_chunks)),
+		m_size(other.m_size)
+	{
+		other.m_chunks.clear();
+		other.m_size = 0;
+	}
+
+	~ChunkedVector() {
+		clear();
+		for (T * chunk : m_chunks)
+			::operator delete(chunk);
+	}
+
+	ChunkedVector & operator=(const ChunkedVector & other) {
+		if (this != &other) {
+			clear();
+			reserve(other.m_size);
+			for (std::size_t i = 0; i < other.m_size; ++i)
+				push_back(other[i]);
+		}
+		return *this;
+	}
+
+	ChunkedVector & operator=(ChunkedVector && other) noexcept {
+		if (this != &other) {
+			std::swap(m_chunks, other.m_chunks);
+			std::swap(m_size, other.m_size);
+		}
+		return *this;
+	}
+
+	std::size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	std::size_t capacity() const { return m_chunks.size() << ChunkBits; }
+
+	T & operator[](std::size_t idx) { return m_chunks[idx >> ChunkBits][idx & (CHUNK_SIZE - 1)]; }
+	const T & operator[](std::size_t idx) const { return m_chunks[idx >> ChunkBits][idx & (CHUNK_SIZE - 1)]; }
+
+	T & at(std::size_t idx) {
+		if (idx >= m_size)
+			throw std::out_of_range("ChunkedVector::at");
+		return (*this)[idx];
+	}
+	const T & at(std::size_t idx) const {
+		if (idx >= m_size)
+			throw std::out_of_range("ChunkedVector::at");
+		return (*this)[idx];
+	}
+
+	T & front() { return (*this)[0]; }
+	const T & front() const { return (*this)[0]; }
+	T & back() { return (*this)[m_size - 1]; }
+	const T & back() const { return (*this)[m_size - 1]; }
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, m_size); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, m_size); }
+	const_iterator cbegin() const { return begin(); }
+	const_iterator cend() const { return end(); }
+
+	/*! Allocates chunks for at least n elements. Existing elements are not touched. */
+	void reserve(std::size_t n) {
+		while (capacity() < n)
+			m_chunks.push_back(static_cast<T*>(::operator new(sizeof(T) * CHUNK_SIZE)));
+	}
+
+	void push_back(const T & value) { emplace_back(value); }
+	void push_back(T && value) { emplace_back(std::move(value)); }
+
+	template <typename... Args>
+	T & emplace_back(Args&&... args) {
+		reserve(m_size + 1);
+		T * p = &(*this)[m_size];
+		new (p) T(std::forward<Args>(args)...);
+		++m_size;
+		return *p;
+	}
+
+	void pop_back() {
+		--m_size;
+		(*this)[m_size].~T();
+	}
+
+	/*! Removes the element at pos, following elements are moved one position forward.
+		Returns iterator to the element following the erased one.
+	*/
+	iterator erase(const_iterator pos) {
+		std::size_t idx = pos.index();
+		for (std::size_t i = idx + 1; i < m_size; ++i)
+			(*this)[i - 1] = std::move((*this)[i]);
+		pop_back();
+		return iterator(this, idx);
+	}
+
+	/*! Destroys all elements, chunks are kept for reuse. */
+	void clear() {
+		for (std::size_t i = 0; i < m_size; ++i)
+			(*this)[i].~T();
+		m_size = 0;
+	}
+
+private:
+	/*! Chunks of uninitialized storage, each for CHUNK_SIZE elements. */
+	std::vector<T*>		m_chunks;
+	/*! Number of constructed elements. */
+	std::size_t			m_size = 0;
+};
+
+#endif // ChunkedVectorH
@@ -6,3 +6,5 @@ const char * XML_READ_ERROR = "Error in XML file, line %1: %2";
 const char * XML_READ_UNKNOWN_ATTRIBUTE = "Unknown/unsupported attribute '%1' in line %2.";
 const char * XML_READ_UNKNOWN_ELEMENT = "Unknown/unsupported tag '%1' in line %2.";
 const char * XML_READ_UNKNOWN_NAME = "Name '%1' for tag '%2' in line %3 is invalid/unknown.";
+
+const char * TEXT_FONT_FAMILY = "Arial";
@@ -9,11 +9,26 @@ extern const char * XML_READ_UNKNOWN_ATTRIBUTE;
 extern const char * XML_READ_UNKNOWN_ELEMENT;
 extern const char * XML_READ_UNKNOWN_NAME;
 
+/*! Font family used for text outlines. */
+extern const char * TEXT_FONT_FAMILY;
 
-const double MAX_SEGMENT_ARC_LENGHT			= 30;
-const unsigned int SEGMENT_COUNT_ARC		= 30;
-const unsigned int SEGMENT_COUNT_CIRCLE		= 30;
-const unsigned int SEGMENT_COUNT_ELLIPSE	= 30;
+
+// maximum distance between tessellated chords and exact curve (circles, arcs, ellipses) in m
+const double MAX_CHORD_DEVIATION			= 0.01;
+// lower and upper limit of segment count for a full circle, partial arcs are scaled by their sweep angle
+const unsigned int MIN_SEGMENT_COUNT_CIRCLE	= 12;
+const unsigned int MAX_SEGMENT_COUNT_CIRCLE	= 1024;
+// maximum number of bisections of a spline knot span, limits the segment count per span to 2^depth
+const unsigned int MAX_SPLINE_SUBDIVISION_DEPTH	= 10;
+// point size glyph outlines are polygonised with, larger sizes give finer outlines with more segments
+const double GLYPH_OUTLINE_FONT_SIZE		= 10;
+// maximum deviation of simplified polylines from the original vertices in m
+const double POLYLINE_SIMPLIFICATION_TOLERANCE	= 0.005;
+// quantization tolerance for detection of duplicate and overlapping lines in m
+const double LINE_DEDUPLICATION_TOLERANCE	= 0.001;
+
+// number of entities per task of the parallel stages (linking, bounds, pick points, line geometries)
+const unsigned int ENTITY_CHUNK_SIZE		= 256;
 
 // Multiplyer for different layers and their heights
 const double Z_MULTIPLYER					= 0.00000;
@@ -0,0 +1,153 @@
+#include "CurveTessellation.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <algorithm>
+#include <atomic>
+
+#include <IBK_physics.h>
+
+#include "Constants.h"
+
+namespace CurveTessellation {
+
+/*! Sweep angle in (0, 2 PI] for counter-clockwise arcs, 0 sweeps are treated as full circles. */
+static double sweepAngle(double startAngle, double endAngle) {
+	double sweep = endAngle - startAngle;
+	while (sweep <= 0)
+		sweep += 2 * IBK::PI;
+	while (sweep > 2 * IBK::PI)
+		sweep -= 2 * IBK::PI;
+	return sweep;
+}
+
+
+/*! Writes segmentCount+1 points of the unit arc starting at startAngle with constant angle step
+	into points, which is resized accordingly. The last point is evaluated directly so that
+	the recurrence error does not accumulate into the end point.
+*/
+static void unitArc(double startAngle, double sweep, unsigned int segmentCount,
+					std::vector<IBKMK::Vector2D> & points)
+{
+	points.resize(segmentCount + 1);
+	double step = sweep / segmentCount;
+	double cs = std::cos(step);
+	double sn = std::sin(step);
+	double x = std::cos(startAngle);
+	double y = std::sin(startAngle);
+	for (unsigned int i = 0; i < segmentCount; ++i) {
+		points[i] = IBKMK::Vector2D(x, y);
+		double xn = x * cs - y * sn;
+		y = x * sn + y * cs;
+		x = xn;
+	}
+	points[segmentCount] = IBKMK::Vector2D(std::cos(startAngle + sweep), std::sin(startAngle + sweep));
+}
+
+
+unsigned int segmentCount(double radius, double sweepAngle, double maxDeviation) {
+	double fraction = std::min(1.0, std::abs(sweepAngle) / (2 * IBK::PI));
+	unsigned int minCount = std::max(1u, (unsigned int)std::ceil(fraction * MIN_SEGMENT_COUNT_CIRCLE));
+	unsigned int maxCount = std::max(minCount, (unsigned int)std::ceil(fraction * MAX_SEGMENT_COUNT_CIRCLE));
+	radius = std::abs(radius);
+	if (radius == 0.0 || maxDeviation <= 0.0)
+		return maxCount;
+	if (maxDeviation >= radius)
+		return minCount;
+
+	// sagitta of a chord spanning angle a: s = r * (1 - cos(a/2))
+	double maxStep = 2 * std::acos(1 - maxDeviation / radius);
+	double count = std::ceil(std::abs(sweepAngle) / maxStep);
+	if (count < minCount)
+		return minCount;
+	if (count > maxCount)
+		return maxCount;
+	return (unsigned int)count;
+}
+
+
+/*! Generates the unit circle with segmentCount vertices into points. */
+static void createUnitCircle(unsigned int segmentCount, std::vector<IBKMK::Vector2D> & points) {
+	unitArc(0, 2 * IBK::PI, segmentCount, points);
+	points.pop_back(); // closing point equals first point
+}
+
+
+const std::vector<IBKMK::Vector2D> & unitCircle(unsigned int segmentCount) {
+	// All counts returned by segmentCount() have a slot in a table of atomic pointers, hence lookups from
+	// parallel tessellation are a single atomic load. Concurrent first uses of a count may both create the
+	// template, only one is published, the other one is discarded. Templates are never freed.
+	static std::atomic<const std::vector<IBKMK::Vector2D> *> templates[MAX_SEGMENT_COUNT_CIRCLE + 1];
+
+	if (segmentCount <= MAX_SEGMENT_COUNT_CIRCLE) {
+		std::atomic<const std::vector<IBKMK::Vector2D> *> & slot = templates[segmentCount];
+		const std::vector<IBKMK::Vector2D> * points = slot.load(std::memory_order_acquire);
+		if (points != nullptr)
+			return *points;
+
+		std::vector<IBKMK::Vector2D> * created = new std::vector<IBKMK::Vector2D>;
+		createUnitCircle(segmentCount, *created);
+		if (slot.compare_exchange_strong(points, created, std::memory_order_acq_rel, std::memory_order_acquire))
+			return *created;
+		delete created;
+		return *points;
+	}
+
+	// larger counts are only requested explicitly
+	static std::map<unsigned int, std::vector<IBKMK::Vector2D> > largeTemplates;
+	static std::mutex largeTemplatesMutex;
+
+	std::lock_guard<std::mutex> lock(largeTemplatesMutex);
+	std::map<unsigned int, std::vector<IBKMK::Vector2D> >::iterator it = largeTemplates.find(segmentCount);
+	if (it != largeTemplates.end())
+		return it->second;
+
+	std::vector<IBKMK::Vector2D> & points = largeTemplates[segmentCount];
+	createUnitCircle(segmentCount, points);
+	return points;
+}
+
+
+void circle(const IBKMK::Vector2D & center, double radius, double maxDeviation,
+			std::vector<IBKMK::Vector2D> & points)
+{
+	const std::vector<IBKMK::Vector2D> & unit = unitCircle(segmentCount(radius, 2 * IBK::PI, maxDeviation));
+	points.resize(unit.size());
+	for (unsigned int i = 0; i < unit.size(); ++i)
+		points[i] = IBKMK::Vector2D(center.m_x + radius * unit[i].m_x, center.m_y + radius * unit[i].m_y);
+}
+
+
+void arc(const IBKMK::Vector2D & center, double radius, double startAngle, double endAngle,
+		 double maxDeviation, std::vector<IBKMK::Vector2D> & points)
+{
+	double sweep = sweepAngle(startAngle, endAngle);
+	unitArc(startAngle, sweep, segmentCount(radius, sweep, maxDeviation), points);
+	for (IBKMK::Vector2D & p : points)
+		p = IBKMK::Vector2D(center.m_x + radius * p.m_x, center.m_y + radius * p.m_y);
+}
+
+
+void ellipse(const IBKMK::Vector2D & center, const IBKMK::Vector2D & majorAxis, double ratio,
+			 double startParam, double endParam, double maxDeviation,
+			 std::vector<IBKMK::Vector2D> & points)
+{
+	double majorRadius = majorAxis.magnitude();
+	double sweep = sweepAngle(startParam, endParam);
+	// The ellipse is an affine image of the circle with the major radius that does not stretch
+	// any direction, so the chord deviation of that circle is an upper bound.
+	unitArc(startParam, sweep, segmentCount(majorRadius, sweep, maxDeviation), points);
+
+	// unit x axis along major axis, y along minor axis
+	double cr = majorRadius > 0 ? majorAxis.m_x / majorRadius : 1;
+	double sr = majorRadius > 0 ? majorAxis.m_y / majorRadius : 0;
+	double minorRadius = majorRadius * ratio;
+	for (IBKMK::Vector2D & p : points) {
+		double x = majorRadius * p.m_x;
+		double y = minorRadius * p.m_y;
+		p = IBKMK::Vector2D(center.m_x + x * cr - y * sr, center.m_y + x * sr + y * cr);
+	}
+}
+
+} // namespace CurveTessellation
@@ -0,0 +1,54 @@
+#ifndef CurveTessellationH
+#define CurveTessellationH
+
+#include <vector>
+
+#include <IBKMK_Vector2D.h>
+
+/*! Tessellation of circles, arcs and ellipses into polygon vertices.
+
+	The number of segments is chosen such that the maximum distance between a chord and
+	the exact curve stays below a given tolerance. Vertices are generated with a rotation
+	recurrence (one 2x2 rotation per vertex), sin/cos are only evaluated once per curve.
+	Full circles are scaled copies of cached unit circle templates, one per segment count.
+
+	All lengths (radius, tolerance) are in drawing units, callers convert the tolerance
+	in metres with the drawing scaling factor.
+*/
+namespace CurveTessellation {
+
+/*! Returns the number of segments needed to approximate an arc with given radius and sweep angle (rad)
+	so that no chord deviates more than maxDeviation from the arc. The result is clamped to
+	the limits defined in Constants.h, scaled down proportionally for partial arcs.
+*/
+unsigned int segmentCount(double radius, double sweepAngle, double maxDeviation);
+
+/*! Returns the cached unit circle with segmentCount vertices, starting at angle 0, counter-clockwise.
+	The returned reference remains valid for the lifetime of the program.
+*/
+const std::vector<IBKMK::Vector2D> & unitCircle(unsigned int segmentCount);
+
+/*! Tessellates a full circle. Points are the vertices of a closed polygon, the first
+	point is not repeated at the end.
+*/
+void circle(const IBKMK::Vector2D & center, double radius, double maxDeviation,
+			std::vector<IBKMK::Vector2D> & points);
+
+/*! Tessellates a counter-clockwise arc from startAngle to endAngle (rad). If endAngle < startAngle
+	the arc passes angle 0. Points include both end points.
+*/
+void arc(const IBKMK::Vector2D & center, double radius, double startAngle, double endAngle,
+		 double maxDeviation, std::vector<IBKMK::Vector2D> & points);
+
+/*! Tessellates an elliptical arc between the parameters startParam and endParam (rad).
+	\param majorAxis Vector from center to end of major axis, defines radius and rotation.
+	\param ratio Ratio of minor to major axis.
+	Points include both end points.
+*/
+void ellipse(const IBKMK::Vector2D & center, const IBKMK::Vector2D & majorAxis, double ratio,
+			 double startParam, double endParam, double maxDeviation,
+			 std::vector<IBKMK::Vector2D> & points);
+
+} // namespace CurveTessellation
+
+#endif // CurveTessellationH
@@ -1,6 +1,7 @@
 #include "DXFImportPlugin.h"
 
 #include "ImportDXFDialog.h"
+#include "ParallelFor.h"
 
 #include <QFileDialog>
 #include <QDir>
@@ -108,6 +109,9 @@ bool DXFImportPlugin::import(QWidget * parent, QString& projectText) {
 		Drawing dr = diag.drawing();
 		dr.writeXML(drs);
 
+		// import is finished, worker threads are stopped here and not while the plugin is unloaded
+		ParallelForPool::shutdown();
+
 		// Declare a printer
 		TiXmlPrinter printer;
 
@@ -126,6 +130,7 @@ bool DXFImportPlugin::import(QWidget * parent, QString& projectText) {
 		return true;
 	}
 
+	ParallelForPool::shutdown();
 	return false;
 }
 
@@ -1,6 +1,13 @@
 #include "Drawing.h"
 #include "IBKMK_3DCalculations.h"
 #include "Constants.h"
+#include "CurveTessellation.h"
+#include "GlyphOutlines.h"
+#include "HatchTessellation.h"
+#include "SplineTessellation.h"
+#include "ParallelFor.h"
+#include "RadixSort.h"
+#include "PointTransformation.h"
 
 #include "IBK_MessageHandler.h"
 #include "IBK_messages.h"
@@ -8,10 +15,28 @@
 
 #include "Utilities.h"
 #include "ext/matrix_transform.hpp"
-#include "qfont.h"
-#include "qpainterpath.h"
 #include <tinyxml.h>
 
+#include <limits>
+#include <type_traits>
+
+
+// Entity vectors only move their elements on reallocation if the move c'tors cannot throw.
+static_assert(std::is_nothrow_move_constructible<Drawing::Point>::value, "Drawing::Point must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::Line>::value, "Drawing::Line must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::PolyLine>::value, "Drawing::PolyLine must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::Circle>::value, "Drawing::Circle must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::Ellipse>::value, "Drawing::Ellipse must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::Arc>::value, "Drawing::Arc must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::Solid>::value, "Drawing::Solid must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::Hatch>::value, "Drawing::Hatch must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::Spline>::value, "Drawing::Spline must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::Text>::value, "Drawing::Text must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::LinearDimension>::value, "Drawing::LinearDimension must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::Block>::value, "Drawing::Block must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::Insert>::value, "Drawing::Insert must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<Drawing::DimStyle>::value, "Drawing::DimStyle must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<DrawingLayer>::value, "DrawingLayer must be nothrow movable");
 
 static int PRECISION = 16;  // precision of floating point values for output writing
 
@@ -25,17 +50,46 @@ inline IBKMK::Vector3D QVector2IBKVector(const QVector3D & v) {
 	return IBKMK::Vector3D((double)v.x(), (double)v.y(), (double)v.z());
 }
 
-Drawing::Drawing() :
-	m_blocks(std::vector<Block>()),
-	m_drawingLayers(std::vector<DrawingLayer>()),
-	m_points(std::vector<Point>()),
-	m_lines(std::vector<Line>()),
-	m_polylines(std::vector<PolyLine>()),
-	m_circles(std::vector<Circle>()),
-	m_ellipses(std::vector<Ellipse>()),
-	m_arcs(std::vector<Arc>()),
-	m_solids(std::vector<Solid>()),
-	m_texts(std::vector<Text>())
+/*! Writes vertexes as comma separated list of coordinate pairs. */
+static std::string verticesToString(const std::vector<IBKMK::Vector2D> & verts) {
+	std::stringstream vals;
+	for (unsigned int i=0; i<verts.size(); ++i) {
+		vals << verts[i].toString(PRECISION);
+		if (i<verts.size()-1)  vals << ", ";
+	}
+	return vals.str();
+}
+
+/*! Reads vertexes written by verticesToString(). */
+static void verticesFromString(const char * text, std::vector<IBKMK::Vector2D> & verts) {
+	FUNCID(verticesFromString);
+	if (text == nullptr)
+		throw IBK::Exception("Missing values.", FUNC_ID);
+	std::vector<double> vals;
+	IBK::string2valueVector(IBK::replace_string(text, ",", " "), vals);
+	// must have n*2 elements
+	if (vals.size() % 2 != 0)
+		throw IBK::Exception("Mismatching number of values.", FUNC_ID);
+	verts.resize(vals.size() / 2);
+	for (unsigned int i=0; i<verts.size(); ++i){
+		verts[i].m_x = vals[i*2];
+		verts[i].m_y = vals[i*2+1];
+	}
+}
+
+/*! Writes values separated by spaces. */
+static std::string valuesToString(const std::vector<double> & values) {
+	std::stringstream vals;
+	vals.precision(PRECISION);
+	for (unsigned int i=0; i<values.size(); ++i) {
+		vals << values[i];
+		if (i<values.size()-1)  vals << " ";
+	}
+	return vals.str();
+}
+
+
+Drawing::Drawing()
 {}
 
 
@@ -135,16 +189,16 @@ const std::vector<IBKMK::Vector2D> &Drawing::Text::points2D() const {
 	return m_pickPoints;
 }
 
-const std::vector<Drawing::LineSegment> &Drawing::Text::lineGeometries() const {
+const std::vector<Drawing::LineSegment> &Drawing::Text::localLineGeometries() const {
 	FUNCID(Drawing::Text::planeGeometries);
 	try {
-		if (m_dirtyGlobalPoints) {
+		if (localGeometryDirty()) {
 			m_lineGeometries.clear();
 			drawing()->generateLinesFromText(m_text.toStdString(),
 											 m_height, m_alignment, - m_rotationAngle, m_basePoint,
 											 *this, m_lineGeometries);
 
-			m_dirtyGlobalPoints = false;
+			localGeometryUpdated();
 		}
 
 		return m_lineGeometries;
@@ -257,17 +311,18 @@ const std::vector<IBKMK::Vector2D> &Drawing::Solid::points2D() const {
 	return m_pickPoints;
 }
 
-const std::vector<Drawing::LineSegment> &Drawing::Solid::lineGeometries() const {
+const std::vector<Drawing::LineSegment> &Drawing::Solid::localLineGeometries() const {
 	FUNCID(Drawing::Line::planeGeometries);
 	try {
-		if (m_dirtyGlobalPoints) {
+		if (localGeometryDirty()) {
 			m_lineGeometries.clear();
 
 			const Drawing *drawing = this->drawing();
 			Q_ASSERT(drawing);
 
 			std::vector<IBKMK::Vector2D> points2D {m_point1, m_point2, m_point3, m_point4};
-			std::vector<IBKMK::Vector3D> verts = drawing->points3D(points2D, *this);
+			std::vector<IBKMK::Vector3D> verts;
+			drawing->localPoints3D(points2D, *this, verts);
 
 			for (unsigned int i = 0; i < 4; ++i) {
 				const IBKMK::Vector3D &p1 = verts[ i				   ];
@@ -276,7 +331,7 @@ const std::vector<Drawing::LineSegment> &Drawing::Solid::lineGeometries() const
 				m_lineGeometries.push_back(LineSegment(p2, p1));
 			}
 
-			m_dirtyGlobalPoints = false;
+			localGeometryUpdated();
 		}
 
 		return m_lineGeometries;
@@ -285,6 +340,331 @@ const std::vector<Drawing::LineSegment> &Drawing::Solid::lineGeometries() const
 	}
 }
 
+TiXmlElement * Drawing::Hatch::writeXMLPrivate(TiXmlElement * parent) const {
+	if (m_id == INVALID_ID)  return nullptr;
+
+	TiXmlElement * e = new TiXmlElement("Hatch");
+	parent->LinkEndChild(e);
+
+	if (m_id != INVALID_ID)
+		e->SetAttribute("id", IBK::val2string<unsigned int>(m_id));
+	if (m_color.isValid())
+		e->SetAttribute("color", m_color.name().toStdString());
+	if (m_zPosition != 0.0)
+		e->SetAttribute("zPosition", IBK::val2string<unsigned int>(m_zPosition));
+	if (!m_solidFill)
+		e->SetAttribute("solid", IBK::val2string<bool>(m_solidFill));
+	if (!m_layerName.isEmpty())
+		e->SetAttribute("layer", m_layerName.toStdString());
+
+	for (const HatchLoop &loop : m_loops) {
+		TiXmlElement * l = new TiXmlElement("Loop");
+		e->LinkEndChild(l);
+
+		if (!loop.m_bulges.empty()) {
+			std::stringstream bulges;
+			bulges.precision(PRECISION);
+			for (unsigned int i=0; i<loop.m_bulges.size(); ++i) {
+				bulges << loop.m_bulges[i];
+				if (i<loop.m_bulges.size()-1)  bulges << " ";
+			}
+			l->SetAttribute("bulges", bulges.str());
+		}
+
+		std::stringstream vals;
+		for (unsigned int i=0; i<loop.m_vertices.size(); ++i) {
+			vals << loop.m_vertices[i].toString(PRECISION);
+			if (i<loop.m_vertices.size()-1)  vals << ", ";
+		}
+		TiXmlText * text = new TiXmlText( vals.str() );
+		l->LinkEndChild( text );
+	}
+
+	return e;
+}
+
+void Drawing::Hatch::readXMLPrivate(const TiXmlElement *element){
+	FUNCID(Drawing::Hatch::readXMLPrivate);
+
+	try {
+		// search for mandatory attributes
+		if (!TiXmlAttribute::attributeByName(element, "id")) {
+			IBK::IBK_Message( IBK::FormatString(XML_READ_ERROR).arg(element->Row()).arg(
+								  IBK::FormatString("Missing required 'id' attribute.") ), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+			return;
+		}
+
+		const TiXmlAttribute * attrib = element->FirstAttribute();
+		while (attrib) {
+			const std::string & attribName = attrib->NameStr();
+			if (attribName == "id")
+				m_id = readPODAttributeValue<unsigned int>(element, attrib);
+			else if (attribName == "color")
+				m_color = QColor(QString::fromStdString(attrib->ValueStr()));
+			else if (attribName == "zPosition")
+				m_zPosition = readPODAttributeValue<unsigned int>(element, attrib);
+			else if (attribName == "solid")
+				m_solidFill = readPODAttributeValue<bool>(element, attrib);
+			else if (attribName == "layer")
+				m_layerName = QString::fromStdString(attrib->ValueStr());
+			else {
+				IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ATTRIBUTE).arg(attribName).arg(element->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+			}
+			attrib = attrib->Next();
+		}
+
+		// reading elements
+		const TiXmlElement * c = element->FirstChildElement();
+		while (c) {
+			const std::string & cName = c->ValueStr();
+			if (cName == "Loop") {
+				HatchLoop loop;
+				try {
+					const char * text = c->GetText();
+					if (text == nullptr)
+						throw IBK::Exception("Missing values.", FUNC_ID);
+					std::vector<double> vals;
+					IBK::string2valueVector(IBK::replace_string(text, ",", " "), vals);
+					// must have n*2 elements
+					if (vals.size() % 2 != 0)
+						throw IBK::Exception("Mismatching number of values.", FUNC_ID);
+					if (vals.empty())
+						throw IBK::Exception("Missing values.", FUNC_ID);
+					loop.m_vertices.resize(vals.size() / 2);
+					for (unsigned int i=0; i<loop.m_vertices.size(); ++i){
+						loop.m_vertices[i].m_x = vals[i*2];
+						loop.m_vertices[i].m_y = vals[i*2+1];
+					}
+
+					const TiXmlAttribute * bulges = TiXmlAttribute::attributeByName(c, "bulges");
+					if (bulges != nullptr) {
+						IBK::string2valueVector(bulges->ValueStr(), loop.m_bulges);
+						if (loop.m_bulges.size() != loop.m_vertices.size())
+							throw IBK::Exception("Mismatching number of bulges.", FUNC_ID);
+					}
+				} catch (IBK::Exception & ex) {
+					throw IBK::Exception( ex, IBK::FormatString(XML_READ_ERROR).arg(c->Row())
+										  .arg("Error reading element 'Loop'." ), FUNC_ID);
+				}
+				m_loops.push_back(std::move(loop));
+			}
+			else {
+				IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(cName).arg(c->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+			}
+			c = c->NextSiblingElement();
+		}
+	}
+	catch (IBK::Exception & ex) {
+		throw IBK::Exception( ex, IBK::FormatString("Error reading 'Drawing::Hatch' element."), FUNC_ID);
+	}
+	catch (std::exception & ex2) {
+		throw IBK::Exception( IBK::FormatString("%1\nError reading 'Drawing::Hatch' element.").arg(ex2.what()), FUNC_ID);
+	}
+}
+
+void Drawing::Hatch::tessellateOutline() const {
+	Q_ASSERT(m_parent != nullptr);
+
+	if (!m_dirtyLocalPoints && m_tessellationScalingFactor == m_parent->m_scalingFactor)
+		return;
+
+	m_pickPoints.clear();
+	m_loopOffsets.clear();
+
+	double maxDeviation = MAX_CHORD_DEVIATION / m_parent->m_scalingFactor;
+	m_loopOffsets.push_back(0);
+	for (const HatchLoop &loop : m_loops) {
+		HatchTessellation::tessellateLoop(loop.m_vertices, loop.m_bulges, maxDeviation, m_pickPoints);
+		m_loopOffsets.push_back((unsigned int)m_pickPoints.size());
+	}
+
+	m_tessellationScalingFactor = m_parent->m_scalingFactor;
+	m_dirtyLocalPoints = false;
+	m_dirtyTriangles = true;
+}
+
+void Drawing::Hatch::tessellate() const {
+	tessellateOutline();
+	if (!m_dirtyTriangles)
+		return;
+
+	m_triangles.clear();
+	// self-intersecting boundaries leave parts of the fill open, the outline is drawn nevertheless
+	if (m_solidFill)
+		HatchTessellation::triangulate(m_pickPoints, m_loopOffsets, m_triangles);
+	m_dirtyTriangles = false;
+}
+
+const std::vector<IBKMK::Vector2D> &Drawing::Hatch::points2D() const {
+	tessellateOutline();
+	return m_pickPoints;
+}
+
+const std::vector<Drawing::LineSegment> &Drawing::Hatch::localLineGeometries() const {
+	//	FUNCID(Drawing::Hatch::planeGeometries);
+
+	if (localGeometryDirty()) {
+		m_lineGeometries.clear();
+
+		std::vector<IBKMK::Vector3D> points;
+		m_parent->localPoints3D(points2D(), *this, points);
+
+		for (unsigned int l = 0; l + 1 < m_loopOffsets.size(); ++l) {
+			unsigned int first = m_loopOffsets[l];
+			unsigned int last = m_loopOffsets[l+1];
+			if (last - first < 2)
+				continue;
+			// loops are closed, the last point connects to the first one
+			for (unsigned int i = first; i < last; ++i) {
+				const IBKMK::Vector3D &p1 = points[i];
+				const IBKMK::Vector3D &p2 = points[i + 1 < last ? i + 1 : first];
+
+				m_lineGeometries.push_back(LineSegment(p1, p2));
+			}
+		}
+
+		localGeometryUpdated();
+	}
+
+	return m_lineGeometries;
+}
+
+TiXmlElement * Drawing::Spline::writeXMLPrivate(TiXmlElement * parent) const {
+	if (m_id == INVALID_ID)  return nullptr;
+
+	TiXmlElement * e = new TiXmlElement("Spline");
+	parent->LinkEndChild(e);
+
+	if (m_id != INVALID_ID)
+		e->SetAttribute("id", IBK::val2string<unsigned int>(m_id));
+	if (m_color.isValid())
+		e->SetAttribute("color", m_color.name().toStdString());
+	if (m_zPosition != 0.0)
+		e->SetAttribute("zPosition", IBK::val2string<unsigned int>(m_zPosition));
+	e->SetAttribute("degree", IBK::val2string<unsigned int>(m_degree));
+	if (m_closed)
+		e->SetAttribute("closed", IBK::val2string<bool>(m_closed));
+	if (!m_layerName.isEmpty())
+		e->SetAttribute("layer", m_layerName.toStdString());
+
+	if (!m_knots.empty())
+		TiXmlElement::appendSingleAttributeElement(e, "Knots", nullptr, std::string(), valuesToString(m_knots));
+	if (!m_controlPoints.empty())
+		TiXmlElement::appendSingleAttributeElement(e, "ControlPoints", nullptr, std::string(), verticesToString(m_controlPoints));
+	if (!m_weights.empty())
+		TiXmlElement::appendSingleAttributeElement(e, "Weights", nullptr, std::string(), valuesToString(m_weights));
+	if (!m_fitPoints.empty())
+		TiXmlElement::appendSingleAttributeElement(e, "FitPoints", nullptr, std::string(), verticesToString(m_fitPoints));
+
+	return e;
+}
+
+void Drawing::Spline::readXMLPrivate(const TiXmlElement *element){
+	FUNCID(Drawing::Spline::readXMLPrivate);
+
+	try {
+		// search for mandatory attributes
+		if (!TiXmlAttribute::attributeByName(element, "id")) {
+			IBK::IBK_Message( IBK::FormatString(XML_READ_ERROR).arg(element->Row()).arg(
+								  IBK::FormatString("Missing required 'id' attribute.") ), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+			return;
+		}
+
+		const TiXmlAttribute * attrib = element->FirstAttribute();
+		while (attrib) {
+			const std::string & attribName = attrib->NameStr();
+			if (attribName == "id")
+				m_id = readPODAttributeValue<unsigned int>(element, attrib);
+			else if (attribName == "color")
+				m_color = QColor(QString::fromStdString(attrib->ValueStr()));
+			else if (attribName == "zPosition")
+				m_zPosition = readPODAttributeValue<unsigned int>(element, attrib);
+			else if (attribName == "degree")
+				m_degree = readPODAttributeValue<unsigned int>(element, attrib);
+			else if (attribName == "closed")
+				m_closed = readPODAttributeValue<bool>(element, attrib);
+			else if (attribName == "layer")
+				m_layerName = QString::fromStdString(attrib->ValueStr());
+			else {
+				IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ATTRIBUTE).arg(attribName).arg(element->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+			}
+			attrib = attrib->Next();
+		}
+
+		// reading elements
+		const TiXmlElement * c = element->FirstChildElement();
+		while (c) {
+			const std::string & cName = c->ValueStr();
+			try {
+				if (cName == "Knots")
+					IBK::string2valueVector(c->GetText() != nullptr ? c->GetText() : "", m_knots);
+				else if (cName == "ControlPoints")
+					verticesFromString(c->GetText(), m_controlPoints);
+				else if (cName == "Weights")
+					IBK::string2valueVector(c->GetText() != nullptr ? c->GetText() : "", m_weights);
+				else if (cName == "FitPoints")
+					verticesFromString(c->GetText(), m_fitPoints);
+				else {
+					IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(cName).arg(c->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+				}
+			} catch (IBK::Exception & ex) {
+				throw IBK::Exception( ex, IBK::FormatString(XML_READ_ERROR).arg(c->Row())
+									  .arg("Error reading element '" + cName + "'."), FUNC_ID);
+			}
+			c = c->NextSiblingElement();
+		}
+	}
+	catch (IBK::Exception & ex) {
+		throw IBK::Exception( ex, IBK::FormatString("Error reading 'Drawing::Spline' element."), FUNC_ID);
+	}
+	catch (std::exception & ex2) {
+		throw IBK::Exception( IBK::FormatString("%1\nError reading 'Drawing::Spline' element.").arg(ex2.what()), FUNC_ID);
+	}
+}
+
+void Drawing::Spline::tessellate() const {
+	Q_ASSERT(m_parent != nullptr);
+
+	if (!m_dirtyLocalPoints && m_tessellationScalingFactor == m_parent->m_scalingFactor)
+		return;
+
+	if (!SplineTessellation::spline(m_degree, m_knots, m_controlPoints, m_weights,
+									MAX_CHORD_DEVIATION / m_parent->m_scalingFactor, m_pickPoints))
+	{
+		m_pickPoints = m_fitPoints.empty() ? m_controlPoints : m_fitPoints;
+	}
+
+	m_tessellationScalingFactor = m_parent->m_scalingFactor;
+	m_dirtyLocalPoints = false;
+}
+
+const std::vector<IBKMK::Vector2D> &Drawing::Spline::points2D() const {
+	tessellate();
+	return m_pickPoints;
+}
+
+const std::vector<Drawing::LineSegment> &Drawing::Spline::localLineGeometries() const {
+	//	FUNCID(Drawing::Spline::planeGeometries);
+
+	if (localGeometryDirty()) {
+		m_lineGeometries.clear();
+
+		std::vector<IBKMK::Vector3D> points;
+		m_parent->localPoints3D(points2D(), *this, points);
+
+		if (points.size() > 1) {
+			for (unsigned int i = 0; i < points.size() - 1; ++i)
+				m_lineGeometries.push_back(LineSegment(points[i], points[i+1]));
+			if (m_closed)
+				m_lineGeometries.push_back(LineSegment(points.back(), points.front()));
+		}
+
+		localGeometryUpdated();
+	}
+
+	return m_lineGeometries;
+}
+
 TiXmlElement * Drawing::LinearDimension::writeXMLPrivate(TiXmlElement * parent) const {
 	if (m_id == INVALID_ID)  return nullptr;
 
@@ -423,12 +803,14 @@ const std::vector<IBKMK::Vector2D> &Drawing::LinearDimension::points2D() const {
 	return m_pickPoints;
 }
 
-const std::vector<Drawing::LineSegment> &Drawing::LinearDimension::lineGeometries() const {
-	if (m_dirtyGlobalPoints) {
+const std::vector<Drawing::LineSegment> &Drawing::LinearDimension::localLineGeometries() const {
+	if (localGeometryDirty()) {
 		m_lineGeometries.clear();
 
-		if ((m_point1 - m_point2).magnitudeSquared() < 1E-2)
+		if ((m_point1 - m_point2).magnitudeSquared() < 1E-2) {
+			localGeometryUpdated();
 			return m_lineGeometries;
+		}
 
 		const Drawing *drawing = this->drawing();
 
@@ -439,8 +821,8 @@ const std::vector<Drawing::LineSegment> &Drawing::LinearDimension::lineGeometrie
 		// *** DIMENSION LINE  ***
 
 		// left + right
-		const IBKMK::Vector3D p1DimLine = m_parent->point3D(m_leftPoint, *this);
-		const IBKMK::Vector3D p2DimLine = m_parent->point3D(m_rightPoint, *this);
+		const IBKMK::Vector3D p1DimLine = m_parent->localPoint3D(m_leftPoint, *this);
+		const IBKMK::Vector3D p2DimLine = m_parent->localPoint3D(m_rightPoint, *this);
 
 		m_lineGeometries.push_back(LineSegment(p1DimLine, p2DimLine));
 
@@ -462,8 +844,8 @@ const std::vector<Drawing::LineSegment> &Drawing::LinearDimension::lineGeometrie
 		IBKMK::Vector2D lowerExtension = m_style->m_upperLineDistance * l.normalized();
 
 
-		IBKMK::Vector3D p1Left = m_parent->point3D(point, *this);
-		IBKMK::Vector3D p2Left = m_parent->point3D(m_leftPoint + lowerExtension, *this);
+		IBKMK::Vector3D p1Left = m_parent->localPoint3D(point, *this);
+		IBKMK::Vector3D p2Left = m_parent->localPoint3D(m_leftPoint + lowerExtension, *this);
 
 		m_lineGeometries.push_back(LineSegment(p1Left, p2Left));
 
@@ -481,8 +863,8 @@ const std::vector<Drawing::LineSegment> &Drawing::LinearDimension::lineGeometrie
 			point.m_y = m_point2.m_y + ext.m_y;
 		}
 
-		IBKMK::Vector3D p1Right = m_parent->point3D(point, *this);
-		IBKMK::Vector3D p2Right = m_parent->point3D(m_rightPoint + lowerExtension, *this);
+		IBKMK::Vector3D p1Right = m_parent->localPoint3D(point, *this);
+		IBKMK::Vector3D p2Right = m_parent->localPoint3D(m_rightPoint + lowerExtension, *this);
 
 		m_lineGeometries.push_back(LineSegment(p1Right, p2Right));
 
@@ -501,10 +883,10 @@ const std::vector<Drawing::LineSegment> &Drawing::LinearDimension::lineGeometrie
 
 		drawing->generateLinesFromText(measurementText.toStdString(),
 									   m_style->m_textHeight * m_style->m_globalScalingFactor * 2,
-									   Qt::AlignHCenter, m_angle, m_textPoint,
+									   Qt::AlignHCenter, -m_angle, m_textPoint,
 									   *this, m_lineGeometries);
 
-		m_dirtyGlobalPoints = false;
+		localGeometryUpdated();
 		m_dirtyLocalPoints = false;
 	}
 
@@ -598,10 +980,10 @@ const std::vector<IBKMK::Vector2D> &Drawing::Point::points2D() const {
 	return m_pickPoints;
 }
 
-const std::vector<Drawing::LineSegment> &Drawing::Point::lineGeometries() const {
+const std::vector<Drawing::LineSegment> &Drawing::Point::localLineGeometries() const {
 	FUNCID(Drawing::Line::planeGeometries);
 	try {
-		// if (m_dirtyGlobalPoints) {
+		// if (localGeometryDirty()) {
 		// 	m_lineGeometries.clear();
 
 		// 	// Create Vector from point, add point of origin to each coordinate and calculate z value
@@ -629,7 +1011,7 @@ const std::vector<Drawing::LineSegment> &Drawing::Point::lineGeometries() const
 
 
 		// 	m_lineGeometries.push_back(PlaneGeometry(po));
-		// 	m_dirtyGlobalPoints = false;
+		// 	localGeometryUpdated();
 		// }
 
 		return m_lineGeometries;
@@ -713,13 +1095,13 @@ const std::vector<IBKMK::Vector2D> &Drawing::Line::points2D() const {
 	return m_pickPoints;
 }
 
-const std::vector<Drawing::LineSegment> &Drawing::Line::lineGeometries() const {
-	if (m_dirtyGlobalPoints) {
+const std::vector<Drawing::LineSegment> &Drawing::Line::localLineGeometries() const {
+	if (localGeometryDirty()) {
 		m_lineGeometries.clear();
 
 		const Drawing *drawing = this->drawing();
-		std::vector<IBKMK::Vector2D> verts = points2D();
-		const std::vector<IBKMK::Vector3D> &points3D = drawing->points3D(verts, *this);
+		std::vector<IBKMK::Vector3D> points3D;
+		drawing->localPoints3D(points2D(), *this, points3D);
 
 		if (points3D[0] != points3D[1])
 			m_lineGeometries.push_back(LineSegment(points3D[0], points3D[1]));
@@ -727,7 +1109,7 @@ const std::vector<Drawing::LineSegment> &Drawing::Line::lineGeometries() const {
 		// if (!success)
 		// 	IBK::IBK_Message(IBK::FormatString("Could not generate plane from line #%1").arg(m_id), IBK::MSG_WARNING);
 
-		m_dirtyGlobalPoints = false;
+		localGeometryUpdated();
 	}
 
 	return m_lineGeometries;
@@ -834,15 +1216,8 @@ void Drawing::Circle::readXMLPrivate(const TiXmlElement *element){
 
 const std::vector<IBKMK::Vector2D>& Drawing::Circle::points2D() const {
 	if (m_dirtyLocalPoints) {
-		m_pickPoints.clear();
-
-		unsigned int count = SEGMENT_COUNT_CIRCLE * std::max(1, (int)(m_parent->m_scalingFactor * m_radius/15.0));
-		m_pickPoints.resize(count);
-
-		for(unsigned int i = 0; i < count; ++i){
-			m_pickPoints[i] =IBKMK::Vector2D(m_center.m_x + m_radius * cos(2 * IBK::PI * i / count),
-											 m_center.m_y + m_radius * sin(2 * IBK::PI * i / count));
-		}
+		// chord tolerance is given in m, convert to drawing units
+		CurveTessellation::circle(m_center, m_radius, MAX_CHORD_DEVIATION / m_parent->m_scalingFactor, m_pickPoints);
 
 		m_dirtyLocalPoints = false;
 	}
@@ -851,21 +1226,22 @@ const std::vector<IBKMK::Vector2D>& Drawing::Circle::points2D() const {
 }
 
 
-const std::vector<Drawing::LineSegment> &Drawing::Circle::lineGeometries() const {
+const std::vector<Drawing::LineSegment> &Drawing::Circle::localLineGeometries() const {
 	FUNCID(Drawing::Circle::planeGeometries);
 	try {
-		if (m_dirtyGlobalPoints) {
+		if (localGeometryDirty()) {
 			m_lineGeometries.clear();
 
-			std::vector<IBKMK::Vector2D> points(points2D());
+			std::vector<IBKMK::Vector3D> points;
+			m_parent->localPoints3D(points2D(), *this, points);
 			for(unsigned int i = 0; i < points.size(); i++){
-				const IBKMK::Vector3D &p1 = m_parent->point3D(points[  i					], *this);
-				const IBKMK::Vector3D &p2 = m_parent->point3D(points[ (i+1) % points.size() ], *this);
+				const IBKMK::Vector3D &p1 = points[  i					];
+				const IBKMK::Vector3D &p2 = points[ (i+1) % points.size() ];
 
 				m_lineGeometries.push_back(LineSegment(p1, p2));
 			}
 
-			m_dirtyGlobalPoints = false;
+			localGeometryUpdated();
 		}
 
 		return m_lineGeometries;
@@ -985,17 +1361,18 @@ const std::vector<IBKMK::Vector2D> &Drawing::PolyLine::points2D() const {
 	return m_pickPoints;
 }
 
-const std::vector<Drawing::LineSegment> &Drawing::PolyLine::lineGeometries() const {
+const std::vector<Drawing::LineSegment> &Drawing::PolyLine::localLineGeometries() const {
 	//	FUNCID(Drawing::PolyLine::planeGeometries);
 
-	if (m_dirtyGlobalPoints) {
+	if (localGeometryDirty()) {
 		m_lineGeometries.clear();
 
 		// Create Vector to store vertices of polyline
 		std::vector<IBKMK::Vector3D> polylinePoints;
 
 		const Drawing *drawing = this->drawing();
-		std::vector<IBKMK::Vector3D> points3D = drawing->points3D(m_polyline, *this);
+		std::vector<IBKMK::Vector3D> points3D;
+		drawing->localPoints3D(m_polyline, *this, points3D);
 
 		int offset = m_endConnected ? 0 : 1;
 		for (unsigned int i = 0; i < points3D.size() - offset; ++i){
@@ -1011,7 +1388,7 @@ const std::vector<Drawing::LineSegment> &Drawing::PolyLine::lineGeometries() con
 		// if (!success)
 		// 	return m_lineGeometries;
 
-		m_dirtyGlobalPoints = false;
+		localGeometryUpdated();
 	}
 
 	return m_lineGeometries;
@@ -1104,46 +1481,31 @@ void Drawing::Arc::readXMLPrivate(const TiXmlElement *element){
 const std::vector<IBKMK::Vector2D>& Drawing::Arc::points2D() const {
 
 	if (m_dirtyLocalPoints) {
-		double startAngle = m_startAngle;
-		double endAngle = m_endAngle;
-
-		double angleDifference;
-
-		if (startAngle > endAngle)
-			angleDifference = 2 * IBK::PI - startAngle + endAngle;
-		else
-			angleDifference = endAngle - startAngle;
-
-		unsigned int n = std::ceil(angleDifference / (2 * IBK::PI) * SEGMENT_COUNT_ARC);
-		double stepAngle = angleDifference / n;
-
-		m_pickPoints.resize(n + 1);
-		for (unsigned int i = 0; i < n+1; ++i){
-			m_pickPoints[i] = IBKMK::Vector2D(m_center.m_x + m_radius * cos(startAngle + i * stepAngle),
-											  m_center.m_y + m_radius * sin(startAngle + i * stepAngle));
-		}
+		CurveTessellation::arc(m_center, m_radius, m_startAngle, m_endAngle,
+							   MAX_CHORD_DEVIATION / m_parent->m_scalingFactor, m_pickPoints);
 
 		m_dirtyLocalPoints = false;
 	}
 	return m_pickPoints;
 }
 
-const std::vector<Drawing::LineSegment> &Drawing::Arc::lineGeometries() const {
+const std::vector<Drawing::LineSegment> &Drawing::Arc::localLineGeometries() const {
 	//	FUNCID(Drawing::Arc::planeGeometries);
 
 
-	if (m_dirtyGlobalPoints) {
+	if (localGeometryDirty()) {
 		m_lineGeometries.clear();
 
-		std::vector<IBKMK::Vector2D> points(points2D());
+		std::vector<IBKMK::Vector3D> points;
+		m_parent->localPoints3D(points2D(), *this, points);
 		for(unsigned int i = 0; i < points.size() - 1; ++i){
-			const IBKMK::Vector3D &p1 = m_parent->point3D(points[  i						], *this);
-			const IBKMK::Vector3D &p2 = m_parent->point3D(points[ (i+1) % SEGMENT_COUNT_ARC ], *this);
+			const IBKMK::Vector3D &p1 = points[  i						];
+			const IBKMK::Vector3D &p2 = points[  i+1						];
 
 			m_lineGeometries.push_back(LineSegment(p1, p2));
 		}
 
-		m_dirtyGlobalPoints = false;
+		localGeometryUpdated();
 	}
 
 
@@ -1247,46 +1609,19 @@ void Drawing::Ellipse::readXMLPrivate(const TiXmlElement *element){
 
 const std::vector<IBKMK::Vector2D> &Drawing::Ellipse::points2D() const {
 	if (m_dirtyLocalPoints) {
-		m_pickPoints.clear();
-
-		// iterateover data.vertlist, insert all vertices of Polyline into vector
-		double startAngle = m_startAngle;
-		double endAngle = m_endAngle;
-
-		double angleStep = (endAngle - startAngle) / (SEGMENT_COUNT_ELLIPSE - 1);
-
-		double majorRadius = sqrt(pow(m_majorAxis.m_x, 2) + pow(m_majorAxis.m_y, 2));
-		double minorRadius = majorRadius * m_ratio;
-		double rotationAngle = atan2(m_majorAxis.m_y, m_majorAxis.m_x);
-
-		double x, y, rotated_x, rotated_y;
+		CurveTessellation::ellipse(m_center, m_majorAxis, m_ratio, m_startAngle, m_endAngle,
+								   MAX_CHORD_DEVIATION / m_parent->m_scalingFactor, m_pickPoints);
 
-		m_pickPoints.resize(SEGMENT_COUNT_ELLIPSE);
-
-		for (unsigned int i = 0; i < SEGMENT_COUNT_ELLIPSE; ++i) {
-
-			double currentAngle = startAngle + i * angleStep;
-
-			x = majorRadius * cos(currentAngle);
-			y = minorRadius * sin(currentAngle);
-
-			rotated_x = x * cos(rotationAngle) - y * sin(rotationAngle);
-			rotated_y = x * sin(rotationAngle) + y * cos(rotationAngle);
-
-			m_pickPoints[i] = IBKMK::Vector2D(rotated_x + m_center.m_x,
-											  rotated_y + m_center.m_y);
-
-		}
 		m_dirtyLocalPoints = false;
 	}
 	return m_pickPoints;
 }
 
 
-const std::vector<Drawing::LineSegment> &Drawing::Ellipse::lineGeometries() const {
+const std::vector<Drawing::LineSegment> &Drawing::Ellipse::localLineGeometries() const {
 	FUNCID(Drawing::Ellipse::planeGeometries);
 	try {
-		if (m_dirtyGlobalPoints) {
+		if (localGeometryDirty()) {
 			m_lineGeometries.clear();
 
 			const std::vector<IBKMK::Vector2D> &pickPoints = points2D();
@@ -1295,7 +1630,7 @@ const std::vector<Drawing::LineSegment> &Drawing::Ellipse::lineGeometries() cons
 			// ToDo Stephan: Implement line geometries
 #if 0
 			std::vector<IBKMK::Vector3D> ellipsePoints;
-			for (unsigned int i = 0; i < SEGMENT_COUNT_ELLIPSE; i++) {
+			for (unsigned int i = 0; i < pickPoints.size(); i++) {
 
 				IBKMK::Vector3D p = IBKMK::Vector3D(drawing->m_scalingFactor * pickPoints[i].m_x,
 													drawing->m_scalingFactor * pickPoints[i].m_y,
@@ -1309,7 +1644,7 @@ const std::vector<Drawing::LineSegment> &Drawing::Ellipse::lineGeometries() cons
 
 			Q_ASSERT(points2D().size() > 0);
 #endif
-			m_dirtyGlobalPoints = false;
+			localGeometryUpdated();
 		}
 
 		return m_lineGeometries;
@@ -1324,12 +1659,56 @@ const std::vector<Drawing::LineSegment> &Drawing::Ellipse::lineGeometries() cons
 const Drawing::AbstractDrawingObject *Drawing::objectByID(unsigned int id) const {
 	FUNCID(Drawing::objectByID);
 
-	Q_ASSERT(m_objectPtr.find(id) != m_objectPtr.end());
-	AbstractDrawingObject *obj = m_objectPtr.at(id);
-	if (obj == nullptr)
+	// unsigned wrap around also covers IDs below m_idBase
+	const std::vector<LinkState::ObjectRef> &objects = m_linkState.m_objects;
+	std::size_t idx = id - m_linkState.m_idBase;
+	if (idx >= objects.size() || objects[idx].m_object == nullptr)
+		throw IBK::Exception(IBK::FormatString("Drawing Object with ID #%1 not found").arg(id), FUNC_ID);
+
+	return objects[idx].m_object;
+}
+
+
+Drawing::ObjectType Drawing::objectType(unsigned int id) const {
+	FUNCID(Drawing::objectType);
+
+	const std::vector<LinkState::ObjectRef> &objects = m_linkState.m_objects;
+	std::size_t idx = id - m_linkState.m_idBase;
+	if (idx >= objects.size() || objects[idx].m_object == nullptr)
 		throw IBK::Exception(IBK::FormatString("Drawing Object with ID #%1 not found").arg(id), FUNC_ID);
 
-	return obj;
+	return objects[idx].m_type;
+}
+
+
+const Drawing::AbstractDrawingObject *Drawing::objectByRef(const EntityRef &ref) const {
+	switch (ref.m_type) {
+		case OT_Point:				return &m_points[ref.m_idx];
+		case OT_Line:				return &m_lines[ref.m_idx];
+		case OT_PolyLine:			return &m_polylines[ref.m_idx];
+		case OT_Circle:				return &m_circles[ref.m_idx];
+		case OT_Ellipse:			return &m_ellipses[ref.m_idx];
+		case OT_Arc:				return &m_arcs[ref.m_idx];
+		case OT_Solid:				return &m_solids[ref.m_idx];
+		case OT_Text:				return &m_texts[ref.m_idx];
+		case OT_LinearDimension:	return &m_linearDimensions[ref.m_idx];
+		case OT_Hatch:				return &m_hatches[ref.m_idx];
+		case OT_Spline:				return &m_splines[ref.m_idx];
+		default:					break;
+	}
+	Q_ASSERT(false); // inserts are no drawing objects
+	return nullptr;
+}
+
+
+const std::vector<Drawing::EntityRef> &Drawing::layerEntities(const DrawingLayer *layer) const {
+	FUNCID(Drawing::layerEntities);
+
+	std::size_t idx = layer - m_drawingLayers.data();
+	if (layer < m_drawingLayers.data() || idx >= m_linkState.m_layerBuckets.size())
+		throw IBK::Exception(IBK::FormatString("Layer is not part of drawing or pointers are not updated."), FUNC_ID);
+
+	return m_linkState.m_layerBuckets[idx].m_entities;
 }
 
 
@@ -1352,9 +1731,157 @@ const DrawingLayer* Drawing::findLayerReference(const std::map<QString, const Dr
 }
 
 
+void Drawing::LinkState::registerObject(unsigned int id, AbstractDrawingObject *obj, ObjectType type) {
+	if (m_objects.empty())
+		m_idBase = id;
+	else if (id < m_idBase) {
+		// IDs below the current base are rare (objects added out of order), shift the table
+		m_objects.insert(m_objects.begin(), m_idBase - id, ObjectRef());
+		m_idBase = id;
+	}
+	std::size_t idx = id - m_idBase;
+	if (idx >= m_objects.size())
+		m_objects.resize(idx + 1);
+	m_objects[idx].m_object = obj;
+	m_objects[idx].m_type = type;
+}
+
+
+template <typename t>
+std::size_t Drawing::linkObjects(ChunkedVector<t> &objects, ObjectType type,
+								 const std::map<QString, const DrawingLayer*> &layerRefs,
+								 const std::map<QString, Block*> &blockRefs)
+{
+	std::size_t &linkedCount = m_linkState.m_linkedCount[type];
+	std::size_t first = linkedCount;
+
+	// name lookups only write to the object itself
+	parallelFor(objects.size() - first, [&](std::size_t i) {
+		t &obj = objects[first + i];
+		obj.m_layerRef = findLayerReference(layerRefs, obj.m_layerName);
+		obj.m_block = findBlockPointer(obj.m_blockName, blockRefs);
+		obj.m_parent = this;
+	}, ENTITY_CHUNK_SIZE);
+
+	// object table and entity lists are filled in object order
+	for (std::size_t i = first; i < objects.size(); ++i) {
+		t &obj = objects[i];
+		if (obj.m_id != INVALID_ID)
+			m_linkState.registerObject(obj.m_id, &obj, type);
+
+		EntityRef ref;
+		ref.m_type = type;
+		ref.m_idx = (unsigned int)i;
+		m_linkState.m_layerBuckets[obj.m_layerRef - m_drawingLayers.data()].m_entities.push_back(ref);
+		if (obj.m_block != nullptr)
+			m_linkState.m_blockEntities[obj.m_block].push_back(ref);
+	}
+	linkedCount = objects.size();
+	return first;
+}
+
+
+template <typename t>
+std::size_t Drawing::eraseObjectsByLayerMask(ChunkedVector<t> &objects, ObjectType type, const std::vector<char> &layerMask,
+											std::vector<unsigned int> &newIdx)
+{
+	newIdx.assign(objects.size(), INVALID_ID);
+	std::size_t j = 0;
+	for (std::size_t i = 0; i < objects.size(); ++i) {
+		t &obj = objects[i];
+		if (layerMask[obj.m_layerRef - m_drawingLayers.data()]) {
+			if (obj.m_id != INVALID_ID)
+				m_linkState.registerObject(obj.m_id, nullptr, NUM_OT);
+			continue;
+		}
+		if (i != j) {
+			objects[j] = std::move(obj);
+			if (objects[j].m_id != INVALID_ID)
+				m_linkState.registerObject(objects[j].m_id, &objects[j], type);
+		}
+		newIdx[i] = (unsigned int)j;
+		++j;
+	}
+	std::size_t erased = objects.size() - j;
+	while (objects.size() > j)
+		objects.pop_back();
+	m_linkState.m_linkedCount[type] = j;
+	return erased;
+}
+
+
+std::size_t Drawing::eraseObjectsByLayer(const std::set<QString> &layerNames) {
+	// all objects need a valid layer reference and entry in the object table
+	updatePointer();
+
+	std::vector<char> layerMask(m_drawingLayers.size(), 0);
+	bool found = false;
+	for (unsigned int i = 0; i < m_drawingLayers.size(); ++i) {
+		if (layerNames.find(m_drawingLayers[i].m_displayName) != layerNames.end()) {
+			layerMask[i] = 1;
+			found = true;
+		}
+	}
+	if (!found)
+		return 0;
+
+	std::vector<unsigned int> newIdx[NUM_OT];
+	std::size_t erased = 0;
+	erased += eraseObjectsByLayerMask(m_points, OT_Point, layerMask, newIdx[OT_Point]);
+	erased += eraseObjectsByLayerMask(m_lines, OT_Line, layerMask, newIdx[OT_Line]);
+	erased += eraseObjectsByLayerMask(m_polylines, OT_PolyLine, layerMask, newIdx[OT_PolyLine]);
+	erased += eraseObjectsByLayerMask(m_circles, OT_Circle, layerMask, newIdx[OT_Circle]);
+	erased += eraseObjectsByLayerMask(m_ellipses, OT_Ellipse, layerMask, newIdx[OT_Ellipse]);
+	erased += eraseObjectsByLayerMask(m_arcs, OT_Arc, layerMask, newIdx[OT_Arc]);
+	erased += eraseObjectsByLayerMask(m_solids, OT_Solid, layerMask, newIdx[OT_Solid]);
+	erased += eraseObjectsByLayerMask(m_texts, OT_Text, layerMask, newIdx[OT_Text]);
+	erased += eraseObjectsByLayerMask(m_linearDimensions, OT_LinearDimension, layerMask, newIdx[OT_LinearDimension]);
+	erased += eraseObjectsByLayerMask(m_hatches, OT_Hatch, layerMask, newIdx[OT_Hatch]);
+	erased += eraseObjectsByLayerMask(m_splines, OT_Spline, layerMask, newIdx[OT_Spline]);
+
+	// Remaining entities keep their order, hence cached bounds, pick points and line buffer data of
+	// the remaining layers stay valid and only the indexes change.
+	for (unsigned int i = 0; i < m_linkState.m_layerBuckets.size(); ++i) {
+		LinkState::LayerBucket &bucket = m_linkState.m_layerBuckets[i];
+		if (!layerMask[i]) {
+			for (EntityRef &ref : bucket.m_entities)
+				ref.m_idx = newIdx[ref.m_type][ref.m_idx];
+			continue;
+		}
+		removeMergedPickPoints(bucket);
+		bucket.m_entities.clear();
+		bucket.resetCache();
+		bucket.resetBuffer();
+		// new generation of the (now empty) buffer data, so that the assembled line buffer is rebuilt
+		bucket.m_bufferGeneration = ++m_linkState.m_lineBufferGeneration;
+	}
+	// intersection points may refer to removed lines
+	m_linkState.m_intersectionsValid = false;
+
+	for (std::pair<const Block* const, std::vector<EntityRef>> &blockEntities : m_linkState.m_blockEntities) {
+		std::vector<EntityRef> &refs = blockEntities.second;
+		std::size_t j = 0;
+		for (EntityRef ref : refs) {
+			ref.m_idx = newIdx[ref.m_type][ref.m_idx];
+			if (ref.m_idx != INVALID_ID)
+				refs[j++] = ref;
+		}
+		refs.resize(j);
+	}
+	return erased;
+}
+
+
+void Drawing::invalidatePointers() {
+	m_linkState.reset();
+	// merged pick points may contain removed objects
+	m_dirtyPickPoints = true;
+	m_dirtyPickPointIndex = true;
+}
+
+
 void Drawing::updatePointer(){
 	FUNCID(Drawing::updatePointer);
-	m_objectPtr.clear();
 
 	if (m_drawingLayers.empty()) {
 		m_drawingLayers.push_back(DrawingLayer());
@@ -1362,7 +1889,39 @@ void Drawing::updatePointer(){
 		m_drawingLayers.back().m_displayName = "0";
 	}
 
-	// map layer name to reference, this avoids nested loops
+	// Entities hold pointers to layers, blocks and dimension styles. Blocks are pointer stable,
+	// but new blocks may resolve previously unresolved block names. Any change requires a full relink.
+	if (m_linkState.m_layers != m_drawingLayers.data() || m_linkState.m_layerCount != m_drawingLayers.size() ||
+		m_linkState.m_blockCount != m_blocks.size() ||
+		m_linkState.m_dimStyles != m_dimensionStyles.data() || m_linkState.m_dimStyleCount != m_dimensionStyles.size())
+	{
+		invalidatePointers();
+	}
+
+	const std::size_t counts[NUM_OT] = {
+		m_points.size(), m_lines.size(), m_polylines.size(), m_circles.size(), m_ellipses.size(),
+		m_arcs.size(), m_solids.size(), m_texts.size(), m_linearDimensions.size(), m_hatches.size(), m_splines.size(),
+		m_inserts.size()
+	};
+	bool upToDate = true;
+	for (unsigned int i = 0; i < NUM_OT; ++i) {
+		// removed objects would leave dangling pointers in the object table
+		if (counts[i] < m_linkState.m_linkedCount[i]) {
+			invalidatePointers();
+			upToDate = false;
+			break;
+		}
+		if (counts[i] != m_linkState.m_linkedCount[i])
+			upToDate = false;
+	}
+	if (upToDate)
+		return;
+
+	// layer count is unchanged since last link, otherwise the buckets were cleared above
+	if (m_linkState.m_layerBuckets.empty())
+		m_linkState.m_layerBuckets.resize(m_drawingLayers.size());
+
+	// map layer name to reference, this avoids nested loops
 	std::map<QString, const DrawingLayer*> layerRefs;
 	for (const DrawingLayer &dl: m_drawingLayers) {
 		layerRefs[dl.m_displayName] = &dl;
@@ -1380,67 +1939,27 @@ void Drawing::updatePointer(){
 	 * Block references are optional, therefore we use the access function which returns a nullptr if there is no block ref
 	*/
 	try {
-
-		for (unsigned int i=0; i < m_points.size(); ++i){
-			m_points[i].m_layerRef = findLayerReference(layerRefs, m_points[i].m_layerName);
-			m_points[i].m_block = findBlockPointer(m_points[i].m_blockName, blockRefs);
-			m_points[i].m_parent = this;
-			m_objectPtr[m_points[i].m_id] = &m_points[i];
-		}
-		for (unsigned int i=0; i < m_lines.size(); ++i){
-			m_lines[i].m_layerRef = findLayerReference(layerRefs, m_lines[i].m_layerName);
-			m_lines[i].m_block = findBlockPointer(m_lines[i].m_blockName, blockRefs);
-			m_lines[i].m_parent = this;
-			m_objectPtr[m_lines[i].m_id] = &m_lines[i];
-		}
-		for (unsigned int i=0; i < m_polylines.size(); ++i){
-			m_polylines[i].m_layerRef = findLayerReference(layerRefs, m_polylines[i].m_layerName);
-			m_polylines[i].m_block = findBlockPointer(m_polylines[i].m_blockName, blockRefs);
-			m_polylines[i].m_parent = this;
-			m_objectPtr[m_polylines[i].m_id] = &m_polylines[i];
-		}
-		for (unsigned int i=0; i < m_circles.size(); ++i){
-			m_circles[i].m_layerRef = findLayerReference(layerRefs, m_circles[i].m_layerName);
-			m_circles[i].m_block = findBlockPointer(m_circles[i].m_blockName, blockRefs);
-			m_circles[i].m_parent = this;
-			m_objectPtr[m_circles[i].m_id] = &m_circles[i];
-		}
-		for (unsigned int i=0; i < m_arcs.size(); ++i){
-			m_arcs[i].m_layerRef = findLayerReference(layerRefs, m_arcs[i].m_layerName);
-			m_arcs[i].m_block = findBlockPointer(m_arcs[i].m_blockName, blockRefs);
-			m_arcs[i].m_parent = this;
-			m_objectPtr[m_arcs[i].m_id] = &m_arcs[i];
-		}
-		for (unsigned int i=0; i < m_ellipses.size(); ++i){
-			m_ellipses[i].m_layerRef = findLayerReference(layerRefs, m_ellipses[i].m_layerName);
-			m_ellipses[i].m_block = findBlockPointer(m_ellipses[i].m_blockName, blockRefs);
-			m_ellipses[i].m_parent = this;
-			m_objectPtr[m_ellipses[i].m_id] = &m_ellipses[i];
-		}
-		for (unsigned int i=0; i < m_solids.size(); ++i){
-			m_solids[i].m_layerRef = findLayerReference(layerRefs, m_solids[i].m_layerName);
-			m_solids[i].m_block = findBlockPointer(m_solids[i].m_blockName, blockRefs);
-			m_solids[i].m_parent = this;
-			m_objectPtr[m_solids[i].m_id] = &m_solids[i];
-		}
-		for (unsigned int i=0; i < m_texts.size(); ++i){
-			m_texts[i].m_layerRef = findLayerReference(layerRefs, m_texts[i].m_layerName);
-			m_texts[i].m_block = findBlockPointer(m_texts[i].m_blockName, blockRefs);
-			m_texts[i].m_parent = this;
-			m_objectPtr[m_texts[i].m_id] = &m_texts[i];
-		}
+		linkObjects(m_points, OT_Point, layerRefs, blockRefs);
+		linkObjects(m_lines, OT_Line, layerRefs, blockRefs);
+		linkObjects(m_polylines, OT_PolyLine, layerRefs, blockRefs);
+		linkObjects(m_circles, OT_Circle, layerRefs, blockRefs);
+		linkObjects(m_arcs, OT_Arc, layerRefs, blockRefs);
+		linkObjects(m_ellipses, OT_Ellipse, layerRefs, blockRefs);
+		linkObjects(m_solids, OT_Solid, layerRefs, blockRefs);
+		linkObjects(m_texts, OT_Text, layerRefs, blockRefs);
+		linkObjects(m_hatches, OT_Hatch, layerRefs, blockRefs);
+		linkObjects(m_splines, OT_Spline, layerRefs, blockRefs);
 
 		// For inserts there must be a valid currentBlock reference!
-		for (unsigned int i=0; i < m_inserts.size(); ++i){
+		for (std::size_t i = m_linkState.m_linkedCount[OT_Insert]; i < m_inserts.size(); ++i){
 			m_inserts[i].m_currentBlock = findBlockPointer(m_inserts[i].m_currentBlockName, blockRefs);
 			Q_ASSERT(m_inserts[i].m_currentBlock);
 			m_inserts[i].m_parentBlock = findBlockPointer(m_inserts[i].m_parentBlockName, blockRefs);
 		}
-		for (unsigned int i=0; i < m_linearDimensions.size(); ++i){
-			m_linearDimensions[i].m_layerRef = findLayerReference(layerRefs, m_linearDimensions[i].m_layerName);
-			m_linearDimensions[i].m_parent = this;
-			m_texts[i].m_block = findBlockPointer(m_linearDimensions[i].m_blockName, blockRefs);
-			m_objectPtr[m_linearDimensions[i].m_id] = &m_linearDimensions[i];
+		m_linkState.m_linkedCount[OT_Insert] = m_inserts.size();
+
+		std::size_t first = linkObjects(m_linearDimensions, OT_LinearDimension, layerRefs, blockRefs);
+		for (std::size_t i = first; i < m_linearDimensions.size(); ++i){
 			for(unsigned int j = 0; j < m_dimensionStyles.size(); ++j) {
 				const QString &dimStyleName = m_dimensionStyles[j].m_name;
 				const QString &styleName = m_linearDimensions[i].m_styleName;
@@ -1450,73 +1969,65 @@ void Drawing::updatePointer(){
 				}
 			}
 			// In order to be safe
-			if (m_linearDimensions[i].m_style == nullptr)
+			if (m_linearDimensions[i].m_style == nullptr && !m_dimensionStyles.empty())
 				m_linearDimensions[i].m_style = &m_dimensionStyles.front();
 		}
 	}
 	catch (std::exception &ex) {
+		invalidatePointers();
 		throw IBK::Exception(IBK::FormatString("Error during initialization of DXF file. "
 											   "Might be due to invalid layer references.\n%1").arg(ex.what()), FUNC_ID);
 	}
-}
 
-template <typename t>
-void updateGeometry(std::vector<t> &objects) {
-	for (t &obj : objects )
-		obj.updatePlaneGeometry();
+	m_linkState.m_layers = m_drawingLayers.data();
+	m_linkState.m_layerCount = m_drawingLayers.size();
+	m_linkState.m_blockCount = m_blocks.size();
+	m_linkState.m_dimStyles = m_dimensionStyles.data();
+	m_linkState.m_dimStyleCount = m_dimensionStyles.size();
 }
 
-
 void Drawing::updatePlaneGeometries() {
-	updateGeometry<Drawing::Line>(m_lines);
-	updateGeometry<Drawing::PolyLine>(m_polylines);
-	updateGeometry<Drawing::Arc>(m_arcs);
-	updateGeometry<Drawing::Circle>(m_circles);
-	updateGeometry<Drawing::Ellipse>(m_ellipses);
-	updateGeometry<Drawing::Solid>(m_solids);
-	updateGeometry<Drawing::LinearDimension>(m_linearDimensions);
-	updateGeometry<Drawing::Point>(m_points);
-	updateGeometry<Drawing::Text>(m_texts);
-
+	// entities compare their line geometries against the geometry versions, a new
+	// drawing placement only requires the global geometries to be transformed again
+	updateTransformations();
+	++m_globalGeometryVersion;
+
+	// cached bounds and pick points of all layers are outdated
+	for (const LinkState::LayerBucket &bucket : m_linkState.m_layerBuckets)
+		bucket.resetCache();
+	m_linkState.m_intersectionsValid = false;
 	m_dirtyPickPoints = true;
+	m_dirtyPickPointIndex = true;
 }
 
 template <typename t>
-void generateObjectFromInsert(unsigned int &nextId, const Drawing::Block &block,
-							  std::vector<t> &objects, const QMatrix4x4 &trans) {
-	std::vector<t> newObjects;
-
-	for (const t &obj : objects) {
-
-		if (obj.m_block == nullptr)
-			continue;
-
-		if (obj.m_block->m_name != block.m_name)
+void generateObjectFromInsert(unsigned int &nextId, const std::vector<Drawing::EntityRef> &blockEntities,
+							  Drawing::ObjectType type, ChunkedVector<t> &objects, unsigned int transIdx) {
+	// objects are pointer stable, so copies can be appended directly while iterating
+	// over the entities of the block
+	for (const Drawing::EntityRef &ref : blockEntities) {
+		if (ref.m_type != type)
 			continue;
 
-		t newObj(obj);
+		t newObj(objects[ref.m_idx]);
 		newObj.m_id = ++nextId;
-		newObj.m_trans = trans;
+		newObj.m_transIdx = transIdx;
 		newObj.m_blockName = "";
 		newObj.m_block = nullptr;
 		newObj.m_isInsertObject = true;
 
-		newObjects.push_back(newObj);
+		objects.push_back(std::move(newObj));
 	}
-
-	objects.insert(objects.end(), newObjects.begin(), newObjects.end());
 }
 
-void Drawing::transformInsert(QMatrix4x4 trans, const Drawing::Insert &insert, unsigned int &nextId) {
+void Drawing::transformInsert(glm::dmat4 trans, const Drawing::Insert &insert, unsigned int &nextId) {
 
 	Q_ASSERT(insert.m_currentBlock != nullptr);
 	IBKMK::Vector2D insertPoint = insert.m_insertionPoint - insert.m_currentBlock->m_basePoint;
 
-	trans.translate(QVector3D(float(insertPoint.m_x),
-							  float(insertPoint.m_y),
-							  0.0));
-	trans.rotate(float(insert.m_angle/IBK::DEG2RAD), QVector3D(0,0,1)); // Rotation is in degree
-	trans.scale(float(insert.m_xScale), float(insert.m_yScale), 1);
+	trans = glm::translate(trans, glm::dvec3(insertPoint.m_x, insertPoint.m_y, 0.0));
+	trans = glm::rotate(trans, insert.m_angle, glm::dvec3(0,0,1)); // Rotation is in rad
+	trans = glm::scale(trans, glm::dvec3(insert.m_xScale, insert.m_yScale, 1.0));
 
 	for (const Insert &i : m_inserts) {
 		if (i.m_parentBlock == nullptr)
@@ -1527,21 +2038,27 @@ void Drawing::transformInsert(QMatrix4x4 trans, const Drawing::Insert &insert, u
 		}
 	}
 
-	generateObjectFromInsert(nextId, *insert.m_currentBlock, m_points, trans);
-	generateObjectFromInsert(nextId, *insert.m_currentBlock, m_arcs, trans);
-	generateObjectFromInsert(nextId, *insert.m_currentBlock, m_circles, trans);
-	generateObjectFromInsert(nextId, *insert.m_currentBlock, m_ellipses, trans);
-	generateObjectFromInsert(nextId, *insert.m_currentBlock, m_lines, trans);
-	generateObjectFromInsert(nextId, *insert.m_currentBlock, m_polylines, trans);
-	generateObjectFromInsert(nextId, *insert.m_currentBlock, m_solids, trans);
-	generateObjectFromInsert(nextId, *insert.m_currentBlock, m_texts, trans);
-	generateObjectFromInsert(nextId, *insert.m_currentBlock, m_linearDimensions, trans);
-}
+	// entities of the block definition, generated copies are not linked yet and hence not part of the list
+	std::map<const Block*, std::vector<EntityRef>>::const_iterator it = m_linkState.m_blockEntities.find(insert.m_currentBlock);
+	if (it == m_linkState.m_blockEntities.end())
+		return;
+	const std::vector<EntityRef> &blockEntities = it->second;
 
+	// all objects of this insert share one palette entry
+	unsigned int transIdx = (unsigned int)m_insertTransforms.size();
+	m_insertTransforms.push_back(trans);
 
-void transformPoint(IBKMK::Vector2D &vec, const QMatrix4x4 &trans) {
-	IBKMK::Vector3D v3 = QVector2IBKVector(trans * QVector3D((float)vec.m_x, (float)vec.m_y, 0));
-	vec = v3.point2D();
+	generateObjectFromInsert(nextId, blockEntities, OT_Point, m_points, transIdx);
+	generateObjectFromInsert(nextId, blockEntities, OT_Arc, m_arcs, transIdx);
+	generateObjectFromInsert(nextId, blockEntities, OT_Circle, m_circles, transIdx);
+	generateObjectFromInsert(nextId, blockEntities, OT_Ellipse, m_ellipses, transIdx);
+	generateObjectFromInsert(nextId, blockEntities, OT_Line, m_lines, transIdx);
+	generateObjectFromInsert(nextId, blockEntities, OT_PolyLine, m_polylines, transIdx);
+	generateObjectFromInsert(nextId, blockEntities, OT_Solid, m_solids, transIdx);
+	generateObjectFromInsert(nextId, blockEntities, OT_Text, m_texts, transIdx);
+	generateObjectFromInsert(nextId, blockEntities, OT_LinearDimension, m_linearDimensions, transIdx);
+	generateObjectFromInsert(nextId, blockEntities, OT_Hatch, m_hatches, transIdx);
+	generateObjectFromInsert(nextId, blockEntities, OT_Spline, m_splines, transIdx);
 }
 
 
@@ -1557,8 +2074,7 @@ void Drawing::generateInsertGeometries(unsigned int nextId) {
 		if (insert.m_currentBlock == nullptr)
 			throw IBK::Exception(IBK::FormatString("Block with name '%1' was not found").arg(insert.m_currentBlockName.toStdString()), FUNC_ID);
 
-		QMatrix4x4 trans;
-		transformInsert(trans, insert, nextId);
+		transformInsert(glm::dmat4(1.0), insert, nextId);
 	}
 
 	updateParents();
@@ -1566,28 +2082,120 @@ void Drawing::generateInsertGeometries(unsigned int nextId) {
 
 
 void Drawing::updateAllGeometries() {
-	updateGeometryForAll(m_points);
-	updateGeometryForAll(m_lines);
-	updateGeometryForAll(m_polylines);
-	updateGeometryForAll(m_circles);
-	updateGeometryForAll(m_ellipses);
-	updateGeometryForAll(m_arcs);
-	updateGeometryForAll(m_solids);
-	updateGeometryForAll(m_texts);
-	updateGeometryForAll(m_linearDimensions);
+	// regenerates local geometries of all entities on next access
+	++m_localGeometryVersion;
+	updatePlaneGeometries();
 }
 
 void Drawing::sortLayersAlphabetical() {
 	std::sort(m_drawingLayers.begin(), m_drawingLayers.end(), [](const DrawingLayer& a, const DrawingLayer& b) {
 		return a.m_displayName < b.m_displayName;
 	});
+	// layer pointers of all entities refer to the old order
+	invalidatePointers();
+}
+
+void Drawing::simplifyPolylines(double tolerance, PolylineSimplification::Statistics &stats) {
+	// tolerance in drawing units
+	double tol = tolerance / m_scalingFactor;
+	for (PolyLine &pl : m_polylines) {
+		if (PolylineSimplification::simplify(pl.m_polyline, pl.m_endConnected, tol, stats))
+			pl.updatePoints();
+	}
+	// cached bounds, pick points and line geometries contain removed vertices
+	updateAllGeometries();
+}
+
+/*! Removes all objects with erase[i] != 0 in linear time, order of remaining objects is kept. */
+template <typename t>
+static void eraseFlagged(ChunkedVector<t> &objects, const std::vector<char> &erase) {
+	std::size_t j = 0;
+	for (std::size_t i = 0; i < objects.size(); ++i) {
+		if (erase[i])
+			continue;
+		if (i != j)
+			objects[j] = std::move(objects[i]);
+		++j;
+	}
+	while (objects.size() > j)
+		objects.pop_back();
+}
+
+void Drawing::tessellateSplines() const {
+	parallelFor(m_splines.size(), [this](std::size_t i) {
+		m_splines[i].tessellate();
+	});
+}
+
+
+void Drawing::removeDuplicateLines(double tolerance, const std::set<QString> &layerNames, LineDeduplication::Statistics &stats) {
+	std::vector<LineDeduplication::Segment> segments;
+	std::vector<std::size_t> lineIdx;
+	segments.reserve(m_lines.size());
+	lineIdx.reserve(m_lines.size());
+
+	// lines are only joined with lines of same layer, color and line weight
+	std::map<QString, int> mergeGroups;
+	for (std::size_t i = 0; i < m_lines.size(); ++i) {
+		const Line &l = m_lines[i];
+		// block definitions are in block coordinates
+		if (!l.m_blockName.isEmpty())
+			continue;
+
+		// lines generated from inserts are compared in drawing coordinates
+		const glm::dmat4 &m = m_insertTransforms[l.m_transIdx];
+		LineDeduplication::Segment s;
+		s.m_p1 = IBKMK::Vector2D(m[0][0]*l.m_point1.m_x + m[1][0]*l.m_point1.m_y + m[3][0],
+								 m[0][1]*l.m_point1.m_x + m[1][1]*l.m_point1.m_y + m[3][1]);
+		s.m_p2 = IBKMK::Vector2D(m[0][0]*l.m_point2.m_x + m[1][0]*l.m_point2.m_y + m[3][0],
+								 m[0][1]*l.m_point2.m_x + m[1][1]*l.m_point2.m_y + m[3][1]);
+		s.m_removable = layerNames.empty() || layerNames.find(l.m_layerName) != layerNames.end();
+		if (l.m_transIdx == 0) {
+			QString key = QString("%1\n%2\n%3").arg(l.m_layerName)
+					.arg(l.m_color.isValid() ? l.m_color.name(QColor::HexArgb) : QString())
+					.arg(l.m_lineWeight);
+			std::map<QString, int>::const_iterator it = mergeGroups.find(key);
+			if (it == mergeGroups.end())
+				it = mergeGroups.insert(std::make_pair(key, (int)mergeGroups.size())).first;
+			s.m_mergeGroup = it->second;
+		}
+
+		segments.push_back(s);
+		lineIdx.push_back(i);
+	}
+
+	std::vector<char> removed;
+	LineDeduplication::deduplicate(segments, tolerance / m_scalingFactor, removed, stats);
+	if (stats.removed() == 0)
+		return;
+
+	std::vector<char> erase(m_lines.size(), 0);
+	for (std::size_t i = 0; i < segments.size(); ++i) {
+		Line &l = m_lines[lineIdx[i]];
+		if (removed[i]) {
+			erase[lineIdx[i]] = 1;
+			continue;
+		}
+		// joined lines, only lines without insert transformation are joined
+		if (l.m_transIdx == 0 && (l.m_point1 != segments[i].m_p1 || l.m_point2 != segments[i].m_p2)) {
+			l.m_point1 = segments[i].m_p1;
+			l.m_point2 = segments[i].m_p2;
+			l.updatePoints();
+		}
+	}
+
+	eraseFlagged(m_lines, erase);
+	// erased objects shift all following objects
+	invalidatePointers();
 }
 
 template<typename t>
-void addPoints(const std::vector<t> objs, const Drawing *d, std::vector<double> &xValues, std::vector<double> &yValues, int cnt) {
+void addPoints(const ChunkedVector<t> &objs, const Drawing *d, std::vector<double> &xValues, std::vector<double> &yValues, int cnt) {
 	int moduloThreshold = 10;
+	std::vector<IBKMK::Vector3D> points;
 	for (const t &o : objs) {
-		for (const IBKMK::Vector3D &v : d->points3D(o.points2D(), o)) {
+		d->points3D(o.points2D(), o, points);
+		for (const IBKMK::Vector3D &v : points) {
 			if(cnt % moduloThreshold == 0){
 				xValues.push_back(v.m_x);
 				yValues.push_back(v.m_y);
@@ -1638,143 +2246,697 @@ IBKMK::Vector3D Drawing::weightedCenterMedian(unsigned int nextId) {
 const std::map<Drawing::Field, std::map<unsigned int, std::vector<IBKMK::Vector3D>>> &Drawing::pickPoints() const {
 	FUNCID(Drawing::pickPoints);
 	try {
+		checkCachedTransformation();
 		if (m_dirtyPickPoints) {
+			m_pickPoints.clear();
+			for (const LinkState::LayerBucket &bucket : m_linkState.m_layerBuckets)
+				bucket.m_picksMerged = false;
+			m_dirtyPickPoints = false;
+		}
 
-			qDebug() << "Start adding pick points.";
+		// only layers with changed visibility or new entities are touched
+		const std::vector<LinkState::LayerBucket> &buckets = m_linkState.m_layerBuckets;
+		Q_ASSERT(buckets.size() <= m_drawingLayers.size());
+		std::vector<unsigned int> visibleBuckets;
+		std::vector<std::size_t> firstUnmerged;
+		for (unsigned int i = 0; i < buckets.size(); ++i) {
+			const LinkState::LayerBucket &bucket = buckets[i];
 
-			m_pickPoints.clear();
-			addPickPoints(m_points);
-			// qDebug() << "points.";
+			if (!m_drawingLayers[i].m_visible) {
+				removeMergedPickPoints(bucket);
+				continue;
+			}
+			visibleBuckets.push_back(i);
+			firstUnmerged.push_back(bucket.m_picksMerged ? bucket.m_pickPoints.size() : 0);
+		}
 
-			addPickPoints(m_arcs);
-			// qDebug() << "arcs.";
+		updateLayerPickPoints(visibleBuckets);
 
-			addPickPoints(m_circles);
-			// qDebug() << "circles.";
+		// the map is shared by all layers, hence merged on this thread
+		for (unsigned int k = 0; k < visibleBuckets.size(); ++k) {
+			const LinkState::LayerBucket &bucket = buckets[visibleBuckets[k]];
+			for (std::size_t j = firstUnmerged[k]; j < bucket.m_pickPoints.size(); ++j) {
+				const LinkState::PickPoint &pp = bucket.m_pickPoints[j];
+				m_pickPoints[pp.m_field][pp.m_id].push_back(pp.m_point);
+			}
+			bucket.m_picksMerged = true;
+		}
 
-			addPickPoints(m_ellipses);
-			// qDebug() << "ellipses.";
+		// intersection points are only part of pickPointIndex()
+		return m_pickPoints;
+	}
+	catch (IBK::Exception &ex) {
+		throw IBK::Exception(IBK::FormatString("Could not generate pick points.\n%1").arg(ex.what()), FUNC_ID);
+	}
+}
 
-			addPickPoints(m_linearDimensions, true);
-			// qDebug() << "linear Dim.";
 
-			addPickPoints(m_lines, true);
-			// qDebug() << "lines.";
+const Drawing::PickPointIndex &Drawing::pickPointIndex() const {
+	FUNCID(Drawing::pickPointIndex);
+	try {
+		checkCachedTransformation();
+
+		const std::vector<LinkState::LayerBucket> &buckets = m_linkState.m_layerBuckets;
+		Q_ASSERT(buckets.size() <= m_drawingLayers.size());
+		std::vector<unsigned int> visibleBuckets;
+		for (unsigned int i = 0; i < buckets.size(); ++i) {
+			if (m_drawingLayers[i].m_visible)
+				visibleBuckets.push_back(i);
+		}
+		updateLayerPickPoints(visibleBuckets);
+		if (m_intersectionPickPoints)
+			addInstersectionPoints();
+
+		std::vector<std::pair<unsigned int, std::size_t>> layers;
+		std::vector<std::size_t> firstPick(1, 0);
+		for (unsigned int i : visibleBuckets) {
+			std::size_t count = buckets[i].m_pickPoints.size();
+			if (m_intersectionPickPoints)
+				count += buckets[i].m_intersectionPoints.size();
+			layers.push_back(std::make_pair(i, count));
+			firstPick.push_back(firstPick.back() + count);
+		}
+		// same layers with unchanged pick points, index is up to date
+		if (!m_dirtyPickPointIndex && layers == m_pickPointIndexLayers)
+			return m_pickPointIndex;
+
+		// pick points of the layers were generated per chunk of entities without locks, they only need to be
+		// sorted by field, which does not depend on the order of the layers
+		std::vector<LinkState::PickPoint> picks(firstPick.back());
+		parallelFor(visibleBuckets.size(), [&](std::size_t k) {
+			const LinkState::LayerBucket &bucket = buckets[visibleBuckets[k]];
+			std::vector<LinkState::PickPoint>::iterator it =
+					std::copy(bucket.m_pickPoints.begin(), bucket.m_pickPoints.end(), picks.begin() + firstPick[k]);
+			if (m_intersectionPickPoints)
+				std::copy(bucket.m_intersectionPoints.begin(), bucket.m_intersectionPoints.end(), it);
+		}, 1);
+
+		// key words in the order of Field::operator<, sign bits are flipped to sort negative fields first
+		std::vector<LinkState::PickPoint> buffer;
+		parallelRadixSort(picks, buffer, 3, [](const LinkState::PickPoint &pp, unsigned int w) {
+			int key = w == 0 ? pp.m_field.m_x : (w == 1 ? pp.m_field.m_y : pp.m_field.m_z);
+			return (std::uint32_t)key ^ 0x80000000u;
+		});
+
+		PickPointIndex &index = m_pickPointIndex;
+		index.m_fields.clear();
+		index.m_offsets.clear();
+		index.m_entries.resize(picks.size());
+		parallelFor(picks.size(), [&](std::size_t i) {
+			index.m_entries[i].m_id = picks[i].m_id;
+			index.m_entries[i].m_point = picks[i].m_point;
+		}, ENTITY_CHUNK_SIZE);
+		for (std::size_t i = 0; i < picks.size(); ++i) {
+			if (i == 0 || !(picks[i].m_field == picks[i-1].m_field)) {
+				index.m_fields.push_back(picks[i].m_field);
+				index.m_offsets.push_back(i);
+			}
+		}
+		index.m_offsets.push_back(picks.size());
+
+		m_pickPointIndexLayers.swap(layers);
+		m_dirtyPickPointIndex = false;
+		return index;
+	}
+	catch (IBK::Exception &ex) {
+		throw IBK::Exception(IBK::FormatString("Could not generate pick point index.\n%1").arg(ex.what()), FUNC_ID);
+	}
+}
 
-			addPickPoints(m_polylines, true);
-			// qDebug() << "polylines.";
 
-			addPickPoints(m_solids);
-			// qDebug() << "solids.";
+void Drawing::checkCachedTransformation() const {
+	QQuaternion rotation = m_rotationMatrix.toQuaternion();
+	if (m_linkState.m_cacheOffset == m_offset && m_linkState.m_cacheRotation == rotation &&
+		m_linkState.m_cacheScalingFactor == m_scalingFactor && m_linkState.m_cacheFieldSize == m_fieldSize)
+	{
+		return;
+	}
 
-			// For now only line intersections are treated
-			// addInstersectionPoints();
+	for (const LinkState::LayerBucket &bucket : m_linkState.m_layerBuckets)
+		bucket.resetCache();
+	m_linkState.m_intersectionsValid = false;
+	m_dirtyPickPoints = true;
+	m_dirtyPickPointIndex = true;
 
-			qDebug() << "Added pick points.";
+	m_linkState.m_cacheOffset = m_offset;
+	m_linkState.m_cacheRotation = rotation;
+	m_linkState.m_cacheScalingFactor = m_scalingFactor;
+	m_linkState.m_cacheFieldSize = m_fieldSize;
+}
 
-			m_dirtyPickPoints = false;
-		}
-		return m_pickPoints;
+
+void Drawing::boundingBox(IBKMK::Vector3D &lowerValues, IBKMK::Vector3D &upperValues) const {
+	checkCachedTransformation();
+
+	lowerValues = IBKMK::Vector3D(std::numeric_limits<double>::max(),
+								  std::numeric_limits<double>::max(),
+								  std::numeric_limits<double>::max());
+	upperValues = IBKMK::Vector3D(std::numeric_limits<double>::lowest(),
+								  std::numeric_limits<double>::lowest(),
+								  std::numeric_limits<double>::lowest());
+
+	const std::vector<LinkState::LayerBucket> &buckets = m_linkState.m_layerBuckets;
+	Q_ASSERT(buckets.size() <= m_drawingLayers.size());
+	std::vector<unsigned int> bucketIdxs;
+	for (unsigned int i = 0; i < buckets.size(); ++i) {
+		const DrawingLayer &dl = m_drawingLayers[i];
+		if (!dl.m_visible)
+			continue;
+
+		if (dl.m_displayName == "0")
+			continue; // Skipping historic layer 0 for better bounding box results
+
+		bucketIdxs.push_back(i);
 	}
-	catch (IBK::Exception &ex) {
-		throw IBK::Exception(IBK::FormatString("Could not generate pick points.\n%1").arg(ex.what()), FUNC_ID);
+
+	updateLayerBounds(bucketIdxs);
+	for (unsigned int i : bucketIdxs) {
+		const LinkState::LayerBucket &bucket = buckets[i];
+		if (bucket.m_boundsCount == 0)
+			continue;
+
+		lowerValues.m_x = std::min(lowerValues.m_x, bucket.m_lowerValues.m_x);
+		lowerValues.m_y = std::min(lowerValues.m_y, bucket.m_lowerValues.m_y);
+		lowerValues.m_z = std::min(lowerValues.m_z, bucket.m_lowerValues.m_z);
+
+		upperValues.m_x = std::max(upperValues.m_x, bucket.m_upperValues.m_x);
+		upperValues.m_y = std::max(upperValues.m_y, bucket.m_upperValues.m_y);
+		upperValues.m_z = std::max(upperValues.m_z, bucket.m_upperValues.m_z);
 	}
 }
 
 
-const IBKMK::Vector3D Drawing::point3D(const IBKMK::Vector2D &vert, const AbstractDrawingObject &object) const {
-	glm::vec3 v3D = object.transformationMatrix() * glm::dvec4(vert.m_x, vert.m_y, 0.0, 1.0);
-	return IBKMK::Vector3D(v3D.x, v3D.y, v3D.z);
+static_assert(sizeof(Drawing::LineVertex) == 7 * sizeof(float), "LineVertex must be tightly packed");
+
+const Drawing::LineBuffer &Drawing::lineBuffer() const {
+	const LinkState &ls = m_linkState;
+
+	// all layer buffers are outdated when local geometries or line weight settings changed
+	updateTransformations();
+	if (ls.m_lineBufferVersion != m_localGeometryVersion || ls.m_lineBufferWeightScaling != m_lineWeightScaling ||
+			ls.m_lineBufferWeightOffset != m_lineWeightOffset)
+	{
+		for (const LinkState::LayerBucket &bucket : ls.m_layerBuckets)
+			bucket.resetBuffer();
+		ls.m_lineBufferVersion = m_localGeometryVersion;
+		ls.m_lineBufferWeightScaling = m_lineWeightScaling;
+		ls.m_lineBufferWeightOffset = m_lineWeightOffset;
+		ls.m_lineBufferCentered = false;
+	}
+
+	Q_ASSERT(ls.m_layerBuckets.size() <= m_drawingLayers.size());
+	std::vector<unsigned int> visibleBuckets;
+	for (unsigned int i = 0; i < ls.m_layerBuckets.size(); ++i) {
+		if (m_drawingLayers[i].m_visible)
+			visibleBuckets.push_back(i);
+	}
+
+	// line geometries are generated on all cores, buffer data is then copied in entity order
+	updateLayerLineGeometries(visibleBuckets);
+
+	std::vector<std::pair<unsigned int, unsigned int>> layers;
+	for (unsigned int i : visibleBuckets) {
+		const LinkState::LayerBucket &bucket = ls.m_layerBuckets[i];
+		updateLayerLineBuffer(m_drawingLayers[i], bucket);
+		layers.push_back(std::make_pair(i, bucket.m_bufferGeneration));
+	}
+
+	// same layers with unchanged data, buffer is up to date
+	if (layers == ls.m_lineBufferLayers)
+		return ls.m_lineBuffer;
+
+	LineBuffer &buffer = ls.m_lineBuffer;
+	std::size_t vertexCount = 0, indexCount = 0;
+	for (const std::pair<unsigned int, unsigned int> &l : layers) {
+		vertexCount += ls.m_layerBuckets[l.first].m_bufferVertices.size();
+		indexCount += ls.m_layerBuckets[l.first].m_bufferIndices.size();
+	}
+	buffer.m_vertices.clear();
+	buffer.m_indices.clear();
+	buffer.m_layerRanges.clear();
+	buffer.m_vertices.reserve(vertexCount);
+	buffer.m_indices.reserve(indexCount);
+
+	for (const std::pair<unsigned int, unsigned int> &l : layers) {
+		const LinkState::LayerBucket &bucket = ls.m_layerBuckets[l.first];
+
+		LineBufferRange range;
+		range.m_layerIdx = l.first;
+		range.m_firstVertex = (unsigned int)buffer.m_vertices.size();
+		range.m_vertexCount = (unsigned int)bucket.m_bufferVertices.size();
+		range.m_firstIndex = (unsigned int)buffer.m_indices.size();
+		range.m_indexCount = (unsigned int)bucket.m_bufferIndices.size();
+		buffer.m_layerRanges.push_back(range);
+
+		buffer.m_vertices.insert(buffer.m_vertices.end(), bucket.m_bufferVertices.begin(), bucket.m_bufferVertices.end());
+		for (unsigned int idx : bucket.m_bufferIndices)
+			buffer.m_indices.push_back(range.m_firstVertex + idx);
+	}
+
+	ls.m_lineBufferLayers.swap(layers);
+	return buffer;
 }
 
 
-const std::vector<IBKMK::Vector3D> Drawing::points3D(const std::vector<IBKMK::Vector2D> &verts, const AbstractDrawingObject &object) const {
-	std::vector<IBKMK::Vector3D> points3D(verts.size());
-	for (unsigned int i=0; i < verts.size(); ++i) {
-		const IBKMK::Vector2D &v2D = verts[i];
-		points3D[i] = point3D(v2D, object);
+void Drawing::updateLayerLineBuffer(const DrawingLayer &layer, const LinkState::LayerBucket &bucket) const {
+	const LinkState &ls = m_linkState;
+
+	// layer attributes are used by all entities without own color/line weight
+	if (bucket.m_bufferColor != layer.m_color || bucket.m_bufferLineWeight != layer.m_lineWeight) {
+		bucket.resetBuffer();
+		bucket.m_bufferColor = layer.m_color;
+		bucket.m_bufferLineWeight = layer.m_lineWeight;
 	}
 
-	return points3D;
+	if (bucket.m_bufferCount == bucket.m_entities.size() && bucket.m_bufferGeneration != 0)
+		return;
+
+	const unsigned int NO_VERTEX = std::numeric_limits<unsigned int>::max();
+	for (std::size_t i = bucket.m_bufferCount; i < bucket.m_entities.size(); ++i) {
+		const AbstractDrawingObject *obj = objectByRef(bucket.m_entities[i]);
+		// entities of block definitions are drawn by their inserts
+		if (obj->m_block != nullptr)
+			continue;
+
+		const std::vector<LineSegment> &lines = obj->localLineGeometries();
+		if (lines.empty())
+			continue;
+
+		if (!ls.m_lineBufferCentered) {
+			ls.m_lineBuffer.m_center = lines.front().m_p1;
+			ls.m_lineBufferCentered = true;
+		}
+		const IBKMK::Vector3D &center = ls.m_lineBuffer.m_center;
+
+		const QColor &color = obj->color();
+		LineVertex v;
+		v.m_r = (float)color.redF();
+		v.m_g = (float)color.greenF();
+		v.m_b = (float)color.blueF();
+		v.m_lineWeight = (float)(m_lineWeightOffset + obj->lineWeight() * m_lineWeightScaling);
+
+		// consecutive segments of polylines, circles and arcs share their vertex
+		unsigned int lastIdx = NO_VERTEX;
+		IBKMK::Vector3D lastPoint;
+		for (const LineSegment &l : lines) {
+			unsigned int idx1 = lastIdx;
+			if (lastIdx == NO_VERTEX || l.m_p1 != lastPoint) {
+				v.m_x = (float)(l.m_p1.m_x - center.m_x);
+				v.m_y = (float)(l.m_p1.m_y - center.m_y);
+				v.m_z = (float)(l.m_p1.m_z - center.m_z);
+				idx1 = (unsigned int)bucket.m_bufferVertices.size();
+				bucket.m_bufferVertices.push_back(v);
+			}
+			v.m_x = (float)(l.m_p2.m_x - center.m_x);
+			v.m_y = (float)(l.m_p2.m_y - center.m_y);
+			v.m_z = (float)(l.m_p2.m_z - center.m_z);
+			lastIdx = (unsigned int)bucket.m_bufferVertices.size();
+			lastPoint = l.m_p2;
+			bucket.m_bufferVertices.push_back(v);
+
+			bucket.m_bufferIndices.push_back(idx1);
+			bucket.m_bufferIndices.push_back(lastIdx);
+		}
+	}
+	bucket.m_bufferCount = bucket.m_entities.size();
+	bucket.m_bufferGeneration = ++ls.m_lineBufferGeneration;
 }
 
-const IBKMK::Vector3D Drawing::normal() const {
-	return QVector2IBKVector(m_rotationMatrix.toQuaternion() * QVector3D(0,0,1));
+
+void Drawing::composeTransformations() const {
+	// composes all palette entries added since the last call, also updates the drawing placement
+	unsigned int lastIdx = (unsigned int)m_insertTransforms.size() - 1;
+	localTransformationMatrix(lastIdx);
+	transformationMatrix(lastIdx);
 }
 
-const IBKMK::Vector3D Drawing::localX() const {
-	return QVector2IBKVector(m_rotationMatrix.toQuaternion() * QVector3D(1,0,0));
+
+/*! Entity range of a layer bucket, unit of work of the parallel stages. */
+struct EntityChunk {
+	unsigned int	m_bucket;
+	std::size_t		m_first;
+	std::size_t		m_last;
+};
+
+/*! Splits the entity range [first, last) of a bucket into chunks of at most ENTITY_CHUNK_SIZE entities. */
+static void appendEntityChunks(unsigned int bucket, std::size_t first, std::size_t last, std::vector<EntityChunk> &chunks) {
+	for (; first < last; first += ENTITY_CHUNK_SIZE) {
+		EntityChunk chunk;
+		chunk.m_bucket = bucket;
+		chunk.m_first = first;
+		chunk.m_last = std::min<std::size_t>(last, first + ENTITY_CHUNK_SIZE);
+		chunks.push_back(chunk);
+	}
 }
 
-const IBKMK::Vector3D Drawing::localY() const {
-	return QVector2IBKVector(m_rotationMatrix.toQuaternion() * QVector3D(0,1,0));
+/*! Extends the box given by lowerValues and upperValues by v. */
+static void extendBounds(IBKMK::Vector3D &lowerValues, IBKMK::Vector3D &upperValues, const IBKMK::Vector3D &v) {
+	upperValues.m_x = std::max(upperValues.m_x, v.m_x);
+	upperValues.m_y = std::max(upperValues.m_y, v.m_y);
+	upperValues.m_z = std::max(upperValues.m_z, v.m_z);
+
+	lowerValues.m_x = std::min(lowerValues.m_x, v.m_x);
+	lowerValues.m_y = std::min(lowerValues.m_y, v.m_y);
+	lowerValues.m_z = std::min(lowerValues.m_z, v.m_z);
 }
 
-void Drawing::addInstersectionPoints() const {
 
-	// Calculate all line intersections for drawings
-#if defined(_OPENMP)
-#pragma omp parallel for
-#endif
-	for (int i = 0; i < (int)m_lines.size(); ++i) {
-		const IBKMK::Vector2D &l1p1 = m_lines[i].m_point1;
-		const IBKMK::Vector2D &l1p2 = m_lines[i].m_point2;
+void Drawing::updateLayerBounds(const std::vector<unsigned int> &bucketIdxs) const {
+	const IBKMK::Vector3D MAX_VALUES(std::numeric_limits<double>::max(),
+									 std::numeric_limits<double>::max(),
+									 std::numeric_limits<double>::max());
+	const IBKMK::Vector3D LOWEST_VALUES(std::numeric_limits<double>::lowest(),
+										std::numeric_limits<double>::lowest(),
+										std::numeric_limits<double>::lowest());
 
-		double xL1Min = std::min(l1p1.m_x, l1p2.m_x);
-		double xL1Max = std::max(l1p1.m_x, l1p2.m_x);
+	const std::vector<LinkState::LayerBucket> &buckets = m_linkState.m_layerBuckets;
+	std::vector<EntityChunk> chunks;
+	for (unsigned int b : bucketIdxs) {
+		const LinkState::LayerBucket &bucket = buckets[b];
+		if (bucket.m_boundsCount == bucket.m_entities.size())
+			continue;
+		if (bucket.m_boundsCount == 0) {
+			bucket.m_lowerValues = MAX_VALUES;
+			bucket.m_upperValues = LOWEST_VALUES;
+		}
+		appendEntityChunks(b, bucket.m_boundsCount, bucket.m_entities.size(), chunks);
+	}
+	if (chunks.empty())
+		return;
+
+	composeTransformations();
+	std::vector<IBKMK::Vector3D> lowerValues(chunks.size(), MAX_VALUES);
+	std::vector<IBKMK::Vector3D> upperValues(chunks.size(), LOWEST_VALUES);
+	parallelFor(chunks.size(), [&](std::size_t c) {
+		const EntityChunk &chunk = chunks[c];
+		const LinkState::LayerBucket &bucket = buckets[chunk.m_bucket];
+		std::vector<IBKMK::Vector3D> points;
+		for (std::size_t i = chunk.m_first; i < chunk.m_last; ++i) {
+			const AbstractDrawingObject *obj = objectByRef(bucket.m_entities[i]);
+
+			points3D(obj->points2D(), *obj, points);
+			for (const IBKMK::Vector3D &v : points)
+				extendBounds(lowerValues[c], upperValues[c], v);
+		}
+	}, 1);
+
+	for (std::size_t c = 0; c < chunks.size(); ++c) {
+		// chunk without any points
+		if (lowerValues[c].m_x > upperValues[c].m_x)
+			continue;
+		const LinkState::LayerBucket &bucket = buckets[chunks[c].m_bucket];
+		extendBounds(bucket.m_lowerValues, bucket.m_upperValues, lowerValues[c]);
+		extendBounds(bucket.m_lowerValues, bucket.m_upperValues, upperValues[c]);
+	}
+	for (unsigned int b : bucketIdxs)
+		buckets[b].m_boundsCount = buckets[b].m_entities.size();
+}
 
-		double yL1Min = std::min(l1p1.m_y, l1p2.m_y);
-		double yL1Max = std::max(l1p1.m_y, l1p2.m_y);
 
-		for (int j = i; j < (int)m_lines.size(); ++j) {
-			if (j == i)
+void Drawing::removeMergedPickPoints(const LinkState::LayerBucket &bucket) const {
+	if (!bucket.m_picksMerged)
+		return;
+	// ids are unique, hence all points of the layer's objects can be removed per field
+	for (const LinkState::PickPoint &pp : bucket.m_pickPoints) {
+		std::map<Field, std::map<unsigned int, std::vector<IBKMK::Vector3D>>>::iterator it = m_pickPoints.find(pp.m_field);
+		if (it == m_pickPoints.end())
+			continue;
+		it->second.erase(pp.m_id);
+		if (it->second.empty())
+			m_pickPoints.erase(it);
+	}
+	bucket.m_picksMerged = false;
+}
+
+
+void Drawing::updateLayerPickPoints(const std::vector<unsigned int> &bucketIdxs) const {
+	const std::vector<LinkState::LayerBucket> &buckets = m_linkState.m_layerBuckets;
+	std::vector<EntityChunk> chunks;
+	for (unsigned int b : bucketIdxs)
+		appendEntityChunks(b, buckets[b].m_pickCount, buckets[b].m_entities.size(), chunks);
+	if (chunks.empty())
+		return;
+
+	composeTransformations();
+	std::vector<std::vector<LinkState::PickPoint>> pickPoints(chunks.size());
+	parallelFor(chunks.size(), [&](std::size_t c) {
+		const EntityChunk &chunk = chunks[c];
+		const LinkState::LayerBucket &bucket = buckets[chunk.m_bucket];
+		std::vector<IBKMK::Vector3D> points;
+		for (std::size_t i = chunk.m_first; i < chunk.m_last; ++i) {
+			const EntityRef &ref = bucket.m_entities[i];
+			// texts have no pick points
+			if (ref.m_type == OT_Text)
 				continue;
 
-			const IBKMK::Vector2D &l2p1 = m_lines[j].m_point1;
-			const IBKMK::Vector2D &l2p2 = m_lines[j].m_point2;
+			const AbstractDrawingObject *obj = objectByRef(ref);
+			// Skip objects, that are part of a block,
+			// they have already been generated
+			if (obj->m_block != nullptr)
+				continue;
 
-			double xL2Min = std::min(l2p1.m_x, l2p2.m_x);
-			double xL2Max = std::max(l2p1.m_x, l2p2.m_x);
+			bool pickLines = ref.m_type == OT_Line || ref.m_type == OT_PolyLine || ref.m_type == OT_LinearDimension;
+			addPickPoints(*obj, pickLines, points, pickPoints[c]);
+		}
+	}, 1);
 
-			double yL2Min = std::min(l2p1.m_y, l2p2.m_y);
-			double yL2Max = std::max(l2p1.m_y, l2p2.m_y);
+	// chunks of a bucket are consecutive, hence the order of pick points does not depend on the thread count
+	for (std::size_t c = 0; c < chunks.size(); ++c) {
+		std::vector<LinkState::PickPoint> &bucketPoints = buckets[chunks[c].m_bucket].m_pickPoints;
+		bucketPoints.insert(bucketPoints.end(), pickPoints[c].begin(), pickPoints[c].end());
+	}
+	for (unsigned int b : bucketIdxs)
+		buckets[b].m_pickCount = buckets[b].m_entities.size();
+}
 
-			// Check if bounding boxes overlap
-			if (yL1Min <= yL2Max && yL2Min <= yL1Max && xL1Min <= xL2Max && xL2Min <= xL1Max) {
-				// Only proceed with intersection tests if bounding boxes overlap
-				IBK::Line l1 (l1p1, l1p2);
-				IBK::Line l2 (l2p1, l2p2);
 
-				if ((l1p2 - l1p1).magnitudeSquared() < 1 || (l2p2 - l2p1).magnitudeSquared() < 1)
-					continue;
+void Drawing::updateLayerLineGeometries(const std::vector<unsigned int> &bucketIdxs) const {
+	const std::vector<LinkState::LayerBucket> &buckets = m_linkState.m_layerBuckets;
+	std::vector<EntityChunk> chunks;
+	for (unsigned int b : bucketIdxs) {
+		const LinkState::LayerBucket &bucket = buckets[b];
+		const DrawingLayer &layer = m_drawingLayers[b];
+		// buffer data of changed layer attributes is regenerated completely
+		bool attributesChanged = bucket.m_bufferColor != layer.m_color || bucket.m_bufferLineWeight != layer.m_lineWeight;
+		appendEntityChunks(b, attributesChanged ? 0 : bucket.m_bufferCount, bucket.m_entities.size(), chunks);
+	}
+	if (chunks.empty())
+		return;
 
-				IBKMK::Vector2D p1, p2;
-				try {
-					if (l1.intersects(l2, p1, p2) == 1) {
-						IBKMK::Vector3D v1 = point3D(p1, m_lines[i]);
-#if defined(_OPENMP)
-#pragma omp critical
-#endif
-						m_pickPoints[Field(*this, v1)][m_lines[i].m_id].push_back(v1);
+	composeTransformations();
+	// every entity caches its own geometries, shared caches (glyphs, curve templates) are synchronised
+	parallelFor(chunks.size(), [&](std::size_t c) {
+		const EntityChunk &chunk = chunks[c];
+		const LinkState::LayerBucket &bucket = buckets[chunk.m_bucket];
+		for (std::size_t i = chunk.m_first; i < chunk.m_last; ++i) {
+			const AbstractDrawingObject *obj = objectByRef(bucket.m_entities[i]);
+			// entities of block definitions are drawn by their inserts
+			if (obj->m_block == nullptr)
+				obj->localLineGeometries();
+		}
+	}, 1);
+}
 
-					}
-				} catch (...) {
-					continue;
-				}
+
+void Drawing::addPickPoints(const AbstractDrawingObject &obj, bool pickLines, std::vector<IBKMK::Vector3D> &points,
+							std::vector<LinkState::PickPoint> &pickPoints) const
+{
+	// Get 3D-points
+	points3D(obj.points2D(), obj, points);
+
+	LinkState::PickPoint pp;
+	pp.m_id = obj.m_id;
+#define PICK_DRAWING_LINES
+
+#ifdef PICK_DRAWING_LINES
+	if (pickLines) {
+		// Add pick-points
+		std::set<Field> fields;
+		for (unsigned int i=0; i<points.size(); ++i) {
+
+			const IBKMK::Vector3D &v1 = points[ i				  ];
+			const IBKMK::Vector3D &v2 = points[(i+1)%points.size()];
+
+			IBKMK::Vector3D dir = v2 - v1;
+			double length = dir.magnitude();
+
+			unsigned int steps = (int)(length/10.0) + 1;
+
+			for (unsigned int i=0; i < steps; ++i) {
+				IBKMK::Vector3D v3D = v1 + (double)i * 10.0 * dir.normalized();
+				fields.insert(Field(*this, v3D));
 			}
 		}
-	}
 
-	// Calculate all line intersections for drawings
-#if defined(_OPENMP)
-#pragma omp parallel for
+		for (const IBKMK::Vector3D &v3D : points) {
+			pp.m_point = v3D;
+			for (const Field &field : fields) {
+				pp.m_field = field;
+				pickPoints.push_back(pp);
+			}
+		}
+	}
+	else {
+		// Add pick-points
+		for (const IBKMK::Vector3D &v3D : points) {
+			pp.m_field = Field(*this, v3D);
+			pp.m_point = v3D;
+			pickPoints.push_back(pp);
+		}
+	}
+#else
+	// Add pick-points
+	for (const IBKMK::Vector3D &v3D : points) {
+		pp.m_field = Field(*this, v3D);
+		pp.m_point = v3D;
+		pickPoints.push_back(pp);
+	}
 #endif
-	for (int i = 0; i < (int)m_polylines.size(); ++i) {
+}
+
+
+const IBKMK::Vector3D Drawing::point3D(const IBKMK::Vector2D &vert, const AbstractDrawingObject &object) const {
+	// computed in double precision, georeferenced coordinates exceed float precision
+	IBKMK::Vector3D v3D;
+	PointTransformation::transform(transformationMatrix(object.m_transIdx), object.m_zPosition * Z_MULTIPLYER, &vert, 1, &v3D);
+	return v3D;
+}
+
+
+void Drawing::updateTransformations() const {
+	QQuaternion rotation = m_rotationMatrix.toQuaternion();
+	bool placementChanged = m_transformOffset != m_offset || m_transformRotation != rotation;
+	bool scalingChanged = m_transformScalingFactor != m_scalingFactor;
+	if (!placementChanged && !scalingChanged)
+		return;
+
+	m_transforms.clear();
+	if (scalingChanged) {
+		m_localTransforms.clear();
+		m_transformScalingFactor = m_scalingFactor;
+		++m_localGeometryVersion;
+	}
+	if (placementChanged) {
+		m_transformOffset = m_offset;
+		m_transformRotation = rotation;
+		glm::dmat4 identityMatrix(1.0);
+		glm::dmat4 translationMatrix = glm::translate(identityMatrix, glm::dvec3(m_offset.m_x, m_offset.m_y, m_offset.m_z));
+		glm::dmat4 rotationMatrix = glm::toMat4(glm::dquat(m_rotationMatrix.m_wp, m_rotationMatrix.m_x,
+															m_rotationMatrix.m_y, m_rotationMatrix.m_z));
+		m_placement = translationMatrix * rotationMatrix;
+	}
+	// global geometries depend on both
+	++m_globalGeometryVersion;
+}
+
+
+const glm::dmat4 &Drawing::localTransformationMatrix(unsigned int transIdx) const {
+	Q_ASSERT(transIdx < m_insertTransforms.size());
+
+	updateTransformations();
+
+	if (transIdx >= m_localTransforms.size()) {
+		glm::dmat4 scaleMatrix = glm::scale(glm::dmat4(1.0), glm::dvec3(m_scalingFactor, m_scalingFactor, 1.0));
+
+		// compose all palette entries added since the last call
+		for (std::size_t i = m_localTransforms.size(); i < m_insertTransforms.size(); ++i)
+			m_localTransforms.push_back(scaleMatrix * m_insertTransforms[i]);
+	}
+
+	return m_localTransforms[transIdx];
+}
+
+
+const glm::dmat4 &Drawing::placementMatrix() const {
+	updateTransformations();
+	return m_placement;
+}
+
+
+const glm::dmat4 &Drawing::transformationMatrix(unsigned int transIdx) const {
+	Q_ASSERT(transIdx < m_insertTransforms.size());
+
+	updateTransformations();
+
+	if (transIdx >= m_transforms.size()) {
+		// compose all palette entries added since the last call
+		for (std::size_t i = m_transforms.size(); i < m_insertTransforms.size(); ++i)
+			m_transforms.push_back(m_placement * localTransformationMatrix((unsigned int)i));
+	}
+
+	return m_transforms[transIdx];
+}
+
+
+const std::vector<IBKMK::Vector3D> Drawing::points3D(const std::vector<IBKMK::Vector2D> &verts, const AbstractDrawingObject &object) const {
+	std::vector<IBKMK::Vector3D> points;
+	points3D(verts, object, points);
+	return points;
+}
+
+
+void Drawing::points3D(const std::vector<IBKMK::Vector2D> &verts, const AbstractDrawingObject &object,
+					   std::vector<IBKMK::Vector3D> &points3D) const
+{
+	points3D.resize(verts.size());
+	if (verts.empty())
+		return;
+	PointTransformation::transform(transformationMatrix(object.m_transIdx), object.m_zPosition * Z_MULTIPLYER,
+								   verts.data(), verts.size(), points3D.data());
+}
+
+
+const IBKMK::Vector3D Drawing::localPoint3D(const IBKMK::Vector2D &vert, const AbstractDrawingObject &object) const {
+	IBKMK::Vector3D v3D;
+	PointTransformation::transform(localTransformationMatrix(object.m_transIdx), object.m_zPosition * Z_MULTIPLYER, &vert, 1, &v3D);
+	return v3D;
+}
+
+
+void Drawing::localPoints3D(const std::vector<IBKMK::Vector2D> &verts, const AbstractDrawingObject &object,
+							std::vector<IBKMK::Vector3D> &points3D) const
+{
+	points3D.resize(verts.size());
+	if (verts.empty())
+		return;
+	PointTransformation::transform(localTransformationMatrix(object.m_transIdx), object.m_zPosition * Z_MULTIPLYER,
+								   verts.data(), verts.size(), points3D.data());
+}
+
+const IBKMK::Vector3D Drawing::normal() const {
+	return QVector2IBKVector(m_rotationMatrix.toQuaternion() * QVector3D(0,0,1));
+}
+
+const IBKMK::Vector3D Drawing::localX() const {
+	return QVector2IBKVector(m_rotationMatrix.toQuaternion() * QVector3D(1,0,0));
+}
+
+const IBKMK::Vector3D Drawing::localY() const {
+	return QVector2IBKVector(m_rotationMatrix.toQuaternion() * QVector3D(0,1,0));
+}
+
+void Drawing::addInstersectionPoints() const {
+	if (m_linkState.m_intersectionsValid && m_linkState.m_intersectionCounts[0] == m_lines.size() &&
+		m_linkState.m_intersectionCounts[1] == m_polylines.size())
+	{
+		return;
+	}
 
-		for (unsigned int k = 0; k < m_polylines[i].m_polyline.size(); ++k) {
+	// compose transformation palette before the parallel loops
+	composeTransformations();
 
-			const IBKMK::Vector2D &l1p1 = m_polylines[i].m_polyline[ k										  ];
-			const IBKMK::Vector2D &l1p2 = m_polylines[i].m_polyline[(k + 1) % m_polylines[i].m_polyline.size()];
+	// every chunk of (poly)lines emits its intersection points with the layer index into its own list,
+	// lists are appended to the layers afterwards
+	std::size_t lineChunks = (m_lines.size() + ENTITY_CHUNK_SIZE - 1) / ENTITY_CHUNK_SIZE;
+	std::size_t polylineChunks = (m_polylines.size() + ENTITY_CHUNK_SIZE - 1) / ENTITY_CHUNK_SIZE;
+	std::vector<std::vector<std::pair<unsigned int, LinkState::PickPoint>>> pickPoints(lineChunks + polylineChunks);
+
+	// Calculate all line intersections for drawings
+	parallelFor(lineChunks, [&](std::size_t c) {
+		std::size_t last = std::min<std::size_t>(m_lines.size(), (c + 1) * ENTITY_CHUNK_SIZE);
+		for (std::size_t i = c * ENTITY_CHUNK_SIZE; i < last; ++i) {
+			const IBKMK::Vector2D &l1p1 = m_lines[i].m_point1;
+			const IBKMK::Vector2D &l1p2 = m_lines[i].m_point2;
 
 			double xL1Min = std::min(l1p1.m_x, l1p2.m_x);
 			double xL1Max = std::max(l1p1.m_x, l1p2.m_x);
@@ -1782,48 +2944,113 @@ void Drawing::addInstersectionPoints() const {
 			double yL1Min = std::min(l1p1.m_y, l1p2.m_y);
 			double yL1Max = std::max(l1p1.m_y, l1p2.m_y);
 
-			for (int j = i; j < (int)m_polylines.size(); ++j) {
-				if (j == i)
-					continue;
+			for (std::size_t j = i + 1; j < m_lines.size(); ++j) {
+				const IBKMK::Vector2D &l2p1 = m_lines[j].m_point1;
+				const IBKMK::Vector2D &l2p2 = m_lines[j].m_point2;
+
+				double xL2Min = std::min(l2p1.m_x, l2p2.m_x);
+				double xL2Max = std::max(l2p1.m_x, l2p2.m_x);
+
+				double yL2Min = std::min(l2p1.m_y, l2p2.m_y);
+				double yL2Max = std::max(l2p1.m_y, l2p2.m_y);
+
+				// Check if bounding boxes overlap
+				if (yL1Min <= yL2Max && yL2Min <= yL1Max && xL1Min <= xL2Max && xL2Min <= xL1Max) {
+					// Only proceed with intersection tests if bounding boxes overlap
+					IBK::Line l1 (l1p1, l1p2);
+					IBK::Line l2 (l2p1, l2p2);
+
+					if ((l1p2 - l1p1).magnitudeSquared() < 1 || (l2p2 - l2p1).magnitudeSquared() < 1)
+						continue;
+
+					IBKMK::Vector2D p1, p2;
+					try {
+						if (l1.intersects(l2, p1, p2) == 1) {
+							LinkState::PickPoint pp;
+							pp.m_point = point3D(p1, m_lines[i]);
+							pp.m_field = Field(*this, pp.m_point);
+							pp.m_id = m_lines[i].m_id;
+							pickPoints[c].push_back(std::make_pair((unsigned int)(m_lines[i].m_layerRef - m_drawingLayers.data()), pp));
+						}
+					} catch (...) {
+						continue;
+					}
+				}
+			}
+		}
+	}, 1);
 
-				for (unsigned int l = 0; l < m_polylines[j].m_polyline.size(); ++l) {
+	// Calculate all polyline intersections for drawings
+	parallelFor(polylineChunks, [&](std::size_t c) {
+		std::size_t last = std::min<std::size_t>(m_polylines.size(), (c + 1) * ENTITY_CHUNK_SIZE);
+		for (std::size_t i = c * ENTITY_CHUNK_SIZE; i < last; ++i) {
 
-					const IBKMK::Vector2D &l2p1 = m_polylines[j].m_polyline[ l										  ];
-					const IBKMK::Vector2D &l2p2 = m_polylines[j].m_polyline[(l + 1) % m_polylines[j].m_polyline.size()];
+			for (unsigned int k = 0; k < m_polylines[i].m_polyline.size(); ++k) {
 
-					double xL2Min = std::min(l2p1.m_x, l2p2.m_x);
-					double xL2Max = std::max(l2p1.m_x, l2p2.m_x);
+				const IBKMK::Vector2D &l1p1 = m_polylines[i].m_polyline[ k										  ];
+				const IBKMK::Vector2D &l1p2 = m_polylines[i].m_polyline[(k + 1) % m_polylines[i].m_polyline.size()];
 
-					double yL2Min = std::min(l2p1.m_y, l2p2.m_y);
-					double yL2Max = std::max(l2p1.m_y, l2p2.m_y);
+				double xL1Min = std::min(l1p1.m_x, l1p2.m_x);
+				double xL1Max = std::max(l1p1.m_x, l1p2.m_x);
 
-					// Check if bounding boxes overlap
-					if (yL1Min <= yL2Max && yL2Min <= yL1Max && xL1Min <= xL2Max && xL2Min <= xL1Max) {
-						// Only proceed with intersection tests if bounding boxes overlap
-						IBK::Line l1 (l1p1, l1p2);
-						IBK::Line l2 (l2p1, l2p2);
+				double yL1Min = std::min(l1p1.m_y, l1p2.m_y);
+				double yL1Max = std::max(l1p1.m_y, l1p2.m_y);
 
-						if ((l1p2 - l1p1).magnitudeSquared() < 1 || (l2p2 - l2p1).magnitudeSquared() < 1)
-							continue;
+				for (std::size_t j = i + 1; j < m_polylines.size(); ++j) {
 
-						IBKMK::Vector2D p1, p2;
-						try {
-							if (l1.intersects(l2, p1, p2) == 1) {
-								IBKMK::Vector3D v1 = point3D(p1, m_lines[i]);
-#if defined(_OPENMP)
-#pragma omp critical
-#endif
-								m_pickPoints[Field(*this, v1)][m_lines[i].m_id].push_back(v1);
+					for (unsigned int l = 0; l < m_polylines[j].m_polyline.size(); ++l) {
 
+						const IBKMK::Vector2D &l2p1 = m_polylines[j].m_polyline[ l										  ];
+						const IBKMK::Vector2D &l2p2 = m_polylines[j].m_polyline[(l + 1) % m_polylines[j].m_polyline.size()];
+
+						double xL2Min = std::min(l2p1.m_x, l2p2.m_x);
+						double xL2Max = std::max(l2p1.m_x, l2p2.m_x);
+
+						double yL2Min = std::min(l2p1.m_y, l2p2.m_y);
+						double yL2Max = std::max(l2p1.m_y, l2p2.m_y);
+
+						// Check if bounding boxes overlap
+						if (yL1Min <= yL2Max && yL2Min <= yL1Max && xL1Min <= xL2Max && xL2Min <= xL1Max) {
+							// Only proceed with intersection tests if bounding boxes overlap
+							IBK::Line l1 (l1p1, l1p2);
+							IBK::Line l2 (l2p1, l2p2);
+
+							if ((l1p2 - l1p1).magnitudeSquared() < 1 || (l2p2 - l2p1).magnitudeSquared() < 1)
+								continue;
+
+							IBKMK::Vector2D p1, p2;
+							try {
+								if (l1.intersects(l2, p1, p2) == 1) {
+									LinkState::PickPoint pp;
+									pp.m_point = point3D(p1, m_polylines[i]);
+									pp.m_field = Field(*this, pp.m_point);
+									pp.m_id = m_polylines[i].m_id;
+									pickPoints[lineChunks + c].push_back(std::make_pair(
+											(unsigned int)(m_polylines[i].m_layerRef - m_drawingLayers.data()), pp));
+								}
+							} catch (...) {
+								continue;
 							}
-						} catch (...) {
-							continue;
 						}
 					}
 				}
 			}
 		}
+	}, 1);
+
+	// chunks are appended in order, hence the order of the points does not depend on the thread count
+	const std::vector<LinkState::LayerBucket> &buckets = m_linkState.m_layerBuckets;
+	for (const LinkState::LayerBucket &bucket : buckets)
+		bucket.m_intersectionPoints.clear();
+	for (const std::vector<std::pair<unsigned int, LinkState::PickPoint>> &chunkPoints : pickPoints) {
+		for (const std::pair<unsigned int, LinkState::PickPoint> &pp : chunkPoints)
+			buckets[pp.first].m_intersectionPoints.push_back(pp.second);
 	}
+
+	m_linkState.m_intersectionsValid = true;
+	m_linkState.m_intersectionCounts[0] = m_lines.size();
+	m_linkState.m_intersectionCounts[1] = m_polylines.size();
+	m_dirtyPickPointIndex = true;
 }
 
 
@@ -1858,8 +3085,48 @@ bool isClockwise(const QPolygonF& polygon) {
 void Drawing::generateLinesFromText(const std::string &text, double textHeight, Qt::Alignment alignment,
 									const double &rotationAngle, const IBKMK::Vector2D &basePoint, const AbstractDrawingObject &object,
 									std::vector<LineSegment> &lineGeometries) const {
+	std::vector<const GlyphOutlines::Glyph*> glyphs;
+	double width = GlyphOutlines::glyphRun(TEXT_FONT_FAMILY, QString::fromStdString(text), glyphs);
+
+	double pen = 0;
+	if (alignment & Qt::AlignHCenter)
+		pen = -0.5 * width;
+	else if (alignment & Qt::AlignRight)
+		pen = -width;
+
+	// glyphs are normalised to cap height 1
+	double cs = textHeight * std::cos(-rotationAngle * IBK::DEG2RAD);
+	double sn = textHeight * std::sin(-rotationAngle * IBK::DEG2RAD);
 
-	return;
+	std::size_t pointCount = 0;
+	for (const GlyphOutlines::Glyph *g : glyphs)
+		pointCount += g->m_points.size();
+
+	std::vector<IBKMK::Vector2D> points;
+	points.reserve(pointCount);
+	for (const GlyphOutlines::Glyph *g : glyphs) {
+		for (const IBKMK::Vector2D &p : g->m_points) {
+			double x = pen + p.m_x;
+			double y = p.m_y;
+			points.push_back(IBKMK::Vector2D(basePoint.m_x + x * cs - y * sn, basePoint.m_y + x * sn + y * cs));
+		}
+		pen += g->m_advance;
+	}
+
+	std::vector<IBKMK::Vector3D> points3D;
+	localPoints3D(points, object, points3D);
+
+	lineGeometries.reserve(lineGeometries.size() + pointCount);
+	unsigned int offset = 0;
+	for (const GlyphOutlines::Glyph *g : glyphs) {
+		for (unsigned int i = 0; i + 1 < g->m_polygonOffsets.size(); ++i) {
+			unsigned int first = offset + g->m_polygonOffsets[i];
+			unsigned int last = offset + g->m_polygonOffsets[i+1];
+			for (unsigned int j = first; j < last; ++j)
+				lineGeometries.push_back(LineSegment(points3D[j], points3D[j + 1 < last ? j + 1 : first]));
+		}
+		offset += (unsigned int)g->m_points.size();
+	}
 }
 
 bool Drawing::dirtyPickPoints() const {
@@ -1899,42 +3166,32 @@ double Drawing::AbstractDrawingObject::lineWeight() const{
 }
 
 const glm::dmat4 &Drawing::AbstractDrawingObject::transformationMatrix() const {
-	if (m_dirtyGlobalPoints) {
-		Q_ASSERT(m_parent != nullptr);
-		double zCoordinate = m_zPosition * Z_MULTIPLYER;
-
-		// Convert QMatrix4x4 to glm::mat4
-		glm::dmat4 insertMatrix;
-		const float *data = m_trans.constData();
-		for (int i = 0; i < 16; ++i) {
-			insertMatrix[i / 4][i % 4] = data[i];
-		}
-
-		// Vektoren für Transformationen definieren
-		glm::dvec3 translationVector(m_parent->m_offset.m_x, m_parent->m_offset.m_y, m_parent->m_offset.m_z); // Translation um 1 Einheit auf x, 2 auf y, 3 auf z
-		translationVector += glm::dvec3(0,0,zCoordinate);
-		glm::dvec3 scaleVector(m_parent->m_scalingFactor, m_parent->m_scalingFactor, 1.0);			// Skalierung um Faktor 2 in alle Richtungen
+	Q_ASSERT(m_parent != nullptr);
+	return m_parent->transformationMatrix(m_transIdx);
+}
 
-		// Winkel für die Rotation
-		// Create a GLM quaternion
-		glm::quat glmQuat((float)m_parent->m_rotationMatrix.m_wp,
-						  (float)m_parent->m_rotationMatrix.m_x,
-						  (float)m_parent->m_rotationMatrix.m_y,
-						  (float)m_parent->m_rotationMatrix.m_z);
 
-		// Convert GLM quaternion to a rotation matrix
-		glm::dmat4 rotationMatrix = glm::toMat4(glmQuat);
+const std::vector<Drawing::LineSegment> &Drawing::AbstractDrawingObject::lineGeometries() const {
+	Q_ASSERT(m_parent != nullptr);
 
-		// Erzeugung der einzelnen Transformationsmatrizen
-		glm::dmat4 identityMatrix = glm::mat4(1.0f); // Einheitsmatrix
-		glm::dmat4 translationMatrix = glm::translate(identityMatrix, translationVector);
-		glm::dmat4 scaleMatrix = glm::scale(identityMatrix, scaleVector);
+	// regenerates local geometries if needed, this resets the global version
+	const std::vector<LineSegment> &localLines = localLineGeometries();
 
-		// Kombinieren der Transformationen
-		m_transformationMatrix = translationMatrix * rotationMatrix * scaleMatrix * insertMatrix;
+	const glm::dmat4 &placement = m_parent->placementMatrix();
+	if (m_globalGeometryVersion != m_parent->m_globalGeometryVersion) {
+		m_globalLineGeometries.resize(localLines.size());
+		for (std::size_t i = 0; i < localLines.size(); ++i) {
+			const LineSegment &l = localLines[i];
+			LineSegment &g = m_globalLineGeometries[i];
+			glm::dvec4 p1 = placement * glm::dvec4(l.m_p1.m_x, l.m_p1.m_y, l.m_p1.m_z, 1.0);
+			glm::dvec4 p2 = placement * glm::dvec4(l.m_p2.m_x, l.m_p2.m_y, l.m_p2.m_z, 1.0);
+			g.m_p1 = IBKMK::Vector3D(p1.x, p1.y, p1.z);
+			g.m_p2 = IBKMK::Vector3D(p2.x, p2.y, p2.z);
+		}
+		m_globalGeometryVersion = m_parent->m_globalGeometryVersion;
 	}
 
-	return m_transformationMatrix;
+	return m_globalLineGeometries;
 }
 
 
@@ -2228,7 +3485,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					Drawing::Block obj;
 					obj.readXML(c2);
-					m_blocks.push_back(obj);
+					m_blocks.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2240,7 +3497,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					DrawingLayer obj;
 					obj.readXML(c2);
-					m_drawingLayers.push_back(obj);
+					m_drawingLayers.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2252,7 +3509,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					Point obj;
 					obj.readXML(c2);
-					m_points.push_back(obj);
+					m_points.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2264,7 +3521,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					Line obj;
 					obj.readXML(c2);
-					m_lines.push_back(obj);
+					m_lines.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2276,7 +3533,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					PolyLine obj;
 					obj.readXML(c2);
-					m_polylines.push_back(obj);
+					m_polylines.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2288,7 +3545,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					Circle obj;
 					obj.readXML(c2);
-					m_circles.push_back(obj);
+					m_circles.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2300,7 +3557,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					Ellipse obj;
 					obj.readXML(c2);
-					m_ellipses.push_back(obj);
+					m_ellipses.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2312,7 +3569,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					Arc obj;
 					obj.readXML(c2);
-					m_arcs.push_back(obj);
+					m_arcs.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2324,7 +3581,31 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					Solid obj;
 					obj.readXML(c2);
-					m_solids.push_back(obj);
+					m_solids.push_back(std::move(obj));
+					c2 = c2->NextSiblingElement();
+				}
+			}
+			else if (cName == "Hatches") {
+				const TiXmlElement * c2 = c->FirstChildElement();
+				while (c2) {
+					const std::string & c2Name = c2->ValueStr();
+					if (c2Name != "Hatch")
+						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+					Hatch obj;
+					obj.readXML(c2);
+					m_hatches.push_back(std::move(obj));
+					c2 = c2->NextSiblingElement();
+				}
+			}
+			else if (cName == "Splines") {
+				const TiXmlElement * c2 = c->FirstChildElement();
+				while (c2) {
+					const std::string & c2Name = c2->ValueStr();
+					if (c2Name != "Spline")
+						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+					Spline obj;
+					obj.readXML(c2);
+					m_splines.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2336,7 +3617,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					Text obj;
 					obj.readXML(c2);
-					m_texts.push_back(obj);
+					m_texts.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2348,7 +3629,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					LinearDimension obj;
 					obj.readXML(c2);
-					m_linearDimensions.push_back(obj);
+					m_linearDimensions.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2360,7 +3641,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					DimStyle obj;
 					obj.readXML(c2);
-					m_dimensionStyles.push_back(obj);
+					m_dimensionStyles.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2372,7 +3653,7 @@ void Drawing::readXML(const TiXmlElement * element) {
 						IBK::IBK_Message(IBK::FormatString(XML_READ_UNKNOWN_ELEMENT).arg(c2Name).arg(c2->Row()), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 					Insert obj;
 					obj.readXML(c2);
-					m_inserts.push_back(obj);
+					m_inserts.push_back(std::move(obj));
 					c2 = c2->NextSiblingElement();
 				}
 			}
@@ -2418,7 +3699,7 @@ TiXmlElement * Drawing::writeXML(TiXmlElement * parent) const {
 		TiXmlElement * child = new TiXmlElement("Blocks");
 		e->LinkEndChild(child);
 
-		for (std::vector<Drawing::Block>::const_iterator it = m_blocks.begin();
+		for (ChunkedVector<Drawing::Block>::const_iterator it = m_blocks.begin();
 			 it != m_blocks.end(); ++it)
 		{
 			it->writeXML(child);
@@ -2440,7 +3721,7 @@ TiXmlElement * Drawing::writeXML(TiXmlElement * parent) const {
 		TiXmlElement * child = new TiXmlElement("Points");
 		e->LinkEndChild(child);
 
-		for (std::vector<Point>::const_iterator it = m_points.begin();
+		for (ChunkedVector<Point>::const_iterator it = m_points.begin();
 			 it != m_points.end(); ++it)
 		{
 			it->writeXML(child);
@@ -2451,7 +3732,7 @@ TiXmlElement * Drawing::writeXML(TiXmlElement * parent) const {
 		TiXmlElement * child = new TiXmlElement("Lines");
 		e->LinkEndChild(child);
 
-		for (std::vector<Line>::const_iterator it = m_lines.begin();
+		for (ChunkedVector<Line>::const_iterator it = m_lines.begin();
 			 it != m_lines.end(); ++it)
 		{
 			it->writeXML(child);
@@ -2462,7 +3743,7 @@ TiXmlElement * Drawing::writeXML(TiXmlElement * parent) const {
 		TiXmlElement * child = new TiXmlElement("Polylines");
 		e->LinkEndChild(child);
 
-		for (std::vector<PolyLine>::const_iterator it = m_polylines.begin();
+		for (ChunkedVector<PolyLine>::const_iterator it = m_polylines.begin();
 			 it != m_polylines.end(); ++it)
 		{
 			it->writeXML(child);
@@ -2473,7 +3754,7 @@ TiXmlElement * Drawing::writeXML(TiXmlElement * parent) const {
 		TiXmlElement * child = new TiXmlElement("Circles");
 		e->LinkEndChild(child);
 
-		for (std::vector<Circle>::const_iterator it = m_circles.begin();
+		for (ChunkedVector<Circle>::const_iterator it = m_circles.begin();
 			 it != m_circles.end(); ++it)
 		{
 			it->writeXML(child);
@@ -2484,7 +3765,7 @@ TiXmlElement * Drawing::writeXML(TiXmlElement * parent) const {
 		TiXmlElement * child = new TiXmlElement("Ellipses");
 		e->LinkEndChild(child);
 
-		for (std::vector<Ellipse>::const_iterator it = m_ellipses.begin();
+		for (ChunkedVector<Ellipse>::const_iterator it = m_ellipses.begin();
 			 it != m_ellipses.end(); ++it)
 		{
 			it->writeXML(child);
@@ -2495,7 +3776,7 @@ TiXmlElement * Drawing::writeXML(TiXmlElement * parent) const {
 		TiXmlElement * child = new TiXmlElement("Arcs");
 		e->LinkEndChild(child);
 
-		for (std::vector<Arc>::const_iterator it = m_arcs.begin();
+		for (ChunkedVector<Arc>::const_iterator it = m_arcs.begin();
 			 it != m_arcs.end(); ++it)
 		{
 			it->writeXML(child);
@@ -2506,18 +3787,40 @@ TiXmlElement * Drawing::writeXML(TiXmlElement * parent) const {
 		TiXmlElement * child = new TiXmlElement("Solids");
 		e->LinkEndChild(child);
 
-		for (std::vector<Solid>::const_iterator it = m_solids.begin();
+		for (ChunkedVector<Solid>::const_iterator it = m_solids.begin();
 			 it != m_solids.end(); ++it)
 		{
 			it->writeXML(child);
 		}
 	}
 
+	if (!m_hatches.empty()) {
+		TiXmlElement * child = new TiXmlElement("Hatches");
+		e->LinkEndChild(child);
+
+		for (ChunkedVector<Hatch>::const_iterator it = m_hatches.begin();
+			 it != m_hatches.end(); ++it)
+		{
+			it->writeXML(child);
+		}
+	}
+
+	if (!m_splines.empty()) {
+		TiXmlElement * child = new TiXmlElement("Splines");
+		e->LinkEndChild(child);
+
+		for (ChunkedVector<Spline>::const_iterator it = m_splines.begin();
+			 it != m_splines.end(); ++it)
+		{
+			it->writeXML(child);
+		}
+	}
+
 	if (!m_texts.empty()) {
 		TiXmlElement * child = new TiXmlElement("Texts");
 		e->LinkEndChild(child);
 
-		for (std::vector<Text>::const_iterator it = m_texts.begin();
+		for (ChunkedVector<Text>::const_iterator it = m_texts.begin();
 			 it != m_texts.end(); ++it)
 		{
 			it->writeXML(child);
@@ -2528,7 +3831,7 @@ TiXmlElement * Drawing::writeXML(TiXmlElement * parent) const {
 		TiXmlElement * child = new TiXmlElement("LinearDimensions");
 		e->LinkEndChild(child);
 
-		for (std::vector<LinearDimension>::const_iterator it = m_linearDimensions.begin();
+		for (ChunkedVector<LinearDimension>::const_iterator it = m_linearDimensions.begin();
 			 it != m_linearDimensions.end(); ++it)
 		{
 			it->writeXML(child);
@@ -2551,7 +3854,7 @@ TiXmlElement * Drawing::writeXML(TiXmlElement * parent) const {
 		TiXmlElement * child = new TiXmlElement("Inserts");
 		e->LinkEndChild(child);
 
-		for (std::vector<Insert>::const_iterator it = m_inserts.begin();
+		for (ChunkedVector<Insert>::const_iterator it = m_inserts.begin();
 			 it != m_inserts.end(); ++it)
 		{
 			it->writeXML(child);
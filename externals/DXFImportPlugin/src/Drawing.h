@@ -10,12 +10,16 @@
 #include "RotationMatrix.h"
 #include "Object.h"
 #include "DrawingLayer.h"
+#include "ChunkedVector.h"
+#include "PolylineSimplification.h"
+#include "LineDeduplication.h"
 
 #include <QQuaternion>
-#include <QMatrix4x4>
 #include <QColor>
 #include <QDebug>
 
+#include <algorithm>
+
 #include <libdxfrw.h>
 
 #include <drw_interface.h>
@@ -82,6 +86,93 @@ public:
 		return "Drawing";
 	}
 
+	/*! Entity types, also used to index the entity collections in updatePointer(). */
+	enum ObjectType {
+		OT_Point,
+		OT_Line,
+		OT_PolyLine,
+		OT_Circle,
+		OT_Ellipse,
+		OT_Arc,
+		OT_Solid,
+		OT_Text,
+		OT_LinearDimension,
+		OT_Hatch,
+		OT_Spline,
+		OT_Insert,
+		NUM_OT
+	};
+
+	/*! Reference to an entity by type and index in the according entity collection. */
+	struct EntityRef {
+		ObjectType		m_type;
+		unsigned int	m_idx;
+	};
+
+	/*! Pick points of all visible layers in compressed sparse row layout. m_fields is sorted, the pick points
+		of m_fields[i] are m_entries[m_offsets[i]] ... m_entries[m_offsets[i+1] - 1] in layer and entity order.
+	*/
+	struct PickPointIndex {
+		/*! Pick point of a drawing object. */
+		struct Entry {
+			unsigned int		m_id;
+			IBKMK::Vector3D		m_point;
+		};
+
+		/*! Returns the index of field in m_fields, or m_fields.size() if the field has no pick points. */
+		std::size_t find(const Field &field) const {
+			std::vector<Field>::const_iterator it = std::lower_bound(m_fields.begin(), m_fields.end(), field);
+			if (it == m_fields.end() || !(*it == field))
+				return m_fields.size();
+			return (std::size_t)(it - m_fields.begin());
+		}
+
+		std::vector<Field>			m_fields;
+		/*! Offsets into m_entries, one more than fields. */
+		std::vector<std::size_t>	m_offsets;
+		std::vector<Entry>			m_entries;
+	};
+
+	/*! Vertex of the line buffer: position relative to LineBuffer::m_center, color and line weight.
+		Tightly packed single precision data, can be uploaded as interleaved vertex buffer.
+	*/
+	struct LineVertex {
+		float			m_x;
+		float			m_y;
+		float			m_z;
+		float			m_r;
+		float			m_g;
+		float			m_b;
+		/*! Line weight incl. drawing line weight scaling and offset. */
+		float			m_lineWeight;
+	};
+
+	/*! Vertices and indices of one layer in the line buffer. */
+	struct LineBufferRange {
+		/*! Index of the layer in m_drawingLayers. */
+		unsigned int	m_layerIdx;
+		unsigned int	m_firstVertex;
+		unsigned int	m_vertexCount;
+		unsigned int	m_firstIndex;
+		unsigned int	m_indexCount;
+	};
+
+	/*! Line geometries of all visible layers as one contiguous vertex/index buffer (GL_LINES).
+		Positions are local drawing coordinates relative to m_center, hence float precision is
+		sufficient also for georeferenced drawings. Model matrix for rendering is
+		placementMatrix() * translation(m_center).
+	*/
+	struct LineBuffer {
+		/*! Origin of all vertex positions in local drawing coordinates. */
+		IBKMK::Vector3D					m_center;
+		std::vector<LineVertex>			m_vertices;
+		/*! Two indexes per line segment, absolute indexes into m_vertices. */
+		std::vector<unsigned int>		m_indices;
+		/*! Ranges of all visible layers in the buffer, in order of m_drawingLayers. */
+		std::vector<LineBufferRange>	m_layerRanges;
+	};
+
+
 	// *** PUBLIC MEMBER FUNCTIONS ***
 
 	Drawing();
@@ -143,6 +234,14 @@ public:
 	struct AbstractDrawingObject {
 		/*! Standard C'tor. */
 		AbstractDrawingObject() = default;
+		/*! Copy and move operations are defaulted explicitly, because the virtual d'tor
+			would otherwise suppress the implicit move operations and every growth of the
+			entity vectors would copy all elements.
+		*/
+		AbstractDrawingObject(const AbstractDrawingObject &) = default;
+		AbstractDrawingObject(AbstractDrawingObject &&) = default;
+		AbstractDrawingObject & operator=(const AbstractDrawingObject &) = default;
+		AbstractDrawingObject & operator=(AbstractDrawingObject &&) = default;
 
 		/*! D'tor. */
 		virtual ~AbstractDrawingObject() {}
@@ -185,7 +284,17 @@ public:
 			Point will be recalculated when m_dirty is true;
 		*/
 		virtual const std::vector<IBKMK::Vector2D>& points2D() const = 0 ;
-		virtual const std::vector<LineSegment>& lineGeometries() const = 0;
+
+		/*! Line geometries in local drawing coordinates: scaled and insert transformed, but without drawing
+			offset and rotation. Only regenerated when the entity or the drawing scaling factor changes.
+			Renderers can draw these directly with Drawing::placementMatrix() as model matrix.
+		*/
+		virtual const std::vector<LineSegment>& localLineGeometries() const = 0;
+
+		/*! Line geometries in global coordinates, derived from localLineGeometries() by applying the
+			drawing placement. Moving or rotating the drawing only redoes this affine transformation.
+		*/
+		const std::vector<LineSegment>& lineGeometries() const;
 
 		/* used to get correct color of entity */
 		const QColor &color() const;
@@ -193,7 +302,13 @@ public:
 		double lineWeight() const;
 		/*! Indicates when triangulation has to be redone. */
 		void updatePlaneGeometry() {
-			m_dirtyGlobalPoints = true;
+			m_dirtyLineGeometries = true;
+		}
+
+		/*! Indicates that the entity data has been modified, points and line geometries have to be regenerated. */
+		void updatePoints() {
+			m_dirtyLocalPoints = true;
+			m_dirtyLineGeometries = true;
 		}
 
 		/*! Get parent drawing where object is included. */
@@ -205,7 +320,9 @@ public:
 			return drawing;
 		}
 
-		/*! Returns the current transformation matrix. */
+		/*! Returns the current transformation matrix (insert transformation composed with drawing transformation).
+			The z-offset of the entity is not included, see Drawing::point3D().
+		*/
 		const glm::dmat4& transformationMatrix() const;
 
 		/*! Parent drawing. */
@@ -227,8 +344,8 @@ public:
 		const Block									*m_block = nullptr;
 		/*! ID of object. */
 		unsigned int								m_id;
-		/*! Transformation matrix. */
-		QMatrix4x4									m_trans = QMatrix4x4();
+		/*! Index of insert transformation in the transformation palette of the drawing, 0 is identity. */
+		unsigned int								m_transIdx = 0;
 		/*! Defines wether this is a run-time only generated object defined
 			by a block and according insert. If true the object shall not be written.
 		*/
@@ -237,16 +354,30 @@ public:
 	protected:
 		/*! Flag to indictate recalculation of points. */
 		mutable bool								m_dirtyLocalPoints = true;
-		/*! Flag to indictate recalculation of global 3D Points. */
-		mutable bool								m_dirtyGlobalPoints = true;
+		/*! Flag to indictate recalculation of local line geometries. */
+		mutable bool								m_dirtyLineGeometries = true;
+		/*! Drawing geometry versions the line geometries were generated with. */
+		mutable unsigned int						m_localGeometryVersion = 0;
+		mutable unsigned int						m_globalGeometryVersion = 0;
 		/*! Points of objects. */
 		mutable std::vector<IBKMK::Vector2D>		m_pickPoints;
 		/*! Plane Geometries with all triangulated data.
 		*/
 		mutable std::vector<LineSegment>			m_lineGeometries;
+		/*! Line geometries in global coordinates, see lineGeometries(). */
+		mutable std::vector<LineSegment>			m_globalLineGeometries;
+
+		/*! Returns true, if local line geometries have to be regenerated. */
+		bool localGeometryDirty() const {
+			return m_dirtyLineGeometries || m_localGeometryVersion != m_parent->m_localGeometryVersion;
+		}
 
-		/*! Transformation matrix, needed for calculating 3D-points. */
-		mutable glm::dmat4							m_transformationMatrix;
+		/*! Marks local line geometries as up to date, global line geometries are derived again. */
+		void localGeometryUpdated() const {
+			m_dirtyLineGeometries = false;
+			m_localGeometryVersion = m_parent->m_localGeometryVersion;
+			m_globalGeometryVersion = 0;
+		}
 	};
 
 
@@ -308,7 +439,7 @@ public:
 		/*! Calculate Plane geometries if m_dirtyTriangulation is true and/or returns them.
 			Drawing is only needed when m_dirtyTriangulation is true
 		*/
-		const std::vector<LineSegment>& lineGeometries() const override;
+		const std::vector<LineSegment>& localLineGeometries() const override;
 
 		/*! Point coordinate */
 		IBKMK::Vector2D					m_point;
@@ -327,7 +458,7 @@ public:
 		/*! Calculate Plane geometries if m_dirtyTriangulation is true and/or returns them.
 			Drawing is only needed when m_dirtyTriangulation is true
 		*/
-		const std::vector<LineSegment>& lineGeometries() const override;
+		const std::vector<LineSegment>& localLineGeometries() const override;
 
 		/*! Point coordinate */
 		IBKMK::Vector2D					m_point1;
@@ -347,7 +478,7 @@ public:
 		/*! Calculate Plane geometries if m_dirtyTriangulation is true and/or returns them.
 			Drawing is only needed when m_dirtyTriangulation is true
 		*/
-		const std::vector<LineSegment>& lineGeometries() const override;
+		const std::vector<LineSegment>& localLineGeometries() const override;
 
 		/*! polyline coordinates */
 		std::vector<IBKMK::Vector2D>    m_polyline;
@@ -366,7 +497,7 @@ public:
 		/*! Calculate Plane geometries if m_dirtyTriangulation is true and/or returns them.
 			Drawing is only needed when m_dirtyTriangulation is true
 		*/
-		const std::vector<LineSegment>& lineGeometries() const override;
+		const std::vector<LineSegment>& localLineGeometries() const override;
 
 		/*! Circle center */
 		IBKMK::Vector2D					m_center;
@@ -385,7 +516,7 @@ public:
 		/*! Calculate Plane geometries if m_dirtyTriangulation is true and/or returns them.
 			Drawing is only needed when m_dirtyTriangulation is true
 		*/
-		const std::vector<LineSegment>& lineGeometries() const override;
+		const std::vector<LineSegment>& localLineGeometries() const override;
 
 		/*! Ellipse center */
 		IBKMK::Vector2D			m_center;
@@ -410,7 +541,7 @@ public:
 		/*! Calculate Plane geometries if m_dirtyTriangulation is true and/or returns them.
 			Drawing is only needed when m_dirtyTriangulation is true
 		*/
-		const std::vector<LineSegment>& lineGeometries() const override;
+		const std::vector<LineSegment>& localLineGeometries() const override;
 
 		/*! Arc center */
 		IBKMK::Vector2D			m_center;
@@ -433,7 +564,7 @@ public:
 		/*! Calculate Plane geometries if m_dirtyTriangulation is true and/or returns them.
 			Drawing is only needed when m_dirtyTriangulation is true
 		*/
-		const std::vector<LineSegment>& lineGeometries() const override;
+		const std::vector<LineSegment>& localLineGeometries() const override;
 
 		/*! Point 1 */
 		IBKMK::Vector2D			m_point1;
@@ -446,6 +577,99 @@ public:
 	};
 
 
+	/*! Closed boundary loop of a hatch. Segments are straight lines or circular arcs, the last segment
+		connects the last and the first vertex.
+	*/
+	struct HatchLoop {
+		/*! Loop vertices. */
+		std::vector<IBKMK::Vector2D>	m_vertices;
+		/*! Bulge of the segment starting at the vertex with the same index (tangent of a quarter of
+			the included angle, positive counter-clockwise), empty if all segments are straight.
+		*/
+		std::vector<double>				m_bulges;
+	};
+
+
+	/* Stores attributes of hatch */
+	struct Hatch : public AbstractDrawingObject {
+
+		TiXmlElement * writeXMLPrivate(TiXmlElement * element) const override;
+		void readXMLPrivate(const TiXmlElement * element) override;
+
+		/*! Tessellated boundary loops, same as outline(). */
+		const std::vector<IBKMK::Vector2D> &points2D() const override;
+		/*! Outlines of all boundary loops. */
+		const std::vector<LineSegment>& localLineGeometries() const override;
+
+		/*! Tessellates the boundary loops and triangulates solid fills, if the hatch was modified (see
+			updatePoints()) or the scaling factor of the drawing has changed. Only modifies this hatch,
+			called on first access of triangles().
+		*/
+		void tessellate() const;
+
+		/*! Tessellated boundary loops, loop i consists of the points [loopOffsets()[i], loopOffsets()[i+1]). */
+		const std::vector<IBKMK::Vector2D> &outline() const { tessellateOutline(); return m_pickPoints; }
+		const std::vector<unsigned int> &loopOffsets() const { tessellateOutline(); return m_loopOffsets; }
+		/*! Triangles of the fill, 3 indexes into outline() per triangle. Empty if the hatch has no solid fill.
+			Fills are triangulated on first call, the outline alone does not need the triangulation.
+		*/
+		const std::vector<unsigned int> &triangles() const { tessellate(); return m_triangles; }
+
+		/*! Boundary loops. */
+		std::vector<HatchLoop>					m_loops;
+		/*! If false, the hatch is drawn with a pattern. Patterns are not generated, only the boundary is drawn. */
+		bool									m_solidFill = true;
+
+	private:
+		/*! Tessellates the boundary loops only, bounds and pick points do not need the fill. */
+		void tessellateOutline() const;
+
+		/*! Scaling factor the tessellation was generated with, 0 if not tessellated yet. */
+		mutable double							m_tessellationScalingFactor = 0;
+		/*! Flag to indicate triangulation of the current outline. */
+		mutable bool							m_dirtyTriangles = true;
+		mutable std::vector<unsigned int>		m_loopOffsets;
+		mutable std::vector<unsigned int>		m_triangles;
+	};
+
+
+	/* Stores attributes of spline */
+	struct Spline : public AbstractDrawingObject {
+
+		TiXmlElement * writeXMLPrivate(TiXmlElement * element) const override;
+		void readXMLPrivate(const TiXmlElement * element) override;
+
+		/*! Tessellated curve, see tessellate(). */
+		const std::vector<IBKMK::Vector2D> &points2D() const override;
+		/*! Segments of the tessellated curve. */
+		const std::vector<LineSegment>& localLineGeometries() const override;
+
+		/*! Tessellates the curve, if the spline was modified (see updatePoints()) or the scaling factor
+			of the drawing has changed. Splines without valid control points are approximated by the
+			polyline through their fit points. Only modifies this spline, so splines can be tessellated
+			in parallel, see Drawing::tessellateSplines().
+		*/
+		void tessellate() const;
+
+		/*! Degree of the spline. */
+		unsigned int							m_degree = 3;
+		/*! Knot vector, number of control points + degree + 1 values. */
+		std::vector<double>						m_knots;
+		/*! Control points. */
+		std::vector<IBKMK::Vector2D>			m_controlPoints;
+		/*! Weights of the control points, empty if not rational. */
+		std::vector<double>						m_weights;
+		/*! Fit points, only used if there are no control points. */
+		std::vector<IBKMK::Vector2D>			m_fitPoints;
+		/*! Closed splines connect the end point with the start point. */
+		bool									m_closed = false;
+
+	private:
+		/*! Scaling factor the tessellation was generated with, 0 if not tessellated yet. */
+		mutable double							m_tessellationScalingFactor = 0;
+	};
+
+
 	/* Stores attributes of text, dummy struct */
 	struct Text : public AbstractDrawingObject {
 
@@ -456,7 +680,7 @@ public:
 		/*! Calculate Plane geometries if m_dirtyTriangulation is true and/or returns them.
 			Drawing is only needed when m_dirtyTriangulation is true
 		*/
-		const std::vector<LineSegment>& lineGeometries() const override;
+		const std::vector<LineSegment>& localLineGeometries() const override;
 
 		/*! Base point. */
 		IBKMK::Vector2D		m_basePoint;
@@ -481,7 +705,7 @@ public:
 		/*! Calculate Plane geometries if m_dirtyTriangulation is true and/or returns them.
 			Drawing is only needed when m_dirtyTriangulation is true
 		*/
-		const std::vector<LineSegment>& lineGeometries() const override;
+		const std::vector<LineSegment>& localLineGeometries() const override;
 
 		/*! Base point. */
 		IBKMK::Vector2D				m_dimensionPoint;
@@ -525,45 +749,133 @@ public:
 	/*! Returns the drawing object based on the ID. */
 	const AbstractDrawingObject* objectByID(unsigned int id) const;
 
+	/*! Returns the type of the drawing object with the given ID. */
+	ObjectType objectType(unsigned int id) const;
+
+	/*! Returns the drawing object referenced by type and index. */
+	const AbstractDrawingObject* objectByRef(const EntityRef &ref) const;
+
+	/*! Returns all entities of the given layer (including entities of block definitions).
+		Lists are maintained in updatePointer().
+	*/
+	const std::vector<EntityRef> &layerEntities(const DrawingLayer *layer) const;
+
 	/*! Helper function to assign the correct block to an entity
 		\returns Pointer of object, when it was found or nullptr if no object has been found
 	*/
 	Block* findBlockPointer(const QString &name, const std::map<QString, Block*> &blockRefs);
 
-	/*! used to assign the correct layer to an entity */
+	/*! Assigns layer, block and parent pointers of all entities and registers them for objectByID().
+		Only entities added since the last call are processed, as long as layers, blocks and dimension
+		styles are unchanged and no entities were removed. Otherwise all entities are linked again.
+	*/
 	void updatePointer();
 
+	/*! Forces the next call of updatePointer() to link all entities again. Needs to be called when
+		layers, blocks or entities were modified in place (renamed, reordered, erased in the middle).
+	*/
+	void invalidatePointers();
+
 	/*! Updates all planes, when transformation operations are applied.
 		MIND: Always call this function, when the drawing transformation
-		(translation, rotation) were changed, since the triangulation is
-		redone.
+		(translation, rotation) were changed, since pick points and bounds
+		are recalculated. Line geometries are kept in local coordinates,
+		so this is O(1): global geometries are derived lazily on access.
 	*/
 	void updatePlaneGeometries();
 
 	/*! Generates all inserting geometries. */
 	void generateInsertGeometries(unsigned int nextId);
 
-	/*! All drawing geometries are going to be updated. */
+	/*! All drawing geometries are going to be updated, local line geometries are regenerated lazily on access. */
 	void updateAllGeometries();
 
 	/*! Sorts layers alphabetically. */
 	void sortLayersAlphabetical();
 
+	/*! Removes duplicate and collinear vertices of all polylines and simplifies them with the given
+		tolerance (in m), see PolylineSimplification. Statistics are added to stats.
+	*/
+	void simplifyPolylines(double tolerance, PolylineSimplification::Statistics &stats);
+
+	/*! Removes duplicate lines and lines overlapping with collinear lines, see LineDeduplication.
+		Only lines on the given layers are removed (all layers if empty), overlapping lines with the same
+		layer, color and line weight are joined. Lines of block definitions are not touched.
+		\param tolerance Tolerance in m.
+		Pointers must be updated afterwards.
+	*/
+	void removeDuplicateLines(double tolerance, const std::set<QString> &layerNames, LineDeduplication::Statistics &stats);
+
+	/*! Tessellates all splines on worker threads, otherwise splines are tessellated on first access.
+		Pointers must be updated before calling this function!
+	*/
+	void tessellateSplines() const;
+
 	/*! Calculates the center coordinates, defined as median value of all coordinates.
 	 *  Median is beneficial here as it is less affected by a little number of extrem outliers.
 		Pointers must be updated before calling this function!
 	*/
 	IBKMK::Vector3D weightedCenterMedian(unsigned int nextId);
 
-	/*! Returns 3D Pick points of drawing. */
+	/*! Returns 3D Pick points of all visible layers of the drawing.
+		Pick points are cached per layer, toggling the visibility of a layer only adds or removes the
+		pick points of this layer.
+		\deprecated Use pickPointIndex(), which needs no shared map and also contains the intersection points
+		of lines, see m_intersectionPickPoints.
+	*/
 	const std::map<Drawing::Field, std::map<unsigned int, std::vector<IBKMK::Vector3D>>> &pickPoints() const;
 
+	/*! Returns pick points of all visible layers as flat index sorted by field, see PickPointIndex.
+		The index is built from the cached pick points of the layers (incl. intersection points if
+		m_intersectionPickPoints is set) with a parallel radix sort and only rebuilt if the visible layers or
+		their pick points changed.
+	*/
+	const PickPointIndex &pickPointIndex() const;
+
+	/*! Computes the bounding box of all visible layers (except layer '0') from the cached bounds of the layers.
+		Pointers must be updated before calling this function!
+	*/
+	void boundingBox(IBKMK::Vector3D &lowerValues, IBKMK::Vector3D &upperValues) const;
+
+	/*! Returns line geometries of all visible layers as one contiguous buffer. Buffer data is cached per layer
+		and only generated for entities added since the last call, layers whose attributes changed or after
+		the local geometries were invalidated (see updateAllGeometries()). Moving or rotating the drawing does
+		not change the buffer. Pointers must be updated before calling this function!
+	*/
+	const LineBuffer &lineBuffer() const;
+
+	/*! Returns the transformation matrix with the given palette index, composed with the current drawing
+		transformation (offset, rotation, scaling). Matrices are recomposed when the drawing transformation changed.
+	*/
+	const glm::dmat4 &transformationMatrix(unsigned int transIdx) const;
+
+	/*! Returns the transformation matrix with the given palette index, composed with the drawing scaling only.
+		Maps block/entity coordinates to local drawing coordinates.
+	*/
+	const glm::dmat4 &localTransformationMatrix(unsigned int transIdx) const;
+
+	/*! Returns placement of the drawing (offset and rotation), maps local drawing coordinates to global coordinates. */
+	const glm::dmat4 &placementMatrix() const;
+
+	/*! Computes the local 3D-point (without drawing offset and rotation), see localLineGeometries(). */
+	const IBKMK::Vector3D localPoint3D(const IBKMK::Vector2D &vert, const AbstractDrawingObject &object) const;
+
+	/*! Generates local 3D Points (without drawing offset and rotation) and stores them in points3D. */
+	void localPoints3D(const std::vector<IBKMK::Vector2D> &verts, const AbstractDrawingObject &object,
+					   std::vector<IBKMK::Vector3D> &points3D) const;
+
 	/*! Takes the transformation matrix and computes the global 3D-point. */
 	const IBKMK::Vector3D point3D(const IBKMK::Vector2D &vert, const AbstractDrawingObject &object) const;
 
 	/*! Generates 3D Points from 2D points by applying transformation from drawing. */
 	const std::vector<IBKMK::Vector3D> points3D(const std::vector<IBKMK::Vector2D> &verts, const AbstractDrawingObject &object) const;
 
+	/*! Generates 3D Points from 2D points by applying transformation from drawing and stores them in points3D,
+		which is resized to the number of vertices. Reusing the buffer avoids allocations in loops over many objects.
+	*/
+	void points3D(const std::vector<IBKMK::Vector2D> &verts, const AbstractDrawingObject &object,
+				  std::vector<IBKMK::Vector3D> &points3D) const;
+
 	/*! Returns the normal vector of the drawing. */
 	const IBKMK::Vector3D normal() const;
 
@@ -573,84 +885,19 @@ public:
 	/*! Returns the normal vector of the drawing. */
 	const IBKMK::Vector3D localY() const;
 
-	/*! Adds also all intersection points of lines to pickpoints. */
-	void addInstersectionPoints() const;
-
-	/*! Template function that removes objects if their layer name is one of the given layerNames. */
-	template <typename t>
-	void eraseObjectsByLayer(const std::set<QString> &layerNames, std::vector<t> &objects){
-		for (unsigned int idx=objects.size(); idx >0; --idx) {
-			if (layerNames.find(objects[idx - 1].m_layerName) != layerNames.end())
-				objects.erase( objects.begin() + idx-1 );
-		}
-	}
-
-	/*! Template that is invoked, when all plane geometries need to be updated and retriangulated.
-		All 3D points and pick points are recalculated and all triangulated planes are regenerated.
-		\param objects Vector with drawing elements
+	/*! Computes the intersection points of all lines and of all polylines and stores them as pick points of the
+		layer of the first line of each pair. Lines are processed in chunks on all cores, the points of the chunks
+		are appended in order afterwards. Only recomputed if lines were added or removed or the drawing
+		transformation changed. Pointers must be updated before calling this function!
 	*/
-	template <typename T>
-	void updateGeometryForAll(std::vector<T>& objects) {
-		for (T& obj : objects) {
-			obj.updatePlaneGeometry();
-		}
-	}
+	void addInstersectionPoints() const;
 
-	/*! Adds pick points to the current drawing object. The drawing object contains a map, where key is the id of the object
-		where the pick points are part of - for faster access. The value is a vector containing all 3D points, where it is possible
-		to pick to,
-		\param objects vector with all drawing object, where pick points should be generated and added to verts
+	/*! Removes all objects (points to splines, inserts are kept) whose layer name is one of the given layerNames.
+		Each collection is compacted in a single pass. Object table, layer and block entity lists are updated in place,
+		cached bounds, pick points and line buffers of the remaining layers stay valid. Layers themselves are kept.
+		Returns the number of removed objects.
 	*/
-	template <typename t>
-	void addPickPoints(const std::vector<t> &objects, bool pickLines = false) const {
-		for (const t& obj : objects) {
-			// Skip objects, that are part of a block,
-			// they have already been generated
-			if (obj.m_block != nullptr)	continue;
-
-			// qDebug() << "Obje: " << obj.m_id;
-
-			// Get 3D-points
-			std::vector<IBKMK::Vector3D> points(points3D(obj.points2D(), obj));
-#define PICK_DRAWING_LINES
-
-#ifdef PICK_DRAWING_LINES
-			if (pickLines) {
-				// Add pick-points
-				std::set<Field> fields;
-				for (unsigned int i=0; i<points.size(); ++i) {
-
-					const IBKMK::Vector3D &v1 = points[ i				  ];
-					const IBKMK::Vector3D &v2 = points[(i+1)%points.size()];
-
-					IBKMK::Vector3D dir = v2 - v1;
-					double length = dir.magnitude();
-
-					unsigned int steps = (int)(length/10.0) + 1;
-
-					for (unsigned int i=0; i < steps; ++i) {
-						IBKMK::Vector3D v3D = v1 + (double)i * 10.0 * dir.normalized();
-						fields.insert(Field(*this, v3D));
-					}
-				}
-
-				for (const IBKMK::Vector3D &v3D : points)
-					for (const Field &field : fields)
-						m_pickPoints[field][obj.m_id].push_back(v3D);
-
-			}
-			else {
-				// Add pick-points
-				for (const IBKMK::Vector3D &v3D : points)
-					m_pickPoints[Field(*this, v3D)][obj.m_id].push_back(v3D);
-			}
-#else
-			// Add pick-points
-			for (const IBKMK::Vector3D &v3D : points)
-				m_pickPoints[Field(v3D)][obj.m_id].push_back(v3D);
-#endif
-		}
-	}
+	std::size_t eraseObjectsByLayer(const std::set<QString> &layerNames);
 
 	// *** PUBLIC MEMBER VARIABLES ***
 
@@ -662,31 +909,35 @@ public:
 	double																	m_scalingFactor		= 1.0;
 
 	/*! list of blocks, dummy implementation */
-	std::vector<Block>														m_blocks;
+	ChunkedVector<Block>													m_blocks;
 	/*! list of layers */
 	std::vector<DrawingLayer>												m_drawingLayers;
 	/*! list of points */
-	std::vector<Point>														m_points;
+	ChunkedVector<Point>													m_points;
 	/*! list of lines */
-	std::vector<Line>														m_lines;
+	ChunkedVector<Line>														m_lines;
 	/*! list of polylines */
-	std::vector<PolyLine>													m_polylines;
+	ChunkedVector<PolyLine>													m_polylines;
 	/*! list of circles */
-	std::vector<Circle>														m_circles;
+	ChunkedVector<Circle>													m_circles;
 	/*! list of ellipses */
-	std::vector<Ellipse>													m_ellipses;
+	ChunkedVector<Ellipse>													m_ellipses;
 	/*! list of arcs */
-	std::vector<Arc>														m_arcs;
+	ChunkedVector<Arc>														m_arcs;
 	/*! list of solids, dummy implementation */
-	std::vector<Solid>														m_solids;
+	ChunkedVector<Solid>													m_solids;
 	/*! list of texts */
-	std::vector<Text>														m_texts;
+	ChunkedVector<Text>														m_texts;
 	/*! list of texts */
-	std::vector<LinearDimension>											m_linearDimensions;
+	ChunkedVector<LinearDimension>											m_linearDimensions;
+	/*! list of hatches */
+	ChunkedVector<Hatch>													m_hatches;
+	/*! list of splines */
+	ChunkedVector<Spline>													m_splines;
 	/*! list of Dim Styles */
 	std::vector<DimStyle>													m_dimensionStyles;
 	/*! list of inserts. */
-	std::vector<Insert>														m_inserts;
+	ChunkedVector<Insert>													m_inserts;
 
 	/*! Factor to be multiplied with line weight of objects. */
 	double																	m_lineWeightScaling = 1;
@@ -721,11 +972,11 @@ private:
 	/*! Transforms all inserts.
 		Mind: Parameter 'trans' is passed by value here on purpose. This allows using the function recursively.
 	 */
-	void transformInsert(QMatrix4x4 trans, const Drawing::Insert &insert, unsigned int &nextId);
+	void transformInsert(glm::dmat4 trans, const Drawing::Insert &insert, unsigned int &nextId);
 
-	/*! Function to generate plane geometries from text. Heavy operation. Text is polygonised by QPainterPath with font-size 1
-		in order to get a rough letter and less polygons. Some dxfs contain a lot of text and so we would end in having too many
-		polygons.
+	/*! Function to generate line geometries from text. Glyph outlines are polygonised once per character and cached, see
+		GlyphOutlines. The text is a run of these outlines, scaled to textHeight, rotated clockwise by rotationAngle (Deg)
+		and moved to basePoint. Lines are generated in local drawing coordinates, see localPoint3D().
 	*/
 	void generateLinesFromText(const std::string &text, double textHeight, Qt::Alignment alignment, const double &rotationAngle,
 							   const IBKMK::Vector2D &basePoint, const AbstractDrawingObject &object, std::vector<LineSegment> &lineGeometries) const;
@@ -733,10 +984,226 @@ private:
 	/*! Find layer reference. */
 	const DrawingLayer *findLayerReference(const std::map<QString, const DrawingLayer*> &layerRefs, const QString &layerName);
 
-	/*! Cached unique-ID -> object ptr map. Greatly speeds up objectByID() and any other lookup functions.
-		This map is updated in updatePointers().
+	/*! Links all objects of a collection, that have been added since the last call, registers them in the
+		object table with the given type and adds them to the layer and block entity lists.
+		Returns index of the first newly linked object.
+	*/
+	template <typename t>
+	std::size_t linkObjects(ChunkedVector<t> &objects, ObjectType type,
+							const std::map<QString, const DrawingLayer*> &layerRefs,
+							const std::map<QString, Block*> &blockRefs);
+
+	/*! Removes all objects of a collection whose layer is flagged in layerMask (index is the layer index) and
+		updates the object table. newIdx receives the new index of each object, or INVALID_ID if it was removed.
+		Requires linked objects. Returns the number of removed objects.
 	*/
-	std::map<unsigned int, Drawing::AbstractDrawingObject*>							m_objectPtr;
+	template <typename t>
+	std::size_t eraseObjectsByLayerMask(ChunkedVector<t> &objects, ObjectType type, const std::vector<char> &layerMask,
+										std::vector<unsigned int> &newIdx);
+
+	/*! Bookkeeping of updatePointer(). Copies (and moved-to drawings) start unlinked, since the pointers
+		of the copied objects still refer to the source drawing.
+	*/
+	struct LinkState {
+		LinkState() { reset(); }
+		LinkState(const LinkState &) { reset(); }
+		LinkState & operator=(const LinkState &) { reset(); return *this; }
+
+		void reset() {
+			for (unsigned int i = 0; i < NUM_OT; ++i)
+				m_linkedCount[i] = 0;
+			m_layers = nullptr;
+			m_layerCount = 0;
+			m_blockCount = 0;
+			m_dimStyles = nullptr;
+			m_dimStyleCount = 0;
+			m_idBase = 0;
+			m_objects.clear();
+			m_layerBuckets.clear();
+			m_blockEntities.clear();
+			m_lineBuffer = LineBuffer();
+			m_lineBufferLayers.clear();
+			m_lineBufferCentered = false;
+			m_lineBufferVersion = 0;
+			m_lineBufferGeneration = 0;
+			m_intersectionsValid = false;
+		}
+
+		/*! Registers an object in the object table. */
+		void registerObject(unsigned int id, AbstractDrawingObject *obj, ObjectType type);
+
+		/*! Pick point of an entity. */
+		struct PickPoint {
+			Field				m_field;
+			unsigned int		m_id;
+			IBKMK::Vector3D		m_point;
+		};
+
+		/*! Entities of one layer with cached bounds and pick points. The caches are extended lazily when
+			entities are added and reset when the drawing transformation changes.
+		*/
+		struct LayerBucket {
+			/*! Clears cached bounds and pick points. */
+			void resetCache() const {
+				m_boundsCount = 0;
+				m_pickPoints.clear();
+				m_pickCount = 0;
+				m_picksMerged = false;
+			}
+
+			/*! All entities of the layer. */
+			std::vector<EntityRef>			m_entities;
+			/*! Bounds of the first m_boundsCount entities, only valid if m_boundsCount > 0. */
+			mutable IBKMK::Vector3D			m_lowerValues;
+			mutable IBKMK::Vector3D			m_upperValues;
+			mutable std::size_t				m_boundsCount = 0;
+			/*! Pick points of the first m_pickCount entities (only entities that are not part of a block). */
+			mutable std::vector<PickPoint>	m_pickPoints;
+			mutable std::size_t				m_pickCount = 0;
+			/*! True, if the pick points are contained in Drawing::m_pickPoints. */
+			mutable bool					m_picksMerged = false;
+			/*! Intersection points of the lines of the layer, see addInstersectionPoints(). */
+			mutable std::vector<PickPoint>	m_intersectionPoints;
+
+			/*! Clears cached line buffer data. */
+			void resetBuffer() const {
+				m_bufferVertices.clear();
+				m_bufferIndices.clear();
+				m_bufferCount = 0;
+			}
+
+			/*! Line buffer data of the first m_bufferCount entities, indexes are relative to this layer. */
+			mutable std::vector<LineVertex>		m_bufferVertices;
+			mutable std::vector<unsigned int>	m_bufferIndices;
+			mutable std::size_t					m_bufferCount = 0;
+			/*! Changes whenever the buffer data is modified, 0 if it was never generated. */
+			mutable unsigned int				m_bufferGeneration = 0;
+			/*! Layer attributes the buffer data was generated with. */
+			mutable QColor						m_bufferColor;
+			mutable double						m_bufferLineWeight = 0;
+		};
+
+		/*! Entry of object table. */
+		struct ObjectRef {
+			AbstractDrawingObject	*m_object = nullptr;
+			ObjectType				m_type = NUM_OT;
+		};
+
+		/*! Number of objects per collection that are already linked. */
+		std::size_t										m_linkedCount[NUM_OT];
+		/*! Layer storage and count at last link, a change requires relinking all objects. */
+		const DrawingLayer								*m_layers;
+		std::size_t										m_layerCount;
+		/*! Block count at last link (blocks are pointer stable). */
+		std::size_t										m_blockCount;
+		/*! Dimension style storage and count at last link. */
+		const DimStyle									*m_dimStyles;
+		std::size_t										m_dimStyleCount;
+		/*! ID of first entry in object table. */
+		unsigned int									m_idBase;
+		/*! Dense unique-ID -> object table, index is 'ID - m_idBase', nullptr for unused IDs.
+			IDs are handed out consecutively during import, hence the table has hardly any gaps.
+			Greatly speeds up objectByID() and any other lookup functions.
+		*/
+		std::vector<ObjectRef>							m_objects;
+		/*! Entities per layer, index is the index of the layer in m_drawingLayers. */
+		std::vector<LayerBucket>						m_layerBuckets;
+		/*! Entities per block definition, used to generate insert objects. */
+		std::map<const Block*, std::vector<EntityRef>>	m_blockEntities;
+
+		/*! Drawing transformation and field size the cached bounds and pick points were computed with. */
+		mutable IBKMK::Vector3D							m_cacheOffset;
+		mutable QQuaternion								m_cacheRotation;
+		mutable double									m_cacheScalingFactor = 0;
+		mutable double									m_cacheFieldSize = 0;
+
+		/*! Assembled line buffer of all visible layers. */
+		mutable LineBuffer								m_lineBuffer;
+		/*! Layer indexes and buffer generations m_lineBuffer was assembled from. */
+		mutable std::vector<std::pair<unsigned int, unsigned int>>	m_lineBufferLayers;
+		/*! True, if m_lineBuffer.m_center was set from the first generated vertex. */
+		mutable bool									m_lineBufferCentered;
+		/*! Local geometry version and line weight settings the layer buffers were generated with. */
+		mutable unsigned int							m_lineBufferVersion;
+		mutable double									m_lineBufferWeightScaling = 0;
+		mutable double									m_lineBufferWeightOffset = 0;
+		/*! Last handed out layer buffer generation. */
+		mutable unsigned int							m_lineBufferGeneration;
+
+		/*! True, if the intersection points of the layers are valid for m_intersectionCounts lines and polylines. */
+		mutable bool									m_intersectionsValid;
+		mutable std::size_t								m_intersectionCounts[2];
+	};
+
+	/*! Resets the cached bounds and pick points of all layers if the drawing transformation or field size
+		has changed since they were computed.
+	*/
+	void checkCachedTransformation() const;
+
+	/*! Composes all transformation matrices of the palette. Afterwards transformationMatrix() and
+		localTransformationMatrix() only read and can be called from several threads.
+	*/
+	void composeTransformations() const;
+
+	/*! Extends the cached bounds of the given layers (indexes of buckets) by the entities added since the last call.
+		Entities are processed in chunks on all cores, the chunk bounds are merged afterwards.
+	*/
+	void updateLayerBounds(const std::vector<unsigned int> &bucketIdxs) const;
+
+	/*! Extends the cached pick points of the given layers (indexes of buckets) by the entities added since the last call.
+		Entities are processed in chunks on all cores, the pick points of the chunks are appended in order afterwards.
+	*/
+	void updateLayerPickPoints(const std::vector<unsigned int> &bucketIdxs) const;
+
+	/*! Generates the local line geometries of all entities of the given layers (indexes of buckets), which are
+		not part of the layer's line buffer data yet, in chunks on all cores.
+	*/
+	void updateLayerLineGeometries(const std::vector<unsigned int> &bucketIdxs) const;
+
+	/*! Removes the pick points of a layer from m_pickPoints, if they were merged. */
+	void removeMergedPickPoints(const LinkState::LayerBucket &bucket) const;
+
+	/*! Generates pick points of a single object. If pickLines is true, points are added to all fields
+		crossed by the lines of the object. 'points' is a buffer for the 3D points of the object.
+	*/
+	void addPickPoints(const AbstractDrawingObject &obj, bool pickLines, std::vector<IBKMK::Vector3D> &points,
+					   std::vector<LinkState::PickPoint> &pickPoints) const;
+
+	/*! Extends the cached line buffer data of a layer by the entities added since the last call.
+		Buffer data is regenerated completely if the layer color or line weight changed.
+	*/
+	void updateLayerLineBuffer(const DrawingLayer &layer, const LinkState::LayerBucket &bucket) const;
+
+	/*! Transformation palette: one double precision matrix per insert transformation (block coordinates to
+		drawing coordinates), index 0 is identity. Entities refer to it via m_transIdx.
+	*/
+	std::vector<glm::dmat4>															m_insertTransforms = std::vector<glm::dmat4>(1, glm::dmat4(1.0));
+
+	/*! Checks drawing offset, rotation and scaling against the values the matrices were composed with.
+		A changed scaling factor invalidates local geometries, a changed placement only global geometries.
+	*/
+	void updateTransformations() const;
+
+	/*! Palette matrices composed with drawing transformation, updated in transformationMatrix(). */
+	mutable std::vector<glm::dmat4>													m_transforms;
+	/*! Palette matrices composed with drawing scaling, updated in localTransformationMatrix(). */
+	mutable std::vector<glm::dmat4>													m_localTransforms;
+	/*! Drawing placement (offset and rotation). */
+	mutable glm::dmat4																m_placement = glm::dmat4(1.0);
+	/*! Drawing transformation the matrices were composed with. */
+	mutable IBKMK::Vector3D															m_transformOffset;
+	mutable QQuaternion																m_transformRotation;
+	mutable double																	m_transformScalingFactor = 0;
+
+	/*! Versions of local (scaling dependent) and global (placement dependent) geometries, entities
+		compare their cached line geometries against these. Incrementing a version invalidates
+		the geometries of all entities in O(1).
+	*/
+	mutable unsigned int															m_localGeometryVersion = 1;
+	mutable unsigned int															m_globalGeometryVersion = 1;
+
+	/*! Link state, updated in updatePointer(). */
+	LinkState																		m_linkState;
 
 	/*! Cached pick points of drawing.
 		\param Key is ID of drawing object, to get better referencing in picking.
@@ -746,6 +1213,18 @@ private:
 
 	/*! Mark if pick points have to be recalculated. */
 	mutable bool																	m_dirtyPickPoints = true;
+
+	/*! Cached pick point index, see pickPointIndex(). */
+	mutable PickPointIndex															m_pickPointIndex;
+	/*! Layer indexes and pick point counts m_pickPointIndex was built from. */
+	mutable std::vector<std::pair<unsigned int, std::size_t>>						m_pickPointIndexLayers;
+	/*! Mark if pick point index has to be rebuilt, since cached pick points of layers were regenerated. */
+	mutable bool																	m_dirtyPickPointIndex = true;
+
+	/*! If true, pickPointIndex() also contains the intersection points of lines and of polylines.
+		Off by default, since all pairs of lines are tested.
+	*/
+	bool																			m_intersectionPickPoints = false;
 };
 
 
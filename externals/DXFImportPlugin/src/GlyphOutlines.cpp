@@ -0,0 +1,78 @@
+#include "GlyphOutlines.h"
+
+#include <map>
+#include <mutex>
+
+#include <QFont>
+#include <QFontMetricsF>
+#include <QPainterPath>
+
+#include "Constants.h"
+
+namespace GlyphOutlines {
+
+/*! Polygonises a glyph with QPainterPath. */
+static void createGlyph(const QString & fontFamily, unsigned int codePoint, Glyph & g) {
+	QFont font(fontFamily);
+	font.setPointSizeF(GLYPH_OUTLINE_FONT_SIZE);
+	QFontMetricsF metrics(font);
+	double capHeight = metrics.capHeight();
+	if (capHeight <= 0)
+		capHeight = metrics.ascent();
+	double scale = 1.0 / capHeight;
+
+	QString character = QString::fromUcs4(&codePoint, 1);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+	g.m_advance = metrics.horizontalAdvance(character) * scale;
+#else
+	g.m_advance = metrics.width(character) * scale;
+#endif
+
+	QPainterPath path;
+	path.addText(0, 0, font, character);
+	// Qt coordinates have y downwards
+	QList<QPolygonF> polygons = path.toSubpathPolygons();
+	g.m_polygonOffsets.push_back(0);
+	for (const QPolygonF & polygon : polygons) {
+		int count = polygon.size();
+		// subpath polygons are closed explicitly
+		if (count > 1 && polygon.first() == polygon.last())
+			--count;
+		if (count < 2)
+			continue;
+		for (int i = 0; i < count; ++i)
+			g.m_points.push_back(IBKMK::Vector2D(polygon[i].x() * scale, -polygon[i].y() * scale));
+		g.m_polygonOffsets.push_back((unsigned int)g.m_points.size());
+	}
+}
+
+
+const Glyph & glyph(const QString & fontFamily, unsigned int codePoint) {
+	static std::map<std::pair<QString, unsigned int>, Glyph> glyphs;
+	static std::mutex glyphsMutex;
+
+	std::lock_guard<std::mutex> lock(glyphsMutex);
+	std::pair<QString, unsigned int> key(fontFamily, codePoint);
+	std::map<std::pair<QString, unsigned int>, Glyph>::iterator it = glyphs.find(key);
+	if (it != glyphs.end())
+		return it->second;
+
+	// map nodes are stable, references to other glyphs stay valid
+	Glyph & g = glyphs[key];
+	createGlyph(fontFamily, codePoint, g);
+	return g;
+}
+
+
+double glyphRun(const QString & fontFamily, const QString & text, std::vector<const Glyph*> & glyphs) {
+	double advance = 0;
+	const QVector<uint> codePoints = text.toUcs4();
+	for (uint codePoint : codePoints) {
+		const Glyph & g = glyph(fontFamily, codePoint);
+		glyphs.push_back(&g);
+		advance += g.m_advance;
+	}
+	return advance;
+}
+
+} // namespace GlyphOutlines
@@ -0,0 +1,46 @@
+#ifndef GlyphOutlinesH
+#define GlyphOutlinesH
+
+#include <vector>
+
+#include <QString>
+
+#include <IBKMK_Vector2D.h>
+
+/*! Cache of polygonised glyph outlines.
+
+	Polygonising text with QPainterPath is expensive, while drawings usually repeat a small set
+	of characters many times. Each glyph is therefore polygonised once per font and character.
+	Outlines are normalised to a cap height of 1, so that texts of all heights share the same
+	glyphs. Text geometry is then a transformation of the referenced glyph outlines.
+
+	Glyphs are never removed from the cache, references remain valid for the lifetime of the
+	program. All functions are thread-safe.
+*/
+namespace GlyphOutlines {
+
+/*! Outline of a single character. */
+struct Glyph {
+	/*! Points of all outline polygons. Coordinates are relative to the start of the baseline,
+		y upwards, in units of the cap height of the font.
+	*/
+	std::vector<IBKMK::Vector2D>	m_points;
+	/*! Polygon i consists of the points [m_polygonOffsets[i], m_polygonOffsets[i+1]), polygons are closed. */
+	std::vector<unsigned int>		m_polygonOffsets;
+	/*! Horizontal advance to the start of the next character, in units of the cap height. */
+	double							m_advance = 0;
+};
+
+/*! Returns the outline of the character with the given unicode code point. The glyph is
+	generated on first request.
+*/
+const Glyph & glyph(const QString & fontFamily, unsigned int codePoint);
+
+/*! Appends the glyphs of all characters of text to glyphs and returns the total advance,
+	which is the width of the text in units of the cap height.
+*/
+double glyphRun(const QString & fontFamily, const QString & text, std::vector<const Glyph*> & glyphs);
+
+} // namespace GlyphOutlines
+
+#endif // GlyphOutlinesH
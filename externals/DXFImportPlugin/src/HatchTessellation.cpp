@@ -0,0 +1,401 @@
+#include "HatchTessellation.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "CurveTessellation.h"
+
+namespace HatchTessellation {
+
+/*! Point indexes of a polygon. */
+typedef std::vector<unsigned int> Ring;
+
+
+/*! Twice the signed area of triangle a, b, c, positive if counter-clockwise. */
+static inline double cross(const IBKMK::Vector2D & a, const IBKMK::Vector2D & b, const IBKMK::Vector2D & c) {
+	return (b.m_x - a.m_x) * (c.m_y - a.m_y) - (b.m_y - a.m_y) * (c.m_x - a.m_x);
+}
+
+
+static inline bool samePoint(const IBKMK::Vector2D & a, const IBKMK::Vector2D & b) {
+	return a.m_x == b.m_x && a.m_y == b.m_y;
+}
+
+
+/*! True if p lies inside or on the boundary of triangle a, b, c (any orientation). */
+static inline bool pointInTriangle(const IBKMK::Vector2D & a, const IBKMK::Vector2D & b, const IBKMK::Vector2D & c,
+								   const IBKMK::Vector2D & p)
+{
+	double d1 = cross(a, b, p);
+	double d2 = cross(b, c, p);
+	double d3 = cross(c, a, p);
+	bool hasNeg = d1 < 0 || d2 < 0 || d3 < 0;
+	bool hasPos = d1 > 0 || d2 > 0 || d3 > 0;
+	return !(hasNeg && hasPos);
+}
+
+
+/*! Crossing number test of p against the polygon points[begin, end). */
+static bool pointInPolygon(const IBKMK::Vector2D & p, const std::vector<IBKMK::Vector2D> & points,
+						   unsigned int begin, unsigned int end)
+{
+	bool inside = false;
+	for (unsigned int i = begin, j = end - 1; i < end; j = i++) {
+		const IBKMK::Vector2D & a = points[i];
+		const IBKMK::Vector2D & b = points[j];
+		if ((a.m_y > p.m_y) != (b.m_y > p.m_y) &&
+			p.m_x < (b.m_x - a.m_x) * (p.m_y - a.m_y) / (b.m_y - a.m_y) + a.m_x)
+		{
+			inside = !inside;
+		}
+	}
+	return inside;
+}
+
+
+/*! True if p lies inside the interior angle of the counter-clockwise ring at position i. */
+static bool locallyInside(const std::vector<IBKMK::Vector2D> & points, const Ring & ring, std::size_t i,
+						  const IBKMK::Vector2D & p)
+{
+	const IBKMK::Vector2D & a = points[ring[(i + ring.size() - 1) % ring.size()]];
+	const IBKMK::Vector2D & b = points[ring[i]];
+	const IBKMK::Vector2D & c = points[ring[(i + 1) % ring.size()]];
+	if (cross(a, b, c) >= 0)
+		return cross(b, c, p) >= 0 && cross(a, b, p) >= 0;
+	else
+		return cross(b, c, p) >= 0 || cross(a, b, p) >= 0;
+}
+
+
+/*! Connects the clockwise hole to the counter-clockwise ring with a bridge edge from the rightmost
+	hole vertex to a visible ring vertex (D. Eberly, Triangulation by Ear Clipping).
+	Returns false, if no ring edge lies to the right of the hole.
+*/
+static bool bridgeHole(const std::vector<IBKMK::Vector2D> & points, Ring & ring, const Ring & hole) {
+	std::size_t m = 0;
+	for (std::size_t k = 1; k < hole.size(); ++k) {
+		if (points[hole[k]].m_x > points[hole[m]].m_x)
+			m = k;
+	}
+	const IBKMK::Vector2D & M = points[hole[m]];
+
+	// nearest intersection I of the ray from M in +x direction with the ring
+	const std::size_t npos = std::numeric_limits<std::size_t>::max();
+	std::size_t n = ring.size();
+	double bestX = std::numeric_limits<double>::max();
+	std::size_t best = npos;
+	for (std::size_t i = 0; i < n; ++i) {
+		const IBKMK::Vector2D & a = points[ring[i]];
+		const IBKMK::Vector2D & b = points[ring[(i + 1) % n]];
+		if ((a.m_y > M.m_y && b.m_y > M.m_y) || (a.m_y < M.m_y && b.m_y < M.m_y))
+			continue;
+		double x;
+		std::size_t candidate;
+		if (a.m_y == b.m_y) {
+			// edge on the ray, the nearer end point is hit first
+			x = std::min(a.m_x, b.m_x);
+			candidate = a.m_x < b.m_x ? i : (i + 1) % n;
+		}
+		else {
+			x = a.m_x + (M.m_y - a.m_y) * (b.m_x - a.m_x) / (b.m_y - a.m_y);
+			// end point with larger x is the bridge candidate
+			candidate = a.m_x > b.m_x ? i : (i + 1) % n;
+		}
+		if (x >= M.m_x && x < bestX) {
+			bestX = x;
+			best = candidate;
+		}
+	}
+	if (best == npos)
+		return false;
+
+	// vertices inside triangle M, I, P may hide P, take the one with the smallest angle to the ray
+	IBKMK::Vector2D I(bestX, M.m_y);
+	IBKMK::Vector2D P = points[ring[best]];
+	if (!samePoint(I, P)) {
+		double tanMin = std::numeric_limits<double>::max();
+		for (std::size_t i = 0; i < n; ++i) {
+			const IBKMK::Vector2D & v = points[ring[i]];
+			if (v.m_x < M.m_x || samePoint(v, P) || !pointInTriangle(M, I, P, v))
+				continue;
+			double tan = v.m_x > M.m_x ? std::abs(M.m_y - v.m_y) / (v.m_x - M.m_x) : std::numeric_limits<double>::max();
+			if ((tan < tanMin || (tan == tanMin && v.m_x > points[ring[best]].m_x)) && locallyInside(points, ring, i, M)) {
+				best = i;
+				tanMin = tan;
+			}
+		}
+	}
+
+	// previous bridges duplicate vertices, take an occurrence that sees M
+	if (!locallyInside(points, ring, best, M)) {
+		const IBKMK::Vector2D & b = points[ring[best]];
+		for (std::size_t i = 0; i < n; ++i) {
+			if (i != best && samePoint(points[ring[i]], b) && locallyInside(points, ring, i, M)) {
+				best = i;
+				break;
+			}
+		}
+	}
+
+	Ring merged;
+	merged.reserve(n + hole.size() + 2);
+	merged.insert(merged.end(), ring.begin(), ring.begin() + best + 1);
+	for (std::size_t k = 0; k < hole.size(); ++k)
+		merged.push_back(hole[(m + k) % hole.size()]);
+	merged.push_back(hole[m]);
+	merged.push_back(ring[best]);
+	merged.insert(merged.end(), ring.begin() + best + 1, ring.end());
+	ring.swap(merged);
+	return true;
+}
+
+
+/*! Triangulates the counter-clockwise ring by ear clipping. Returns false if the ring is not simple
+	and ears had to be clipped without containment test.
+*/
+static bool earClip(const std::vector<IBKMK::Vector2D> & points, const Ring & ring, std::vector<unsigned int> & triangles) {
+	std::size_t n = ring.size();
+	if (n < 3)
+		return true;
+
+	// doubly linked list of ring positions
+	std::vector<unsigned int> prev(n), next(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		prev[i] = (unsigned int)((i + n - 1) % n);
+		next[i] = (unsigned int)((i + 1) % n);
+	}
+
+	// Only reflex (and flat) vertices can lie inside an ear. Clipping ears never turns a convex
+	// vertex into a reflex one, so candidates are collected once, sorted by x, and only flagged
+	// when they are removed or become convex.
+	std::vector<std::pair<double, unsigned int> > reflex;
+	std::vector<char> isReflex(n, 0);
+	for (std::size_t i = 0; i < n; ++i) {
+		if (cross(points[ring[prev[i]]], points[ring[i]], points[ring[next[i]]]) <= 0) {
+			reflex.push_back(std::make_pair(points[ring[i]].m_x, (unsigned int)i));
+			isReflex[i] = 1;
+		}
+	}
+	std::sort(reflex.begin(), reflex.end());
+
+	auto isEar = [&](unsigned int i) {
+		const IBKMK::Vector2D & a = points[ring[prev[i]]];
+		const IBKMK::Vector2D & b = points[ring[i]];
+		const IBKMK::Vector2D & c = points[ring[next[i]]];
+		double minX = std::min(a.m_x, std::min(b.m_x, c.m_x));
+		double maxX = std::max(a.m_x, std::max(b.m_x, c.m_x));
+		std::vector<std::pair<double, unsigned int> >::const_iterator it =
+				std::lower_bound(reflex.begin(), reflex.end(), std::make_pair(minX, 0u));
+		for (; it != reflex.end() && it->first <= maxX; ++it) {
+			unsigned int r = it->second;
+			if (!isReflex[r] || r == prev[i] || r == i || r == next[i])
+				continue;
+			if (cross(points[ring[prev[r]]], points[ring[r]], points[ring[next[r]]]) > 0) {
+				isReflex[r] = 0;
+				continue;
+			}
+			const IBKMK::Vector2D & p = points[ring[r]];
+			// duplicates of the triangle corners are created by bridges
+			if (samePoint(p, a) || samePoint(p, b) || samePoint(p, c))
+				continue;
+			if (pointInTriangle(a, b, c, p))
+				return false;
+		}
+		return true;
+	};
+
+	auto clip = [&](unsigned int i, bool addTriangle) {
+		if (addTriangle) {
+			triangles.push_back(ring[prev[i]]);
+			triangles.push_back(ring[i]);
+			triangles.push_back(ring[next[i]]);
+		}
+		next[prev[i]] = next[i];
+		prev[next[i]] = prev[i];
+		isReflex[i] = 0;
+	};
+
+	bool simple = true;
+	std::size_t remaining = n;
+	std::size_t stall = 0;
+	unsigned int cur = 0;
+	while (remaining > 3) {
+		double area = cross(points[ring[prev[cur]]], points[ring[cur]], points[ring[next[cur]]]);
+		if (area == 0 || (area > 0 && isEar(cur))) {
+			// degenerate corners (collinear points, bridge spikes) are removed without triangle
+			unsigned int following = next[cur];
+			clip(cur, area > 0);
+			--remaining;
+			stall = 0;
+			cur = following;
+			continue;
+		}
+
+		cur = next[cur];
+		if (++stall <= remaining)
+			continue;
+
+		// no ear found in a full cycle, the ring intersects itself: clip the next convex corner anyway
+		simple = false;
+		std::size_t k = 0;
+		while (k < remaining && cross(points[ring[prev[cur]]], points[ring[cur]], points[ring[next[cur]]]) <= 0) {
+			cur = next[cur];
+			++k;
+		}
+		if (k == remaining)
+			return false;
+		unsigned int following = next[cur];
+		clip(cur, true);
+		--remaining;
+		stall = 0;
+		cur = following;
+	}
+
+	if (cross(points[ring[prev[cur]]], points[ring[cur]], points[ring[next[cur]]]) > 0)
+		clip(cur, true);
+	return simple;
+}
+
+
+void tessellateLoop(const std::vector<IBKMK::Vector2D> & vertices, const std::vector<double> & bulges,
+					double maxDeviation, std::vector<IBKMK::Vector2D> & points)
+{
+	std::vector<IBKMK::Vector2D> arcPoints;
+	std::size_t n = vertices.size();
+	for (std::size_t i = 0; i < n; ++i) {
+		const IBKMK::Vector2D & p1 = vertices[i];
+		const IBKMK::Vector2D & p2 = vertices[(i + 1) % n];
+		points.push_back(p1);
+
+		double bulge = i < bulges.size() ? bulges[i] : 0;
+		if (std::abs(bulge) < 1e-9 || samePoint(p1, p2))
+			continue;
+
+		// center lies on the perpendicular bisector of the chord, left of it for positive bulges
+		IBKMK::Vector2D chord = p2 - p1;
+		double length = chord.magnitude();
+		double offset = (1 - bulge * bulge) / (4 * bulge);
+		IBKMK::Vector2D center(0.5 * (p1.m_x + p2.m_x) - offset * chord.m_y,
+							   0.5 * (p1.m_y + p2.m_y) + offset * chord.m_x);
+		double radius = length * (1 + bulge * bulge) / (4 * std::abs(bulge));
+		double angle1 = std::atan2(p1.m_y - center.m_y, p1.m_x - center.m_x);
+		double angle2 = std::atan2(p2.m_y - center.m_y, p2.m_x - center.m_x);
+
+		// end points are the loop vertices, only interior arc points are added
+		if (bulge > 0) {
+			CurveTessellation::arc(center, radius, angle1, angle2, maxDeviation, arcPoints);
+			for (std::size_t k = 1; k + 1 < arcPoints.size(); ++k)
+				points.push_back(arcPoints[k]);
+		}
+		else {
+			CurveTessellation::arc(center, radius, angle2, angle1, maxDeviation, arcPoints);
+			for (std::size_t k = arcPoints.size() - 2; k > 0; --k)
+				points.push_back(arcPoints[k]);
+		}
+	}
+}
+
+
+bool triangulate(const std::vector<IBKMK::Vector2D> & points, const std::vector<unsigned int> & loopOffsets,
+				 std::vector<unsigned int> & triangles)
+{
+	if (loopOffsets.size() < 2)
+		return true;
+
+	struct Loop {
+		unsigned int	m_begin;
+		unsigned int	m_end;
+		double			m_area = 0;
+		IBKMK::Vector2D	m_min;
+		IBKMK::Vector2D	m_max;
+		/*! Number of loops containing this loop, -1 for degenerate loops. */
+		int				m_depth = 0;
+		/*! Innermost loop containing this loop. */
+		int				m_parent = -1;
+	};
+
+	std::vector<Loop> loops(loopOffsets.size() - 1);
+	for (std::size_t i = 0; i < loops.size(); ++i) {
+		Loop & l = loops[i];
+		l.m_begin = loopOffsets[i];
+		l.m_end = loopOffsets[i + 1];
+		if (l.m_end - l.m_begin < 3) {
+			l.m_depth = -1;
+			continue;
+		}
+		l.m_min = l.m_max = points[l.m_begin];
+		for (unsigned int k = l.m_begin, j = l.m_end - 1; k < l.m_end; j = k++) {
+			const IBKMK::Vector2D & p = points[k];
+			l.m_area += points[j].m_x * p.m_y - p.m_x * points[j].m_y;
+			l.m_min = IBKMK::Vector2D(std::min(l.m_min.m_x, p.m_x), std::min(l.m_min.m_y, p.m_y));
+			l.m_max = IBKMK::Vector2D(std::max(l.m_max.m_x, p.m_x), std::max(l.m_max.m_y, p.m_y));
+		}
+		l.m_area *= 0.5;
+		if (l.m_area == 0)
+			l.m_depth = -1;
+	}
+
+	// nesting depth, a containing loop is always larger than the contained one
+	for (std::size_t i = 0; i < loops.size(); ++i) {
+		Loop & l = loops[i];
+		if (l.m_depth < 0)
+			continue;
+		const IBKMK::Vector2D & p = points[l.m_begin];
+		for (std::size_t j = 0; j < loops.size(); ++j) {
+			const Loop & o = loops[j];
+			if (j == i || o.m_depth < 0 || std::abs(o.m_area) <= std::abs(l.m_area))
+				continue;
+			if (p.m_x < o.m_min.m_x || p.m_x > o.m_max.m_x || p.m_y < o.m_min.m_y || p.m_y > o.m_max.m_y)
+				continue;
+			if (!pointInPolygon(p, points, o.m_begin, o.m_end))
+				continue;
+			++l.m_depth;
+			if (l.m_parent < 0 || std::abs(o.m_area) < std::abs(loops[l.m_parent].m_area))
+				l.m_parent = (int)j;
+		}
+	}
+
+	bool success = true;
+	Ring ring;
+	std::vector<std::pair<double, Ring> > holes;
+	for (std::size_t i = 0; i < loops.size(); ++i) {
+		const Loop & outer = loops[i];
+		if (outer.m_depth < 0 || outer.m_depth % 2 != 0)
+			continue;
+
+		// outer ring counter-clockwise
+		ring.clear();
+		for (unsigned int k = outer.m_begin; k < outer.m_end; ++k)
+			ring.push_back(k);
+		if (outer.m_area < 0)
+			std::reverse(ring.begin(), ring.end());
+
+		// holes clockwise, bridged from right to left so that bridges do not cross later holes
+		holes.clear();
+		for (std::size_t j = 0; j < loops.size(); ++j) {
+			const Loop & h = loops[j];
+			if (h.m_depth < 0 || h.m_depth % 2 == 0 || h.m_parent != (int)i)
+				continue;
+			holes.push_back(std::make_pair(h.m_max.m_x, Ring()));
+			Ring & hole = holes.back().second;
+			for (unsigned int k = h.m_begin; k < h.m_end; ++k)
+				hole.push_back(k);
+			if (h.m_area > 0)
+				std::reverse(hole.begin(), hole.end());
+		}
+		std::sort(holes.begin(), holes.end(), [](const std::pair<double, Ring> & a, const std::pair<double, Ring> & b) {
+			return a.first > b.first;
+		});
+		for (const std::pair<double, Ring> & hole : holes) {
+			if (!bridgeHole(points, ring, hole.second))
+				success = false;
+		}
+
+		if (!earClip(points, ring, triangles))
+			success = false;
+	}
+	return success;
+}
+
+} // namespace HatchTessellation
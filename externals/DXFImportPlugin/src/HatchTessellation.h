@@ -0,0 +1,46 @@
+#ifndef HatchTessellationH
+#define HatchTessellationH
+
+#include <vector>
+
+#include <IBKMK_Vector2D.h>
+
+/*! Tessellation of hatch boundary loops and triangulation of solid fills.
+
+	Boundary loops are closed polygons whose segments are straight lines or circular arcs given
+	by their bulge (as in DXF polylines). Arcs are tessellated with CurveTessellation.
+
+	Fills are triangulated by ear clipping. Loops are classified by their nesting depth (DXF
+	hatch style 'normal'): loops with even depth are outer boundaries, loops with odd depth are
+	holes of the innermost loop containing them. Holes are connected to their outer boundary
+	by bridge edges, the resulting simple polygon is then clipped ear by ear. Only reflex
+	vertices need to be tested against candidate ears, which keeps the common case of
+	hatches with mostly convex boundaries close to linear.
+
+	All functions are reentrant, hatches can be processed in parallel.
+*/
+namespace HatchTessellation {
+
+/*! Tessellates a closed loop and appends the points to 'points'. The closing point is not repeated.
+	\param vertices Loop vertices.
+	\param bulges Bulge of the segment starting at the vertex with the same index, empty if all segments
+		are straight. Bulge is the tangent of a quarter of the included angle, positive for counter-clockwise arcs.
+	\param maxDeviation Maximum distance between chords and arcs in drawing units.
+*/
+void tessellateLoop(const std::vector<IBKMK::Vector2D> & vertices, const std::vector<double> & bulges,
+					double maxDeviation, std::vector<IBKMK::Vector2D> & points);
+
+/*! Triangulates the area enclosed by the given loops.
+	\param points Points of all loops.
+	\param loopOffsets Loop i consists of points [loopOffsets[i], loopOffsets[i+1]), hence the vector
+		holds one entry more than there are loops.
+	\param triangles Receives 3 indexes into points per triangle, counter-clockwise.
+	\return False if parts of the area could not be triangulated (self-intersecting loops), the
+		triangles generated so far are kept.
+*/
+bool triangulate(const std::vector<IBKMK::Vector2D> & points, const std::vector<unsigned int> & loopOffsets,
+				 std::vector<unsigned int> & triangles);
+
+} // namespace HatchTessellation
+
+#endif // HatchTessellationH
@@ -1,11 +1,19 @@
 #include "ImportDXFDialog.h"
 #include "ui_ImportDXFDialog.h"
+#include "Constants.h"
+#include "CurveTessellation.h"
 
 #include <QMessageBox>
+#include <QFile>
 #include <QFileInfo>
 #include <QTimer>
+#include <QRegExp>
+#include <QMenu>
 
 #include <regex>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
 
 #include <IBK_physics.h>
 #include <IBK_messages.h>
@@ -33,6 +41,13 @@ ImportDXFDialog::ImportDXFDialog(QWidget *parent) :
 	m_ui->comboBoxUnit->addItem(tr("Centimeter"), SU_Centimeter);
 	m_ui->comboBoxUnit->addItem(tr("Millimeter"), SU_Millimeter);
 
+	// layers of the file are added by scanDxfFile()
+	QMenu *layerMenu = new QMenu(this);
+	m_ui->toolButtonImportLayers->setMenu(layerMenu);
+	m_ui->toolButtonImportLayers->setEnabled(false);
+	connect(layerMenu, &QMenu::aboutToShow, this, &ImportDXFDialog::updateLayerMenu);
+	connect(layerMenu, &QMenu::triggered, this, &ImportDXFDialog::layerMenuTriggered);
+
 	// we start with simple mode
 	m_ui->checkBoxShowDetails->setChecked(false);
 	m_detailedMode = false;
@@ -66,6 +81,7 @@ ImportDXFDialog::ImportResults ImportDXFDialog::importFile(const QString &fname)
 		m_ui->pushButtonImport->setEnabled(false);
 
 	m_filePath = fname;
+	scanDxfFile();
 
 	QFileInfo finfo(fname);
 	m_ui->lineEditDrawingName->setText(finfo.fileName());
@@ -93,9 +109,68 @@ ImportDXFDialog::ImportResults ImportDXFDialog::importFile(const QString &fname)
 }
 
 
-void ImportDXFDialog::on_pushButtonConvert_clicked() {
-	FUNCID(ImportDXFDialog::on_pushButtonConvert_clicked);
+/*! Factor to meters for each ScaleUnit, auto scaling defaults to millimeters. */
+static const double UNIT_SCALING_FACTORS[ImportDXFDialog::NUM_SU] = {0.001, 1.0, 0.1, 0.01, 0.001};
+
+
+/*! Returns the unit in which a drawing of the given size (in file units) falls into the
+	auto-scaling thresholds, NUM_SU if there is none. scalingFactor holds the factor to meters
+	for each unit.
+*/
+static ImportDXFDialog::ScaleUnit autoScalingUnit(double width, double height, const double scalingFactor[]) {
+	// Drawing should be at least bigger than 150 m
+	double AUTO_SCALING_MIN_THRESHOLD =	  800;
+	double AUTO_SCALING_MAX_THRESHOLD =  2000;
+
+	for (unsigned int i=1; i<ImportDXFDialog::NUM_SU; ++i) { // skip auto scaling
+
+		if (scalingFactor[i] * width > AUTO_SCALING_MIN_THRESHOLD)
+			continue;
+
+		if (scalingFactor[i] * height > AUTO_SCALING_MIN_THRESHOLD)
+			continue;
+
+		return (ImportDXFDialog::ScaleUnit)i;
+	}
+
+	for (unsigned int i=ImportDXFDialog::SU_Millimeter; i>0; --i) {
+
+		if (scalingFactor[i] * width < AUTO_SCALING_MAX_THRESHOLD)
+			continue;
+
+		if (scalingFactor[i] * height < AUTO_SCALING_MAX_THRESHOLD)
+			continue;
+
+		return (ImportDXFDialog::ScaleUnit)i;
+	}
+	return ImportDXFDialog::NUM_SU;
+}
+
+
+/*! Returns the trimmed, non-empty entries of a comma separated list of layer patterns. */
+static QStringList layerPatterns(const QString &text) {
+	QStringList patterns;
+	for (const QString &pattern : text.split(',', QString::SkipEmptyParts)) {
+		QString trimmed = pattern.trimmed();
+		if (!trimmed.isEmpty())
+			patterns << trimmed;
+	}
+	return patterns;
+}
+
 
+/*! Returns true if name matches one of the wildcard patterns (case insensitive). */
+static bool matchesLayerPattern(const QStringList &patterns, const QString &name) {
+	for (const QString &pattern : patterns) {
+		QRegExp rx(pattern, Qt::CaseInsensitive, QRegExp::Wildcard);
+		if (rx.exactMatch(name))
+			return true;
+	}
+	return false;
+}
+
+
+void ImportDXFDialog::on_pushButtonConvert_clicked() {
 	setEnabled(false);
 	m_ui->progressBar->setEnabled(true);
 	m_ui->progressBar->setRange(0,4);
@@ -111,30 +186,73 @@ void ImportDXFDialog::on_pushButtonConvert_clicked() {
 		log += "File " + fileName.fileName() + " does not exist! Aborting Conversion.\n";
 	}
 
-	bool success;
+	bool success = false;
 	try {
-		// we clear the drawing
-		m_drawing = Drawing();
-		m_drawing.m_id = 1;
-		m_nextId = 3;
-
-		success = readDxfFile(m_drawing, fileName.fileName());
-
-		m_ui->progressBar->setValue(2);
-		m_ui->progressBar->setFormat("Update References %p%");
-
-		// we need to generate inserted geometries here only in order to find the correct drawing center!
+		ConvertOptions options;
+		options.m_importText = m_ui->checkBoxImportText->isChecked();
+		if (m_ui->checkBoxImportLayers->isChecked())
+			options.m_importLayers = m_ui->lineEditImportLayers->text();
+		options.m_unit = (ScaleUnit)m_ui->comboBoxUnit->currentData().toInt();
+		if (m_ui->checkBoxSimplifyPolylines->isChecked())
+			options.m_simplifyTolerance = POLYLINE_SIMPLIFICATION_TOLERANCE;
+		if (m_ui->checkBoxRemoveDuplicateLines->isChecked()) {
+			options.m_deduplicateTolerance = LINE_DEDUPLICATION_TOLERANCE;
+			options.m_deduplicateLayers = m_ui->lineEditDuplicateLayers->text();
+		}
 
-		m_drawing.sortLayersAlphabetical();
-		m_drawing.updateParents();
+		options.m_stepFinished = [this](const char *step) {
+			if (std::strcmp(step, "read") == 0) {
+				m_ui->progressBar->setValue(2);
+				m_ui->progressBar->setFormat("Update References %p%");
+			}
+			else if (std::strcmp(step, "updatePointer") == 0) {
+				m_ui->progressBar->setValue(3);
+				m_ui->progressBar->setFormat("Calculate bounding box and center %p%");
+			}
+		};
 
-		if (!m_ui->checkBoxImportText->isChecked()) {
-			m_drawing.m_texts.clear();
-			m_drawing.m_linearDimensions.clear();
-		}
+		options.m_chooseScalingFactor = [this](const ConvertResults &results) {
+			std::map<ScaleUnit, std::string> unit {
+				{SU_Meter,  "Meter"},
+				{SU_Centimeter,  "Centimeter"},
+				{SU_Decimeter,  "Decimeter"},
+				{SU_Millimeter,  "Millimeter"},
+			};
+
+			// Create a message box
+			QMessageBox msgBox(this);
+			msgBox.setWindowTitle(tr("Choose scaling factor"));
+			msgBox.setText(tr("Scaling factor from header does not match auto-determined "
+							  "scale factor.\nChoose the scaling factor to use:"));
+
+			// bounding box is given in drawing units
+			IBKMK::Vector3D boundingDxf = results.m_dxfScalingFactor * results.m_bounding;
+			IBKMK::Vector3D boundingAuto = results.m_unitScalingFactor * results.m_bounding;
+
+			// Add two buttons with different scaling factors
+			msgBox.addButton(tr("Auto-determinded: %1\n(%2 to Meters)\nWidht: %3 m\nHeight: %4 m")
+							 .arg(results.m_unitScalingFactor)
+							 .arg(QString::fromStdString(unit[results.m_autoUnit]))
+							 .arg(boundingAuto.m_x, 0, 'f', 2)
+							 .arg(boundingAuto.m_y, 0, 'f', 2), QMessageBox::AcceptRole);
+			QPushButton *button1 = msgBox.addButton(tr("DXF: %1\n(%2 to Meters)\nWidht: %3 m\nHeight: %4 m")
+													.arg(results.m_dxfScalingFactor)
+													.arg(QString::fromStdString(results.m_dxfScalingUnit))
+													.arg(boundingDxf.m_x, 0, 'f', 2)
+													.arg(boundingDxf.m_y, 0, 'f', 2), QMessageBox::AcceptRole);
+
+			// Show the message box and wait for user input
+			msgBox.exec();
+
+			// Determine which button was clicked
+			double scalingFactor = msgBox.clickedButton() == button1 ? results.m_dxfScalingFactor : results.m_unitScalingFactor;
+			qDebug() << "Current scaling factor is: " << scalingFactor;
+			return scalingFactor;
+		};
 
-		if (!success)
-			throw IBK::Exception(IBK::FormatString("Import of DXF-File was not successful!"), FUNC_ID);
+		ConvertResults results;
+		convertDxfFile(fileName.fileName(), m_scanInfo, options, m_drawing, m_nextId, results);
+		success = true;
 
 		// set name for drawing from lineEdit
 		m_drawing.m_displayName = m_ui->lineEditDrawingName->text();
@@ -152,128 +270,52 @@ void ImportDXFDialog::on_pushButtonConvert_clicked() {
 		log += QString("Dimension Styles:\t%1\n").arg(m_drawing.m_dimensionStyles.size());
 		log += QString("Inserts:\t\t%1\n").arg(m_drawing.m_inserts.size());
 		log += QString("Solids:\t\t%1\n").arg(m_drawing.m_solids.size());
+		log += QString("Hatches:\t\t%1\n").arg(m_drawing.m_hatches.size());
+		log += QString("Splines:\t\t%1\n").arg(m_drawing.m_splines.size());
 		log += QString("---------------------------------------------------------\n");
 
-		ScaleUnit su = (ScaleUnit)m_ui->comboBoxUnit->currentData().toInt();
-
-		double scalingFactor[NUM_SU] = {0.001, 1.0, 0.1, 0.01, 0.001};
-
-		std::map<ScaleUnit, std::string> unit {
-			{SU_Meter,  "Meter"},
-			{SU_Centimeter,  "Centimeter"},
-			{SU_Decimeter,  "Decimeter"},
-			{SU_Millimeter,  "Millimeter"},
-		};
-
-		m_ui->progressBar->setValue(3);
-		m_ui->progressBar->setFormat("Calculate bounding box and center %p%");
-
-		IBKMK::Vector3D dummy;
-		m_drawing.updatePointer();
-		IBKMK::Vector3D bounding = boundingBox(&m_drawing, dummy, false, 1.0);
-
-		// compensate coordinates
-		// m_drawing.compensateCoordinates();
-
-		// calculate center
-		if (m_drawing.m_offset == IBKMK::Vector3D()) {
-			IBKMK::Vector3D center = m_drawing.weightedCenterMedian(m_nextId);
-			m_drawing.m_offset = -1.0 * center;
-		}
-
-		// Drawing should be at least bigger than 150 m
-		double AUTO_SCALING_MIN_THRESHOLD =	  800;
-		double AUTO_SCALING_MAX_THRESHOLD =  2000;
-		std::string foundUnit;
-		if (su == SU_Auto) {
-			bool foundAutoScaling = false;
-			for (unsigned int i=1; i<NUM_SU; ++i) { // skip auto scaling
-
-				if (scalingFactor[i] * bounding.m_x > AUTO_SCALING_MIN_THRESHOLD)
-					continue;
-
-				if (scalingFactor[i] * bounding.m_y > AUTO_SCALING_MIN_THRESHOLD)
-					continue;
-
-				scalingFactor[SU_Auto] = scalingFactor[i];
-				foundUnit = unit[(ScaleUnit)i];
-				foundAutoScaling = true;
-				break;
-			}
-
-			if (!foundAutoScaling) {
-				for (unsigned int i=SU_Millimeter; i>0; --i) {
-
-					if (scalingFactor[i] * bounding.m_x < AUTO_SCALING_MAX_THRESHOLD)
-						continue;
-
-					if (scalingFactor[i] * bounding.m_y < AUTO_SCALING_MAX_THRESHOLD)
-						continue;
-
-					scalingFactor[SU_Auto] = scalingFactor[i];
-					foundUnit = unit[(ScaleUnit)i];
-					foundAutoScaling = true;
-					break;
-				}
-			}
-
-			if (foundAutoScaling) {
-				log += QString("Found auto scaling unit: %1 m\n").arg(scalingFactor[SU_Auto]);
-				if (!IBK::near_equal(scalingFactor[SU_Auto], m_dxfScalingFactor)) {
+		if (options.m_unit == SU_Auto) {
+			if (results.m_autoUnit != NUM_SU) {
+				log += QString("Found auto scaling unit: %1 m\n").arg(results.m_unitScalingFactor);
+				if (!IBK::near_equal(results.m_unitScalingFactor, results.m_dxfScalingFactor))
 					log += QString("Scaling factor from header does not match auto-determined scale factor.\n");
-
-					// Create a message box
-					QMessageBox msgBox(this);
-					msgBox.setWindowTitle(tr("Choose scaling factor"));
-					msgBox.setText(tr("Scaling factor from header does not match auto-determined "
-									  "scale factor.\nChoose the scaling factor to use:"));
-
-					IBKMK::Vector3D boundingDxf = boundingBox(&m_drawing, dummy, false, m_dxfScalingFactor);
-					IBKMK::Vector3D boundingAuto = boundingBox(&m_drawing, dummy, false, scalingFactor[SU_Auto]);
-
-					// Add two buttons with different scaling factors
-					QPushButton *button2 = msgBox.addButton(tr("Auto-determinded: %1\n(%2 to Meters)\nWidht: %3 m\nHeight: %4 m")
-															.arg(scalingFactor[SU_Auto])
-															.arg(QString::fromStdString(foundUnit))
-															.arg(boundingAuto.m_x, 0, 'f', 2)
-															.arg(boundingAuto.m_y, 0, 'f', 2), QMessageBox::AcceptRole);
-					QPushButton *button1 = msgBox.addButton(tr("DXF: %1\n(%2 to Meters)\nWidht: %3 m\nHeight: %4 m")
-															.arg(m_dxfScalingFactor)
-															.arg(QString::fromStdString(m_dxfScalingUnit))
-															.arg(boundingDxf.m_x, 0, 'f', 2)
-															.arg(boundingDxf.m_y, 0, 'f', 2), QMessageBox::AcceptRole);
-
-					// msgBox.setFixedWidth(1500);
-					// Show the message box and wait for user input
-					msgBox.exec();
-
-					// Determine which button was clicked
-					if (msgBox.clickedButton() == button1)
-						m_drawing.m_scalingFactor = m_dxfScalingFactor;
-					else if (msgBox.clickedButton() == button2)
-						m_drawing.m_scalingFactor = scalingFactor[SU_Auto];
-
-					qDebug() << "Current scaling factor is: " << m_drawing.m_scalingFactor;
-				}
 			}
 			else
-				log += QString("Could not find auto scaling unit. Taking: %1 m\n").arg(scalingFactor[SU_Auto]);
+				log += QString("Could not find auto scaling unit. Taking: %1 m\n").arg(results.m_unitScalingFactor);
 		}
-		else
-			m_drawing.m_scalingFactor = scalingFactor[su];
 
-		log += QString("Current dimensions - X: %1 Y: %2 Z: %3\n").arg(scalingFactor[su] * bounding.m_x)
-				.arg(scalingFactor[su] * bounding.m_y)
-				.arg(scalingFactor[su] * bounding.m_z);
+		double scalingFactor = results.m_unitScalingFactor;
+		log += QString("Current dimensions - X: %1 Y: %2 Z: %3\n").arg(scalingFactor * results.m_bounding.m_x)
+				.arg(scalingFactor * results.m_bounding.m_y)
+				.arg(scalingFactor * results.m_bounding.m_z);
 
+		// the offset has been scaled with the scaling factor of the drawing
 		log += QString("Current center - X: %1 Y: %2 Z: %3\n")
-				.arg(scalingFactor[su] * m_drawing.m_offset.m_x,
-					 scalingFactor[su] * m_drawing.m_offset.m_y,
-					 scalingFactor[su] * m_drawing.m_offset.m_z);
+				.arg(m_drawing.m_offset.m_x).arg(m_drawing.m_offset.m_y).arg(m_drawing.m_offset.m_z);
 		log += QString("---------------------------------------------------------\n");
-		log += QString("\nPLEASE MIND: Currently are no hatchings supported.\n");
 
-		m_drawing.m_offset *= m_drawing.m_scalingFactor;
+		if (options.m_simplifyTolerance > 0) {
+			const PolylineSimplification::Statistics &stats = results.m_simplifyStats;
+			log += QString("Polyline simplification (tolerance %1 m):\n").arg(options.m_simplifyTolerance);
+			log += QString("Simplified polylines:\t%1 of %2\n").arg(stats.m_modifiedPolylines).arg(stats.m_polylines);
+			log += QString("Vertices:\t\t%1 -> %2\n").arg(stats.m_vertices).arg(stats.remainingVertices());
+			log += QString("Duplicates removed:\t%1\n").arg(stats.m_duplicates);
+			log += QString("Collinear removed:\t%1\n").arg(stats.m_collinear);
+			log += QString("Simplification removed:\t%1\n").arg(stats.m_simplified);
+			log += QString("---------------------------------------------------------\n");
+		}
+
+		if (options.m_deduplicateTolerance > 0) {
+			const LineDeduplication::Statistics &stats = results.m_deduplicateStats;
+			log += QString("Duplicate line removal (tolerance %1 m):\n").arg(options.m_deduplicateTolerance);
+			if (!layerPatterns(options.m_deduplicateLayers).isEmpty())
+				log += QString("Layers:\t\t%1 matching '%2'\n").arg(results.m_deduplicateLayerCount).arg(options.m_deduplicateLayers);
+			log += QString("Lines:\t\t%1 -> %2\n").arg(stats.m_lines).arg(stats.m_lines - stats.removed());
+			log += QString("Duplicates removed:\t%1\n").arg(stats.m_duplicates);
+			log += QString("Covered removed:\t%1\n").arg(stats.m_covered);
+			log += QString("Overlaps joined:\t%1\n").arg(stats.m_merged);
+			log += QString("---------------------------------------------------------\n");
+		}
 
 	} catch (IBK::Exception &ex) {
 
@@ -353,17 +395,211 @@ void ImportDXFDialog::updateImportButtonEnabledState() {
 }
 
 
-bool ImportDXFDialog::readDxfFile(Drawing &drawing, const QString &fname) {
-	DRW_InterfaceImpl drwIntImpl(&drawing, &m_dxfScalingFactor, &m_dxfScalingUnit, m_nextId);
-	//	dxfRW dxf(fname.toStdString().c_str());
-	dxfRW dxf(fname.toStdString());
+void ImportDXFDialog::convertDxfFile(const QString &fname, const DRW_ScanInfo &scanInfo, const ConvertOptions &options,
+									 Drawing &drawing, unsigned int &nextId, ConvertResults &results)
+{
+	FUNCID(ImportDXFDialog::convertDxfFile);
+
+	// we clear the drawing
+	drawing = Drawing();
+	drawing.m_id = 1;
+	nextId = 3;
+	results = ConvertResults();
+
+	// *** read ***
+	{
+		DRW_InterfaceImpl drwIntImpl(&drawing, &results.m_dxfScalingFactor, &results.m_dxfScalingUnit, nextId);
+		dxfRW dxf(fname.toStdString());
+
+		// entities have been counted by the quick scan, so that the drawing vectors are allocated only once
+		drwIntImpl.reserveFromScan(scanInfo);
+
+		// only the unit is taken from the header
+		dxf.setHeaderFilter({"$INSUNITS"});
+
+		// texts and dimensions are skipped while reading
+		if (!options.m_importText)
+			dxf.setEntityFilter({"TEXT", "MTEXT", "DIMENSION"});
+
+		// layers are selected by comma separated wildcard patterns from the layers found by the quick scan
+		QStringList patterns = layerPatterns(options.m_importLayers);
+		if (!patterns.isEmpty()) {
+			std::vector<std::string> layerNames;
+			for (const std::string &layer : scanInfo.layers) {
+				if (matchesLayerPattern(patterns, QString::fromStdString(layer)))
+					layerNames.push_back(layer);
+			}
+			if (layerNames.empty())
+				throw IBK::Exception(IBK::FormatString("No layer matches '%1'.")
+									 .arg(options.m_importLayers.toStdString()), FUNC_ID);
+			dxf.setLayerFilter(layerNames);
+		}
+
+		if (!dxf.read(&drwIntImpl, false))
+			throw IBK::Exception(IBK::FormatString("Import of DXF-File was not successful!"), FUNC_ID);
+	}
+	if (options.m_stepFinished)
+		options.m_stepFinished("read");
+
+	// *** update references ***
+	// we need to generate inserted geometries here only in order to find the correct drawing center!
+	drawing.sortLayersAlphabetical();
+	drawing.updateParents();
+	if (options.m_stepFinished)
+		options.m_stepFinished("references");
+
+	drawing.updatePointer();
+	if (options.m_stepFinished)
+		options.m_stepFinished("updatePointer");
+
+	// *** bounding box and scaling factor, the new drawing is still unscaled ***
+	IBKMK::Vector3D dummy;
+	results.m_bounding = boundingBox(&drawing, dummy, false, 1.0);
+
+	results.m_unitScalingFactor = UNIT_SCALING_FACTORS[options.m_unit];
+	if (options.m_unit == SU_Auto) {
+		results.m_autoUnit = autoScalingUnit(results.m_bounding.m_x, results.m_bounding.m_y, UNIT_SCALING_FACTORS);
+		if (results.m_autoUnit != NUM_SU)
+			results.m_unitScalingFactor = UNIT_SCALING_FACTORS[results.m_autoUnit];
+	}
+	// with SU_Auto the auto determined factor (or the default one, if none was found) is used, like the log says
+	double scalingFactor = results.m_unitScalingFactor;
+	if (results.m_autoUnit != NUM_SU && !IBK::near_equal(results.m_unitScalingFactor, results.m_dxfScalingFactor) &&
+		options.m_chooseScalingFactor)
+	{
+		scalingFactor = options.m_chooseScalingFactor(results);
+	}
+	if (options.m_stepFinished)
+		options.m_stepFinished("bounds");
+
+	// *** center, in drawing units, the offset is scaled at the end ***
+	if (drawing.m_offset == IBKMK::Vector3D()) {
+		IBKMK::Vector3D center = drawing.weightedCenterMedian(nextId);
+		drawing.m_offset = -1.0 * center;
+	}
+	if (options.m_stepFinished)
+		options.m_stepFinished("center");
+
+	drawing.m_scalingFactor = scalingFactor;
+
+	// *** polyline simplification, tolerance depends on the scaling factor ***
+	if (options.m_simplifyTolerance > 0) {
+		drawing.simplifyPolylines(options.m_simplifyTolerance, results.m_simplifyStats);
+		if (options.m_stepFinished)
+			options.m_stepFinished("simplify");
+	}
+
+	// *** duplicate line removal ***
+	if (options.m_deduplicateTolerance > 0) {
+		// layers are selected by comma separated wildcard patterns, all layers if empty
+		std::set<QString> layerNames;
+		QStringList patterns = layerPatterns(options.m_deduplicateLayers);
+		for (const DrawingLayer &dl : drawing.m_drawingLayers) {
+			if (matchesLayerPattern(patterns, dl.m_displayName))
+				layerNames.insert(dl.m_displayName);
+		}
+		results.m_deduplicateLayerCount = layerNames.size();
+
+		if (patterns.isEmpty() || !layerNames.empty()) {
+			drawing.removeDuplicateLines(options.m_deduplicateTolerance, layerNames, results.m_deduplicateStats);
+			drawing.updatePointer();
+		}
+		if (options.m_stepFinished)
+			options.m_stepFinished("deduplicate");
+	}
+
+	// *** spline tessellation ***
+	// curves depend on the scaling factor, pointers have been updated above. Hatch outlines are tessellated
+	// with the line geometries, fills are only triangulated on request, see Drawing::Hatch::triangles()
+	drawing.tessellateSplines();
+	if (options.m_stepFinished)
+		options.m_stepFinished("splines");
+
+	drawing.m_offset *= drawing.m_scalingFactor;
+}
+
+// defined below
+std::pair<std::string, double> getUnitInfo(int insunits);
+
+void ImportDXFDialog::scanDxfFile() {
+	m_scanInfo = DRW_ScanInfo();
+	QMenu *layerMenu = m_ui->toolButtonImportLayers->menu();
+	layerMenu->clear();
+	m_ui->toolButtonImportLayers->setEnabled(false);
+
+	dxfRW dxf(m_filePath.toStdString());
+	if (!dxf.scan(&m_scanInfo))
+		return;
+
+	QString log = "File overview:\n";
+	log += QString("---------------------------------------------------------\n");
+
+	// units of the combo box, which can be given in the header
+	ScaleUnit headerUnit = NUM_SU;
+	const DRW_Variant *insunits = m_scanInfo.header.get("$INSUNITS");
+	if (insunits != nullptr && insunits->type() == DRW_Variant::INTEGER) {
+		log += QString("Units from header:\t%1\n").arg(QString::fromStdString(getUnitInfo(insunits->content.i).first));
+		switch (insunits->content.i) {
+			case 4:		headerUnit = SU_Millimeter; break;
+			case 5:		headerUnit = SU_Centimeter; break;
+			case 6:		headerUnit = SU_Meter; break;
+			case 14:	headerUnit = SU_Decimeter; break;
+			default: ;
+		}
+	}
+
+	// extents are only valid if the file was saved with updated extents
+	ScaleUnit extentsUnit = NUM_SU;
+	const DRW_Variant *extMin = m_scanInfo.header.get("$EXTMIN");
+	const DRW_Variant *extMax = m_scanInfo.header.get("$EXTMAX");
+	if (extMin != nullptr && extMax != nullptr &&
+		extMin->type() == DRW_Variant::COORD && extMax->type() == DRW_Variant::COORD &&
+		extMax->content.v->x >= extMin->content.v->x && extMax->content.v->y >= extMin->content.v->y)
+	{
+		double width = extMax->content.v->x - extMin->content.v->x;
+		double height = extMax->content.v->y - extMin->content.v->y;
+		log += QString("Extents from header:\t%1 x %2\n").arg(width).arg(height);
+		extentsUnit = autoScalingUnit(width, height, UNIT_SCALING_FACTORS);
+		if (extentsUnit != NUM_SU)
+			log += QString("Suggested unit:\t%1\n").arg(m_ui->comboBoxUnit->itemText(m_ui->comboBoxUnit->findData(extentsUnit)));
+	}
+
+	// header unit is preselected unless the extents suggest another one, then the unit is determined
+	// after reading (auto scaling asks, which factor to use)
+	ScaleUnit su = SU_Auto;
+	if (headerUnit != NUM_SU && (extentsUnit == NUM_SU || extentsUnit == headerUnit))
+		su = headerUnit;
+	else if (headerUnit == NUM_SU && extentsUnit != NUM_SU)
+		su = extentsUnit;
+	else if (headerUnit != NUM_SU)
+		log += QString("Units from header and extents do not match, unit is determined after reading.\n");
+	m_ui->comboBoxUnit->setCurrentIndex(m_ui->comboBoxUnit->findData(su));
+
+	QStringList layers;
+	for (const std::string &layer : m_scanInfo.layers) {
+		QString name = QString::fromStdString(layer);
+		layers << name;
+		QAction *action = layerMenu->addAction(QString(name).replace("&", "&&"));
+		action->setData(name);
+		action->setCheckable(true);
+	}
+	m_ui->toolButtonImportLayers->setEnabled(!layers.isEmpty());
+	log += QString("Layers:\t\t%1 (%2)\n").arg(m_scanInfo.layers.size()).arg(layers.join(", "));
+	log += QString("Blocks:\t\t%1\n").arg(m_scanInfo.blocks);
+	for (const auto &entity : m_scanInfo.entities) {
+		// polyline vertices are no entities of their own
+		if (entity.first == "VERTEX" || entity.first == "SEQEND")
+			continue;
+		log += QString("%1:\t\t%2\n").arg(QString::fromStdString(entity.first)).arg(entity.second);
+	}
+	log += QString("---------------------------------------------------------\n");
 
-	bool success = dxf.read(&drwIntImpl, false);
-	return success;
+	m_ui->plainTextEditLogWindow->setPlainText(log);
 }
 
+
 template <typename t>
-void movePoints(const IBKMK::Vector2D &center, std::vector<t> &objects) {
+void movePoints(const IBKMK::Vector2D &center, ChunkedVector<t> &objects) {
 	for (Drawing::AbstractDrawingObject &obj: objects) {
 		for (const IBKMK::Vector2D &v2D : obj.points2D()) {
 			const_cast<IBKMK::Vector2D &>(v2D) -= center;
@@ -390,72 +626,11 @@ const Drawing& ImportDXFDialog::drawing() const {
 }
 
 
-template <typename t>
-void drawingBoundingBox(const Drawing &d,
-						const std::vector<t> &drawingObjects,
-						IBKMK::Vector3D &upperValues,
-						IBKMK::Vector3D &lowerValues,
-						const IBKMK::Vector3D &offset = IBKMK::Vector3D(0,0,0),
-						const IBKMK::Vector3D &xAxis = IBKMK::Vector3D(1,0,0),
-						const IBKMK::Vector3D &yAxis = IBKMK::Vector3D(0,1,0),
-						const IBKMK::Vector3D &zAxis = IBKMK::Vector3D(0,0,1)) {
-
-	// store selected surfaces
-	if (drawingObjects.empty())
-		return;
-
-	// process all drawings
-	for (const t &drawObj : drawingObjects) {
-		const DrawingLayer *dl = dynamic_cast<const DrawingLayer *>(drawObj.m_layerRef);
-
-		Q_ASSERT(dl != nullptr);
-
-		if (!dl->m_visible)
-			continue;
-
-		if (dl->m_displayName == "0")
-			continue; // Skipping historic layer 0 for better bounding box results
-
-		const std::vector<IBKMK::Vector3D> &points = d.points3D(drawObj.points2D(), drawObj);
-
-		for (const IBKMK::Vector3D &v : points) {
-
-			IBKMK::Vector3D vLocal, point;
-
-			IBKMK::lineToPointDistance(offset, xAxis, v, vLocal.m_x, point);
-			IBKMK::lineToPointDistance(offset, yAxis, v, vLocal.m_y, point);
-			IBKMK::lineToPointDistance(offset, zAxis, v, vLocal.m_z, point);
-
-			upperValues.m_x = std::max(upperValues.m_x, (double)vLocal.m_x);
-			upperValues.m_y = std::max(upperValues.m_y, (double)vLocal.m_y);
-			upperValues.m_z = std::max(upperValues.m_z, (double)vLocal.m_z);
-
-			lowerValues.m_x = std::min(lowerValues.m_x, (double)vLocal.m_x);
-			lowerValues.m_y = std::min(lowerValues.m_y, (double)vLocal.m_y);
-			lowerValues.m_z = std::min(lowerValues.m_z, (double)vLocal.m_z);
-		}
-	}
-}
-
-
 IBKMK::Vector3D ImportDXFDialog::boundingBox(const Drawing *drawing, IBKMK::Vector3D & center, bool transformPoints, const double scalingFactor = 1.0) {
 
-	IBKMK::Vector3D lowerValues(std::numeric_limits<double>::max(),
-								std::numeric_limits<double>::max(),
-								std::numeric_limits<double>::max());
-	IBKMK::Vector3D upperValues(std::numeric_limits<double>::lowest(),
-								std::numeric_limits<double>::lowest(),
-								std::numeric_limits<double>::lowest());
-
-	drawingBoundingBox<Drawing::Arc>(*drawing, drawing->m_arcs, upperValues, lowerValues);
-	drawingBoundingBox<Drawing::Circle>(*drawing, drawing->m_circles, upperValues, lowerValues);
-	drawingBoundingBox<Drawing::Ellipse>(*drawing, drawing->m_ellipses, upperValues, lowerValues);
-	drawingBoundingBox<Drawing::Line>(*drawing, drawing->m_lines, upperValues, lowerValues);
-	drawingBoundingBox<Drawing::PolyLine>(*drawing, drawing->m_polylines, upperValues, lowerValues);
-	drawingBoundingBox<Drawing::Point>(*drawing, drawing->m_points, upperValues, lowerValues);
-	drawingBoundingBox<Drawing::Solid>(*drawing, drawing->m_solids, upperValues, lowerValues);
-	drawingBoundingBox<Drawing::Text>(*drawing, drawing->m_texts, upperValues, lowerValues);
-	drawingBoundingBox<Drawing::LinearDimension>(*drawing, drawing->m_linearDimensions, upperValues, lowerValues);
+	// bounds are cached per layer in the drawing
+	IBKMK::Vector3D lowerValues, upperValues;
+	drawing->boundingBox(lowerValues, upperValues);
 
 	// center point of bounding box
 	center = 0.5 * scalingFactor * (lowerValues+upperValues);
@@ -469,6 +644,29 @@ void ImportDXFDialog::on_comboBoxUnit_activated(int index) {
 }
 
 
+void ImportDXFDialog::updateLayerMenu() {
+	QStringList patterns = layerPatterns(m_ui->lineEditImportLayers->text());
+	for (QAction *action : m_ui->toolButtonImportLayers->menu()->actions())
+		action->setChecked(patterns.contains(action->data().toString()));
+}
+
+
+void ImportDXFDialog::layerMenuTriggered(QAction *action) {
+	// typed wildcard patterns are kept, only the name of the layer is added or removed
+	QStringList patterns = layerPatterns(m_ui->lineEditImportLayers->text());
+	QString name = action->data().toString();
+	if (action->isChecked()) {
+		if (!patterns.contains(name))
+			patterns << name;
+	}
+	else
+		patterns.removeAll(name);
+
+	m_ui->lineEditImportLayers->setText(patterns.join(", "));
+	m_ui->checkBoxImportLayers->setChecked(!patterns.isEmpty());
+}
+
+
 DRW_InterfaceImpl::DRW_InterfaceImpl(Drawing *drawing, double *dxfScalingFactor,
 									 std::string *dxfScalingUnit, unsigned int &nextId) :
 	m_drawing(drawing),
@@ -477,6 +675,67 @@ DRW_InterfaceImpl::DRW_InterfaceImpl(Drawing *drawing, double *dxfScalingFactor,
 	m_dxfScalingUnit(dxfScalingUnit)
 {}
 
+
+/*! Drawing collections reserved by DRW_InterfaceImpl. */
+enum ReserveType {
+	T_Layer, T_DimStyle, T_Block, T_Point, T_Line, T_Polyline, T_Circle, T_Ellipse,
+	T_Arc, T_Solid, T_Hatch, T_Spline, T_Text, T_Dimension, T_Insert, NUM_T
+};
+
+/*! Record names of dxf entities/table entries and the collection they are stored in. */
+static const struct {
+	const char *	name;
+	ReserveType		type;
+} RESERVE_TYPES[] = {
+	{"LINE", T_Line}, {"LWPOLYLINE", T_Polyline}, {"POLYLINE", T_Polyline}, {"ARC", T_Arc},
+	{"CIRCLE", T_Circle}, {"TEXT", T_Text}, {"MTEXT", T_Text}, {"INSERT", T_Insert},
+	{"POINT", T_Point}, {"SOLID", T_Solid}, {"ELLIPSE", T_Ellipse}, {"DIMENSION", T_Dimension},
+	{"HATCH", T_Hatch}, {"SPLINE", T_Spline},
+	{"LAYER", T_Layer}, {"DIMSTYLE", T_DimStyle}, {"BLOCK", T_Block}
+};
+
+
+bool DRW_InterfaceImpl::reserveFromScan(const DRW_ScanInfo &info) {
+	if (!info.complete)
+		return false;
+
+	std::size_t counts[NUM_T] = {0};
+	for (const auto &t : RESERVE_TYPES) {
+		if (t.type == T_Block)
+			counts[t.type] += info.blocks;
+		else if (t.type == T_Layer || t.type == T_DimStyle) {
+			auto it = info.tableEntries.find(t.name);
+			if (it != info.tableEntries.end())
+				counts[t.type] += it->second;
+		}
+		else
+			counts[t.type] += info.count(t.name);
+	}
+
+	reserve(counts);
+	return true;
+}
+
+
+void DRW_InterfaceImpl::reserve(const std::size_t counts[]) {
+	m_drawing->m_drawingLayers.reserve(m_drawing->m_drawingLayers.size() + counts[T_Layer] + 1); // +1 for default layer '0'
+	m_drawing->m_dimensionStyles.reserve(m_drawing->m_dimensionStyles.size() + counts[T_DimStyle]);
+	m_drawing->m_blocks.reserve(m_drawing->m_blocks.size() + counts[T_Block]);
+	m_drawing->m_points.reserve(m_drawing->m_points.size() + counts[T_Point]);
+	m_drawing->m_lines.reserve(m_drawing->m_lines.size() + counts[T_Line]);
+	m_drawing->m_polylines.reserve(m_drawing->m_polylines.size() + counts[T_Polyline]);
+	m_drawing->m_circles.reserve(m_drawing->m_circles.size() + counts[T_Circle]);
+	m_drawing->m_ellipses.reserve(m_drawing->m_ellipses.size() + counts[T_Ellipse]);
+	m_drawing->m_arcs.reserve(m_drawing->m_arcs.size() + counts[T_Arc]);
+	m_drawing->m_solids.reserve(m_drawing->m_solids.size() + counts[T_Solid]);
+	m_drawing->m_hatches.reserve(m_drawing->m_hatches.size() + counts[T_Hatch]);
+	m_drawing->m_splines.reserve(m_drawing->m_splines.size() + counts[T_Spline]);
+	m_drawing->m_texts.reserve(m_drawing->m_texts.size() + counts[T_Text]);
+	// only linear dimensions are imported, so this is an upper bound
+	m_drawing->m_linearDimensions.reserve(m_drawing->m_linearDimensions.size() + counts[T_Dimension]);
+	m_drawing->m_inserts.reserve(m_drawing->m_inserts.size() + counts[T_Insert]);
+}
+
 // Function to get the unit name and scaling factor relative to meters from INSUNITS value
 std::pair<std::string, double> getUnitInfo(int insunits) {
 	// INSUNITS value to units mapping
@@ -514,10 +773,7 @@ std::pair<std::string, double> getUnitInfo(int insunits) {
 }
 
 void DRW_InterfaceImpl::addHeader(const DRW_Header* data){
-	if (data->vars.find("$INSUNITS") == data->vars.end())
-		return;
-
-	DRW_Variant *var = data->vars.at("$INSUNITS");
+	const DRW_Variant *var = data->vars.get("$INSUNITS");
 	if (var == nullptr)
 		return;
 
@@ -564,7 +820,7 @@ void DRW_InterfaceImpl::addLayer(const DRW_Layer& data){
 	//		newLayer.m_color = SVStyle::instance().m_defaultDrawingColor;
 
 	// Push new layer into vector<Layer*> m_layer
-	m_drawing->m_drawingLayers.push_back(newLayer);
+	m_drawing->m_drawingLayers.push_back(std::move(newLayer));
 }
 
 
@@ -585,7 +841,7 @@ void DRW_InterfaceImpl::addDimStyle(const DRW_Dimstyle& data) {
 	dimStyle.m_id = (*m_nextId)++;
 
 	// Add object
-	m_drawing->m_dimensionStyles.push_back(dimStyle);
+	m_drawing->m_dimensionStyles.push_back(std::move(dimStyle));
 }
 
 
@@ -623,7 +879,7 @@ void DRW_InterfaceImpl::addBlock(const DRW_Block& data){
 	// Set base
 	newBlock.m_basePoint = IBKMK::Vector2D(data.basePoint.x, data.basePoint.y);
 
-	m_drawing->m_blocks.push_back(newBlock);
+	m_drawing->m_blocks.push_back(std::move(newBlock));
 
 	// Set actove block
 	m_activeBlock = &m_drawing->m_blocks.back();
@@ -661,7 +917,7 @@ void DRW_InterfaceImpl::addPoint(const DRW_Point& data){
 	else
 		newPoint.m_color = QColor();
 
-	m_drawing->m_points.push_back(newPoint);
+	m_drawing->m_points.push_back(std::move(newPoint));
 
 }
 
@@ -692,7 +948,7 @@ void DRW_InterfaceImpl::addLine(const DRW_Line& data){
 	else
 		newLine.m_color = QColor();
 
-	m_drawing->m_lines.push_back(newLine);
+	m_drawing->m_lines.push_back(std::move(newLine));
 }
 
 void DRW_InterfaceImpl::addRay(const DRW_Ray& /*data*/){}
@@ -723,7 +979,7 @@ void DRW_InterfaceImpl::addArc(const DRW_Arc& data){
 	else
 		newArc.m_color = QColor();
 
-	m_drawing->m_arcs.push_back(newArc);
+	m_drawing->m_arcs.push_back(std::move(newArc));
 }
 
 
@@ -751,7 +1007,7 @@ void DRW_InterfaceImpl::addCircle(const DRW_Circle& data){
 	else
 		newCircle.m_color = QColor();
 
-	m_drawing->m_circles.push_back(newCircle);
+	m_drawing->m_circles.push_back(std::move(newCircle));
 }
 
 
@@ -781,7 +1037,7 @@ void DRW_InterfaceImpl::addEllipse(const DRW_Ellipse& data){
 	else
 		newEllipse.m_color = QColor();
 
-	m_drawing->m_ellipses.push_back(newEllipse);
+	m_drawing->m_ellipses.push_back(std::move(newEllipse));
 }
 
 
@@ -798,7 +1054,7 @@ void DRW_InterfaceImpl::addLWPolyline(const DRW_LWPolyline& data){
 
 	// iterate over data.vertlist, insert all vertices of Polyline into vector
 	for(size_t i = 0; i < data.vertlist.size(); i++){
-		IBKMK::Vector2D point(data.vertlist[i]->x, data.vertlist[i]->y);
+		IBKMK::Vector2D point(data.vertlist[i].x, data.vertlist[i].y);
 		newPolyline.m_polyline.push_back(point);
 
 		// qDebug() << QString("PL Point | %1 %2").arg(point.m_x).arg(point.m_y);
@@ -823,7 +1079,7 @@ void DRW_InterfaceImpl::addLWPolyline(const DRW_LWPolyline& data){
 	newPolyline.m_endConnected = data.flags == 129 || data.flags == 1 ;
 
 	// insert vector into m_lines[data.layer] vector
-	m_drawing->m_polylines.push_back(newPolyline);
+	m_drawing->m_polylines.push_back(std::move(newPolyline));
 }
 
 
@@ -868,9 +1124,45 @@ void DRW_InterfaceImpl::addPolyline(const DRW_Polyline& data){
 	newPolyline.m_endConnected = data.flags == 129 || data.flags == 1 ;
 
 	// insert vector into m_lines[data.layer] vector
-	m_drawing->m_polylines.push_back(newPolyline);
+	m_drawing->m_polylines.push_back(std::move(newPolyline));
+}
+void DRW_InterfaceImpl::addSpline(const DRW_Spline* data){
+
+	Drawing::Spline newSpline;
+	newSpline.m_zPosition = m_drawing->m_zCounter;
+	m_drawing->m_zCounter++;
+
+	newSpline.m_degree = (unsigned int)std::max(1, data->degree);
+	newSpline.m_knots = data->knotslist;
+	newSpline.m_controlPoints.reserve(data->controllist.size());
+	for (const DRW_Coord &c : data->controllist)
+		newSpline.m_controlPoints.push_back(IBKMK::Vector2D(c.x, c.y));
+	// weights are only meaningful for rational splines with one weight per control point
+	if ((data->flags & 4) && data->weightlist.size() == data->controllist.size())
+		newSpline.m_weights = data->weightlist;
+	newSpline.m_fitPoints.reserve(data->fitlist.size());
+	for (const DRW_Coord &c : data->fitlist)
+		newSpline.m_fitPoints.push_back(IBKMK::Vector2D(c.x, c.y));
+	if (newSpline.m_controlPoints.size() < 2 && newSpline.m_fitPoints.size() < 2)
+		return;
+	newSpline.m_closed = (data->flags & 1) != 0;
+
+	newSpline.m_lineWeight = DRW_LW_Conv::lineWidth2dxfInt(data->lWeight);
+	newSpline.m_layerName = QString::fromStdString(data->layer);
+
+	newSpline.m_id = (*m_nextId)++;
+	if (m_activeBlock != nullptr)
+		newSpline.m_blockName = m_activeBlock->m_name;
+
+	/* value 256 means use defaultColor, value 7 is black */
+	if(!(data->color == 256 || data->color == 7))
+		newSpline.m_color = QColor(DRW::dxfColors[data->color][0], DRW::dxfColors[data->color][1], DRW::dxfColors[data->color][2]);
+	else
+		newSpline.m_color = QColor();
+
+	m_drawing->m_splines.push_back(std::move(newSpline));
 }
-void DRW_InterfaceImpl::addSpline(const DRW_Spline* /*data*/){}
+// knots are part of the spline data, see addSpline()
 void DRW_InterfaceImpl::addKnot(const DRW_Entity & /*data*/){}
 
 void DRW_InterfaceImpl::addInsert(const DRW_Insert& data){
@@ -892,7 +1184,7 @@ void DRW_InterfaceImpl::addInsert(const DRW_Insert& data){
 		// newInsert.m_insertionPoint -= m_activeBlock->m_basePoint;
 	}
 
-	m_drawing->m_inserts.push_back(newInsert);
+	m_drawing->m_inserts.push_back(std::move(newInsert));
 }
 
 void DRW_InterfaceImpl::addTrace(const DRW_Trace& /*data*/){}
@@ -937,7 +1229,7 @@ void DRW_InterfaceImpl::addSolid(const DRW_Solid& data){
 	else
 		newSolid.m_color = QColor();
 
-	m_drawing->m_solids.push_back(newSolid);
+	m_drawing->m_solids.push_back(std::move(newSolid));
 
 }
 
@@ -1081,7 +1373,7 @@ void DRW_InterfaceImpl::addMText(const DRW_MText& data){
 	else
 		newText.m_color = QColor();
 
-	m_drawing->m_texts.push_back(newText);
+	m_drawing->m_texts.push_back(std::move(newText));
 }
 
 void DRW_InterfaceImpl::addText(const DRW_Text& data){
@@ -1111,7 +1403,7 @@ void DRW_InterfaceImpl::addText(const DRW_Text& data){
 	else
 		newText.m_color = QColor();
 
-	m_drawing->m_texts.push_back(newText);
+	m_drawing->m_texts.push_back(std::move(newText));
 }
 void DRW_InterfaceImpl::addDimAlign(const DRW_DimAligned */*data*/){}
 void DRW_InterfaceImpl::addDimLinear(const DRW_DimLinear *data){
@@ -1211,7 +1503,7 @@ void DRW_InterfaceImpl::addDimLinear(const DRW_DimLinear *data){
 		return;
 	}
 
-	m_drawing->m_linearDimensions.push_back(newLinearDimension);
+	m_drawing->m_linearDimensions.push_back(std::move(newLinearDimension));
 
 }
 
@@ -1221,7 +1513,153 @@ void DRW_InterfaceImpl::addDimAngular(const DRW_DimAngular */*data*/){}
 void DRW_InterfaceImpl::addDimAngular3P(const DRW_DimAngular3p */*data*/){}
 void DRW_InterfaceImpl::addDimOrdinate(const DRW_DimOrdinate */*data*/){}
 void DRW_InterfaceImpl::addLeader(const DRW_Leader */*data*/){}
-void DRW_InterfaceImpl::addHatch(const DRW_Hatch */*data*/){}
+
+/*! Appends a vertex to the loop, zero length segments are skipped. */
+static void appendHatchVertex(Drawing::HatchLoop &loop, const IBKMK::Vector2D &v, double bulge) {
+	if (!loop.m_vertices.empty()) {
+		const IBKMK::Vector2D &last = loop.m_vertices.back();
+		double tol = 1e-9 * std::max(1.0, std::max(std::fabs(v.m_x), std::fabs(v.m_y)));
+		if (std::fabs(last.m_x - v.m_x) <= tol && std::fabs(last.m_y - v.m_y) <= tol) {
+			// keep the bulge of the segment starting at the vertex
+			loop.m_bulges.back() = bulge;
+			return;
+		}
+	}
+	loop.m_vertices.push_back(v);
+	loop.m_bulges.push_back(bulge);
+}
+
+/*! Converts a boundary path of a hatch into a loop of vertices and bulges. Every edge contributes
+	its start point, the end point is the start point of the next edge.
+*/
+static void convertHatchLoop(const DRW_HatchLoop &drwLoop, Drawing::HatchLoop &loop) {
+	for (const DRW_Entity *e : drwLoop.objlist) {
+		switch (e->eType) {
+			case DRW::LWPOLYLINE: {
+				const DRW_LWPolyline *pl = static_cast<const DRW_LWPolyline *>(e);
+				for (const DRW_Vertex2D &v : pl->vertlist)
+					appendHatchVertex(loop, IBKMK::Vector2D(v.x, v.y), v.bulge);
+			} break;
+
+			case DRW::LINE: {
+				const DRW_Line *l = static_cast<const DRW_Line *>(e);
+				appendHatchVertex(loop, IBKMK::Vector2D(l->basePoint.x, l->basePoint.y), 0);
+			} break;
+
+			case DRW::ARC: {
+				const DRW_Arc *a = static_cast<const DRW_Arc *>(e);
+				// angles of clockwise arcs are mirrored at the x-axis
+				double start = a->isccw ? a->staangle : -a->staangle;
+				double sweep = a->endangle - a->staangle;
+				while (sweep <= 0)
+					sweep += 2 * IBK::PI;
+				while (sweep > 2 * IBK::PI)
+					sweep -= 2 * IBK::PI;
+				if (!a->isccw)
+					sweep = -sweep;
+				IBKMK::Vector2D center(a->basePoint.x, a->basePoint.y);
+				// bulges are limited to half circles, full circles would have coinciding end points
+				unsigned int parts = std::fabs(sweep) > IBK::PI ? 2 : 1;
+				for (unsigned int i = 0; i < parts; ++i) {
+					double angle = start + i * sweep / parts;
+					IBKMK::Vector2D p(center.m_x + a->radious * std::cos(angle), center.m_y + a->radious * std::sin(angle));
+					appendHatchVertex(loop, p, std::tan(sweep / parts / 4));
+				}
+			} break;
+
+			case DRW::ELLIPSE: {
+				const DRW_Ellipse *el = static_cast<const DRW_Ellipse *>(e);
+				IBKMK::Vector2D center(el->basePoint.x, el->basePoint.y);
+				IBKMK::Vector2D majorAxis(el->secPoint.x, el->secPoint.y);
+				// the drawing unit is not known yet, hence the deviation is relative to the ellipse size
+				std::vector<IBKMK::Vector2D> points;
+				if (el->isccw)
+					CurveTessellation::ellipse(center, majorAxis, el->ratio, el->staparam, el->endparam,
+											   1e-3 * majorAxis.magnitude(), points);
+				else {
+					// mirrored parameters, tessellated counter-clockwise and reversed
+					CurveTessellation::ellipse(center, majorAxis, el->ratio, -el->endparam, -el->staparam,
+											   1e-3 * majorAxis.magnitude(), points);
+					std::reverse(points.begin(), points.end());
+				}
+				for (unsigned int i = 0; i + 1 < points.size(); ++i)
+					appendHatchVertex(loop, points[i], 0);
+			} break;
+
+			case DRW::SPLINE: {
+				// splines are approximated by their fit points or control polygon
+				const DRW_Spline *sp = static_cast<const DRW_Spline *>(e);
+				if (!sp->fitlist.empty()) {
+					for (unsigned int i = 0; i + 1 < sp->fitlist.size(); ++i)
+						appendHatchVertex(loop, IBKMK::Vector2D(sp->fitlist[i].x, sp->fitlist[i].y), 0);
+				}
+				else {
+					for (unsigned int i = 0; i + 1 < sp->controllist.size(); ++i)
+						appendHatchVertex(loop, IBKMK::Vector2D(sp->controllist[i].x, sp->controllist[i].y), 0);
+				}
+			} break;
+
+			default:
+				break;
+		}
+	}
+
+	// last vertex coinciding with the first one
+	if (loop.m_vertices.size() > 1) {
+		const IBKMK::Vector2D &first = loop.m_vertices.front();
+		const IBKMK::Vector2D &last = loop.m_vertices.back();
+		double tol = 1e-9 * std::max(1.0, std::max(std::fabs(first.m_x), std::fabs(first.m_y)));
+		if (std::fabs(last.m_x - first.m_x) <= tol && std::fabs(last.m_y - first.m_y) <= tol) {
+			loop.m_vertices.pop_back();
+			loop.m_bulges.pop_back();
+		}
+	}
+
+	bool straight = true;
+	for (double b : loop.m_bulges) {
+		if (b != 0) {
+			straight = false;
+			break;
+		}
+	}
+	if (straight)
+		loop.m_bulges.clear();
+}
+
+void DRW_InterfaceImpl::addHatch(const DRW_Hatch *data){
+
+	Drawing::Hatch newHatch;
+
+	for (const DRW_HatchLoop *drwLoop : data->looplist) {
+		Drawing::HatchLoop loop;
+		convertHatchLoop(*drwLoop, loop);
+		// loops need an area
+		if (loop.m_vertices.size() < 3 && (loop.m_bulges.empty() || loop.m_vertices.size() < 2))
+			continue;
+		newHatch.m_loops.push_back(std::move(loop));
+	}
+	if (newHatch.m_loops.empty())
+		return;
+
+	newHatch.m_zPosition = m_drawing->m_zCounter;
+	m_drawing->m_zCounter++;
+
+	newHatch.m_solidFill = data->solid == 1;
+	newHatch.m_lineWeight = DRW_LW_Conv::lineWidth2dxfInt(data->lWeight);
+	newHatch.m_layerName = QString::fromStdString(data->layer);
+
+	newHatch.m_id = (*m_nextId)++;
+	if (m_activeBlock != nullptr)
+		newHatch.m_blockName = m_activeBlock->m_name;
+
+	/* value 256 means use defaultColor, value 7 is black */
+	if(!(data->color == 256 || data->color == 7))
+		newHatch.m_color = QColor(DRW::dxfColors[data->color][0], DRW::dxfColors[data->color][1], DRW::dxfColors[data->color][2]);
+	else
+		newHatch.m_color = QColor();
+
+	m_drawing->m_hatches.push_back(std::move(newHatch));
+}
 
 void DRW_InterfaceImpl::addViewport(const DRW_Viewport& /*data*/) {}
 
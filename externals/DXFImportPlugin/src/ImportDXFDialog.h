@@ -5,6 +5,8 @@
 
 #include <QDialog>
 
+#include <functional>
+
 #include <IBKMK_Vector2D.h>
 #include <IBKMK_Vector3D.h>
 #include <IBK_Line.h>
@@ -15,6 +17,8 @@
 #include <drw_base.h>
 
 
+class QAction;
+
 namespace Ui {
 class ImportDXFDialog;
 }
@@ -40,6 +44,59 @@ public:
 		NUM_SU
 	};
 
+	struct ConvertResults;
+
+	/*! Options of convertDxfFile(). */
+	struct ConvertOptions {
+		/*! If false, texts and dimensions are skipped while reading. */
+		bool											m_importText = true;
+		/*! Comma separated wildcard patterns of the layers to read, all layers if empty. */
+		QString											m_importLayers;
+		/*! Unit of the drawing coordinates, with SU_Auto the unit is determined from the bounding box. */
+		ScaleUnit										m_unit = SU_Auto;
+		/*! If > 0, polylines are simplified with this tolerance in m. */
+		double											m_simplifyTolerance = 0;
+		/*! If > 0, duplicate and overlapping lines are removed with this tolerance in m. */
+		double											m_deduplicateTolerance = 0;
+		/*! Comma separated wildcard patterns of the layers whose duplicate lines are removed, all layers if empty. */
+		QString											m_deduplicateLayers;
+		/*! If set, called after every step of the conversion with the name of the step. */
+		std::function<void(const char *step)>			m_stepFinished;
+		/*! If set, called with SU_Auto when the auto determined scaling factor does not match the one from the header.
+			Returns the scaling factor to use, otherwise the auto determined factor is used.
+		*/
+		std::function<double(const ConvertResults &results)>	m_chooseScalingFactor;
+	};
+
+	/*! Results of convertDxfFile(). */
+	struct ConvertResults {
+		/*! Scaling factor and unit from "$INSUNITS". */
+		double											m_dxfScalingFactor = 1.0;
+		std::string										m_dxfScalingUnit;
+		/*! Bounding box of the drawing in drawing units. */
+		IBKMK::Vector3D									m_bounding;
+		/*! Auto determined unit, NUM_SU if it could not be determined or another unit was given. */
+		ScaleUnit										m_autoUnit = NUM_SU;
+		/*! Scaling factor of the given or auto determined unit. */
+		double											m_unitScalingFactor = 1.0;
+		/*! Number of layers matching ConvertOptions::m_deduplicateLayers. */
+		std::size_t										m_deduplicateLayerCount = 0;
+		PolylineSimplification::Statistics				m_simplifyStats;
+		LineDeduplication::Statistics					m_deduplicateStats;
+	};
+
+	/*! Reads a dxf file into drawing and prepares it for the import: updates references, determines the
+		scaling factor and the center, simplifies polylines, removes duplicate lines and tessellates splines.
+		This is the conversion of the dialog, BatchImport (DXFBatchImport) runs it headless.
+		\param fname Filename that will be read
+		\param scanInfo Quick scan of the file (see dxfRW::scan()), used to reserve memory and select layers
+		\param drawing Drawing, it is cleared first
+		\param nextId Next VICUS project ID, reset and incremented for every object
+		Throws an IBK::Exception if the file could not be read.
+	*/
+	static void convertDxfFile(const QString &fname, const DRW_ScanInfo &scanInfo, const ConvertOptions &options,
+							   Drawing &drawing, unsigned int &nextId, ConvertResults &results);
+
 	ImportResults importFile(const QString & fname);
 
 	~ImportDXFDialog();
@@ -71,13 +128,18 @@ private slots:
 
 	void on_checkBoxCustomOrigin_toggled(bool checked);
 
+	/*! Checks the layers of the layer menu, that are listed in the import layer line edit. */
+	void updateLayerMenu();
+
+	/*! Adds or removes the layer of a toggled layer menu action to/from the import layer line edit. */
+	void layerMenuTriggered(QAction *action);
+
 private:
-	/*! Read a specified dxf file.
-		\param drawing VICUS Drawing, where all primitives are added
-		\param fname Filename that will be read
-		\returns true if reading has been successful
+	/*! Quickly scans m_filePath into m_scanInfo and shows header units and extents, the suggested
+		unit and the entity counts in the log window, before anything is converted.
+		Preselects the unit from header and extents and offers the layers of the file in the layer menu.
 	*/
-	bool readDxfFile(Drawing & drawing, const QString &fname);
+	void scanDxfFile();
 
 	/*! Fix too big fonts. */
 	void fixFonts();
@@ -90,6 +152,9 @@ private:
 	/*! Last file path. */
 	QString					m_filePath;
 
+	/*! Quick scan of m_filePath (units, extents, layers and entity counts), done before the dialog is shown. */
+	DRW_ScanInfo			m_scanInfo;
+
 	/*! VICUS Drawing with all drawing primitives. */
 	Drawing					m_drawing;
 
@@ -101,12 +166,6 @@ private:
 
 	bool					m_detailedMode = false;
 
-	/*! Dxf Scaling factor from "$INSUNIT". */
-	double					m_dxfScalingFactor = 1.0;
-
-	/*! Dxf Scaling factor from "$INSUNIT". */
-	std::string				m_dxfScalingUnit = "";
-
 };
 
 /* Implementation of DRW_Interface. A dxf file will be read from top to bottom,
@@ -127,12 +186,20 @@ class DRW_InterfaceImpl : public DRW_Interface {
 
 	std::string			*m_dxfScalingUnit = nullptr;
 
+	/*! Reserves the drawing collections for counts[] objects of each ReserveType. */
+	void reserve(const std::size_t counts[]);
+
 public :
 
 	/*! C'tor */
 	DRW_InterfaceImpl(Drawing *drawing, double *dxfScalingFactor,
 					  std::string *dxfScalingUnit, unsigned int &nextId);
 
+	/*! Reserves the drawing collections from the entity counts of a quick scan, see dxfRW::scan().
+		Returns false if the scan did not count entities, in which case nothing is reserved.
+	*/
+	bool reserveFromScan(const DRW_ScanInfo &info);
+
 	/** Called when header is parsed.  */
 	void addHeader(const DRW_Header* data) override;
 
@@ -0,0 +1,253 @@
+#include "LineDeduplication.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+namespace LineDeduplication {
+
+/*! Quantization step of the direction angle in rad. */
+static const double ANGLE_STEP = 1e-4;
+/*! Number of angle steps of a half turn, directions are unique modulo this count. */
+static const long long HALF_TURN_STEPS = std::llround(std::acos(-1.0) / ANGLE_STEP);
+
+
+/*! Quantized end points of a segment in canonical direction. */
+struct EndPointKey {
+	bool operator==(const EndPointKey & other) const {
+		return m_x1 == other.m_x1 && m_y1 == other.m_y1 && m_x2 == other.m_x2 && m_y2 == other.m_y2;
+	}
+
+	std::int64_t	m_x1;
+	std::int64_t	m_y1;
+	std::int64_t	m_x2;
+	std::int64_t	m_y2;
+};
+
+/*! Quantized direction angle and distance from origin of the carrier line of a segment. */
+struct CarrierKey {
+	bool operator==(const CarrierKey & other) const {
+		return m_angle == other.m_angle && m_offset == other.m_offset;
+	}
+
+	std::int64_t	m_angle;
+	std::int64_t	m_offset;
+};
+
+static inline void hashCombine(std::size_t & seed, std::int64_t v) {
+	seed ^= std::hash<std::int64_t>()(v) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+struct EndPointKeyHash {
+	std::size_t operator()(const EndPointKey & k) const {
+		std::size_t seed = 0;
+		hashCombine(seed, k.m_x1);
+		hashCombine(seed, k.m_y1);
+		hashCombine(seed, k.m_x2);
+		hashCombine(seed, k.m_y2);
+		return seed;
+	}
+};
+
+struct CarrierKeyHash {
+	std::size_t operator()(const CarrierKey & k) const {
+		std::size_t seed = 0;
+		hashCombine(seed, k.m_angle);
+		hashCombine(seed, k.m_offset);
+		return seed;
+	}
+};
+
+
+/*! Squared distance of point p from segment a-b. */
+static double distanceSquared(const IBKMK::Vector2D & p, const IBKMK::Vector2D & a, const IBKMK::Vector2D & b) {
+	double dx = b.m_x - a.m_x;
+	double dy = b.m_y - a.m_y;
+	double px = p.m_x - a.m_x;
+	double py = p.m_y - a.m_y;
+	double len2 = dx*dx + dy*dy;
+	if (len2 > 0) {
+		double t = std::max(0.0, std::min(1.0, (px*dx + py*dy) / len2));
+		px -= t*dx;
+		py -= t*dy;
+	}
+	return px*px + py*py;
+}
+
+
+/*! Segment of a carrier group, projected onto the group direction. */
+struct Projection {
+	std::size_t		m_idx;
+	/*! Smaller and larger projection of the end points. */
+	double			m_t1;
+	double			m_t2;
+	/*! True, if m_p1 of the segment has the larger projection. */
+	bool			m_reversed;
+};
+
+
+/*! Returns the end point of the segment with the smaller projection. */
+static inline IBKMK::Vector2D & nearPoint(Segment & s, const Projection & p) {
+	return p.m_reversed ? s.m_p2 : s.m_p1;
+}
+
+/*! Returns the end point of the segment with the larger projection. */
+static inline IBKMK::Vector2D & farPoint(Segment & s, const Projection & p) {
+	return p.m_reversed ? s.m_p1 : s.m_p2;
+}
+
+
+/*! Removes duplicates with equal quantized end points. */
+static void removeDuplicates(const std::vector<Segment> & segments, double tolerance,
+							 std::vector<char> & removed, Statistics & stats)
+{
+	std::unordered_map<EndPointKey, std::size_t, EndPointKeyHash> keys;
+	keys.reserve(segments.size());
+	for (std::size_t i = 0; i < segments.size(); ++i) {
+		const Segment & s = segments[i];
+		EndPointKey k;
+		k.m_x1 = std::llround(s.m_p1.m_x / tolerance);
+		k.m_y1 = std::llround(s.m_p1.m_y / tolerance);
+		k.m_x2 = std::llround(s.m_p2.m_x / tolerance);
+		k.m_y2 = std::llround(s.m_p2.m_y / tolerance);
+		// canonical direction
+		if (k.m_x1 > k.m_x2 || (k.m_x1 == k.m_x2 && k.m_y1 > k.m_y2)) {
+			std::swap(k.m_x1, k.m_x2);
+			std::swap(k.m_y1, k.m_y2);
+		}
+		// zero length segments are kept
+		if (k.m_x1 == k.m_x2 && k.m_y1 == k.m_y2)
+			continue;
+
+		std::pair<std::unordered_map<EndPointKey, std::size_t, EndPointKeyHash>::iterator, bool> res =
+				keys.insert(std::make_pair(k, i));
+		if (res.second)
+			continue;
+
+		// remove the new segment, or the kept one if only that is removable
+		std::size_t & kept = res.first->second;
+		if (s.m_removable) {
+			removed[i] = 1;
+			++stats.m_duplicates;
+		}
+		else if (segments[kept].m_removable) {
+			removed[kept] = 1;
+			++stats.m_duplicates;
+			kept = i;
+		}
+	}
+}
+
+
+/*! Removes contained segments and joins overlapping segments of one carrier group. */
+static void removeOverlaps(std::vector<Segment> & segments, std::vector<Projection> & group, double tolerance,
+						   std::vector<char> & removed, Statistics & stats)
+{
+	// ascending start, longest segment first
+	std::sort(group.begin(), group.end(), [](const Projection & a, const Projection & b) {
+		return a.m_t1 < b.m_t1 || (a.m_t1 == b.m_t1 && a.m_t2 > b.m_t2);
+	});
+
+	double tol2 = tolerance * tolerance;
+	// segment reaching farthest of all kept segments so far
+	Projection cover = group.front();
+	for (std::size_t i = 1; i < group.size(); ++i) {
+		const Projection & p = group[i];
+		Segment & s = segments[p.m_idx];
+		Segment & c = segments[cover.m_idx];
+
+		if (p.m_t2 <= cover.m_t2 + tolerance) {
+			// contained in cover, both end points must lie on the cover segment
+			if (s.m_removable && distanceSquared(s.m_p1, c.m_p1, c.m_p2) <= tol2 &&
+				distanceSquared(s.m_p2, c.m_p1, c.m_p2) <= tol2)
+			{
+				removed[p.m_idx] = 1;
+				++stats.m_covered;
+			}
+			continue;
+		}
+
+		if (p.m_t1 <= cover.m_t2 + tolerance && s.m_removable && c.m_removable &&
+			s.m_mergeGroup >= 0 && s.m_mergeGroup == c.m_mergeGroup)
+		{
+			// joined segment from start of cover to end of s, must not deviate from both
+			const IBKMK::Vector2D & start = nearPoint(c, cover);
+			const IBKMK::Vector2D & end = farPoint(s, p);
+			if (distanceSquared(nearPoint(s, p), start, end) <= tol2 && distanceSquared(farPoint(c, cover), start, end) <= tol2) {
+				farPoint(c, cover) = end;
+				cover.m_t2 = p.m_t2;
+				removed[p.m_idx] = 1;
+				++stats.m_merged;
+				continue;
+			}
+		}
+
+		cover = p;
+	}
+}
+
+
+void deduplicate(std::vector<Segment> & segments, double tolerance, std::vector<char> & removed, Statistics & stats) {
+	removed.assign(segments.size(), 0);
+	stats.m_lines += segments.size();
+	if (tolerance <= 0 || segments.empty())
+		return;
+
+	removeDuplicates(segments, tolerance, removed, stats);
+
+	// group remaining segments by their carrier line, coordinates relative to the first segment
+	// to keep offsets and projections precise for georeferenced drawings
+	const IBKMK::Vector2D origin = segments.front().m_p1;
+	std::unordered_map<CarrierKey, std::vector<Projection>, CarrierKeyHash> groups;
+	for (std::size_t i = 0; i < segments.size(); ++i) {
+		if (removed[i])
+			continue;
+
+		const Segment & s = segments[i];
+		double dx = s.m_p2.m_x - s.m_p1.m_x;
+		double dy = s.m_p2.m_y - s.m_p1.m_y;
+		if (dx*dx + dy*dy <= tolerance * tolerance)
+			continue;
+
+		// canonical direction with angle in [-PI/2, PI/2]
+		if (dx < 0 || (dx == 0 && dy < 0)) {
+			dx = -dx;
+			dy = -dy;
+		}
+
+		CarrierKey k;
+		// -PI/2 and PI/2 describe the same carrier direction, e.g. for (nearly) vertical segments with dx == 0 and dx > 0
+		k.m_angle = std::llround(std::atan2(dy, dx) / ANGLE_STEP) % HALF_TURN_STEPS;
+		if (k.m_angle < 0)
+			k.m_angle += HALF_TURN_STEPS;
+		// all segments of a group are projected onto the same (quantized) direction
+		double angle = k.m_angle * ANGLE_STEP;
+		dx = std::cos(angle);
+		dy = std::sin(angle);
+
+		double x1 = s.m_p1.m_x - origin.m_x;
+		double y1 = s.m_p1.m_y - origin.m_y;
+		double x2 = s.m_p2.m_x - origin.m_x;
+		double y2 = s.m_p2.m_y - origin.m_y;
+		// signed distance of carrier line from origin
+		k.m_offset = std::llround((y1 * dx - x1 * dy) / tolerance);
+
+		Projection p;
+		p.m_idx = i;
+		double t1 = x1 * dx + y1 * dy;
+		double t2 = x2 * dx + y2 * dy;
+		p.m_reversed = t1 > t2;
+		p.m_t1 = std::min(t1, t2);
+		p.m_t2 = std::max(t1, t2);
+		groups[k].push_back(p);
+	}
+
+	for (std::pair<const CarrierKey, std::vector<Projection> > & g : groups) {
+		if (g.second.size() > 1)
+			removeOverlaps(segments, g.second, tolerance, removed, stats);
+	}
+}
+
+} // namespace LineDeduplication
@@ -0,0 +1,64 @@
+#ifndef LineDeduplicationH
+#define LineDeduplicationH
+
+#include <cstddef>
+#include <vector>
+
+#include <IBKMK_Vector2D.h>
+
+/*! Elimination of duplicate and overlapping line segments.
+
+	CAD exports often contain the same line two or three times (on several layers, from exploded
+	blocks). Segments are processed in two linear time hashing stages:
+	- duplicates: end points are quantized with the tolerance and ordered in canonical direction,
+	  segments with equal keys are duplicates,
+	- overlaps: segments are grouped by quantized direction angle and distance of their carrier line
+	  from the origin. Within a group, segments contained in another segment are removed and
+	  partially overlapping segments of the same merge group are joined.
+	Quantization may miss duplicates whose coordinates lie on different sides of a grid boundary.
+	Removed segments never deviate more than the tolerance from the kept segment (per coordinate
+	for duplicates, overlaps are checked with the exact distance).
+
+	The tolerance is in drawing units, callers convert the tolerance in metres with the
+	drawing scaling factor.
+*/
+namespace LineDeduplication {
+
+/*! Line segment passed to deduplicate(). */
+struct Segment {
+	IBKMK::Vector2D		m_p1;
+	IBKMK::Vector2D		m_p2;
+	/*! Segments are only joined with segments of the same merge group (e.g. same layer, color and line weight).
+		-1 disables joining, the end points of the segment are never modified.
+	*/
+	int					m_mergeGroup = -1;
+	/*! If false, the segment is always kept, but other segments may still be removed as duplicates of it. */
+	bool				m_removable = true;
+};
+
+/*! Number of processed and removed segments. */
+struct Statistics {
+	/*! Number of processed segments. */
+	std::size_t		m_lines = 0;
+	/*! Removed duplicates with equal end points. */
+	std::size_t		m_duplicates = 0;
+	/*! Removed segments that are contained in another collinear segment. */
+	std::size_t		m_covered = 0;
+	/*! Removed segments that have been joined with an overlapping segment. */
+	std::size_t		m_merged = 0;
+
+	/*! Total number of removed segments. */
+	std::size_t removed() const { return m_duplicates + m_covered + m_merged; }
+};
+
+/*! Finds duplicate and overlapping segments.
+	\param segments Segments, end points of segments that other segments were joined with are updated.
+	\param tolerance Quantization tolerance in drawing units.
+	\param removed Resized to the number of segments, 1 for removed segments.
+	\param stats Statistics are added to.
+*/
+void deduplicate(std::vector<Segment> & segments, double tolerance, std::vector<char> & removed, Statistics & stats);
+
+} // namespace LineDeduplication
+
+#endif // LineDeduplicationH
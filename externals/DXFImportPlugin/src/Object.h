@@ -14,6 +14,12 @@ public:
 	Object() = default;
 	/*! Default copy constructor. */
 	Object(Object const&) = default;
+	/*! Default move constructor, needed since the virtual d'tor suppresses the implicit one. */
+	Object(Object &&) = default;
+	/*! Default copy assignment operator. */
+	Object & operator=(Object const&) = default;
+	/*! Default move assignment operator. */
+	Object & operator=(Object &&) = default;
 	/*! D'tor. */
 	virtual ~Object();
 
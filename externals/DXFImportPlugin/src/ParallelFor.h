@@ -0,0 +1,214 @@
+#ifndef ParallelForH
+#define ParallelForH
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*! Worker threads used by parallelFor(), created on first use and kept until shutdown() is called.
+
+	run() executes a job on the calling thread and on up to helpers idle workers at the same time
+	and returns, when all of them are done. The job decides how the work is split (parallelFor() uses a
+	shared counter), it must not throw.
+	When the pool is already busy with a job of another thread, or when run() is called from inside a
+	job, the job is executed by the calling thread only, so nested and concurrent calls do not deadlock.
+	The pool is never destroyed during static destruction, since joining threads there (e.g. while the
+	plugin library is unloaded) can deadlock. A pool, that was not shut down, is left to the end of the process.
+*/
+class ParallelForPool {
+public:
+	/*! Returns the pool, starts the worker threads on the first call (and the first call after shutdown()). */
+	static ParallelForPool & instance() {
+		ParallelForPool * pool = poolPointer().load(std::memory_order_acquire);
+		if (pool == nullptr) {
+			std::lock_guard<std::mutex> lock(poolMutex());
+			pool = poolPointer().load(std::memory_order_relaxed);
+			if (pool == nullptr) {
+				pool = new ParallelForPool;
+				poolPointer().store(pool, std::memory_order_release);
+			}
+		}
+		return *pool;
+	}
+
+	/*! Stops and joins the worker threads. Must not be called while parallelFor() runs, nor during static destruction.
+		Called by the plugin when an import is finished, the next parallelFor() starts the threads again.
+	*/
+	static void shutdown() {
+		std::lock_guard<std::mutex> lock(poolMutex());
+		delete poolPointer().exchange(nullptr, std::memory_order_acq_rel);
+	}
+
+	/*! Returns true if the calling thread is one of the worker threads. */
+	static bool isWorkerThread() {
+		return workerFlag();
+	}
+
+	/*! Runs job on the calling thread and on up to helpers worker threads, see class documentation. */
+	void run(const std::function<void()> & job, std::size_t helpers) {
+		std::unique_lock<std::mutex> runLock(m_runMutex, std::try_to_lock);
+		helpers = std::min(helpers, m_threads.size());
+		if (!runLock.owns_lock() || isWorkerThread() || helpers == 0) {
+			job();
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_job = &job;
+			m_pendingHelpers = helpers;
+			m_activeHelpers = helpers;
+		}
+		m_wakeUp.notify_all();
+
+		job();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		// workers, that did not pick up the job yet, would find no work left
+		m_activeHelpers -= m_pendingHelpers;
+		m_pendingHelpers = 0;
+		m_done.wait(lock, [this]() { return m_activeHelpers == 0; });
+		m_job = nullptr;
+	}
+
+private:
+	/*! Stops and joins the worker threads. */
+	~ParallelForPool() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wakeUp.notify_all();
+		for (std::thread & t : m_threads)
+			t.join();
+	}
+
+	/*! Starts hardware_concurrency() - 1 worker threads, the thread calling run() is the last one. */
+	ParallelForPool() {
+		unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+		m_threads.reserve(threadCount - 1);
+		for (unsigned int t = 1; t < threadCount; ++t)
+			m_threads.emplace_back(&ParallelForPool::workerLoop, this);
+	}
+
+	ParallelForPool(const ParallelForPool &) = delete;
+	ParallelForPool & operator=(const ParallelForPool &) = delete;
+
+	/*! Current pool, nullptr before the first use and after shutdown(). */
+	static std::atomic<ParallelForPool*> & poolPointer() {
+		static std::atomic<ParallelForPool*> pointer(nullptr);
+		return pointer;
+	}
+
+	/*! Serialises creation and shutdown of the pool. */
+	static std::mutex & poolMutex() {
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	/*! Flag, that marks the worker threads of the pool. */
+	static bool & workerFlag() {
+		thread_local bool flag = false;
+		return flag;
+	}
+
+	/*! Waits for jobs and runs them until the pool is destroyed. */
+	void workerLoop() {
+		workerFlag() = true;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (;;) {
+			m_wakeUp.wait(lock, [this]() { return m_stop || m_pendingHelpers > 0; });
+			if (m_stop)
+				return;
+			--m_pendingHelpers;
+			const std::function<void()> * job = m_job;
+			lock.unlock();
+			(*job)();
+			lock.lock();
+			if (--m_activeHelpers == 0)
+				m_done.notify_one();
+		}
+	}
+
+	/*! Worker threads. */
+	std::vector<std::thread>		m_threads;
+	/*! Held by the thread, whose job is running on the pool. */
+	std::mutex						m_runMutex;
+	/*! Protects all members below. */
+	std::mutex						m_mutex;
+	/*! Signals new jobs and m_stop to the workers. */
+	std::condition_variable			m_wakeUp;
+	/*! Signals the end of the job to the thread waiting in run(). */
+	std::condition_variable			m_done;
+	/*! Current job, owned by the thread waiting in run(). */
+	const std::function<void()>		*m_job = nullptr;
+	/*! Number of workers, that still have to pick up the current job. */
+	std::size_t						m_pendingHelpers = 0;
+	/*! Number of workers, that picked up or still have to pick up the current job and are not done. */
+	std::size_t						m_activeHelpers = 0;
+	/*! Set when the pool is destroyed. */
+	bool							m_stop = false;
+};
+
+
+/*! Calls func(i) for all i in [0, count) on the worker threads of ParallelForPool.
+
+	Workers (the calling thread included) fetch blocks of blockSize indexes from a shared
+	counter, hence items with very different costs are balanced automatically. The number of
+	threads is limited by std::thread::hardware_concurrency() and the number of blocks, small
+	workloads run on the calling thread only, as do calls from inside func.
+	The threads are started with the first parallel call and reused by all further calls until
+	ParallelForPool::shutdown().
+
+	func must be safe to call concurrently for different indexes. The first exception thrown
+	by func stops the remaining work and is rethrown on the calling thread.
+*/
+template <typename Func>
+void parallelFor(std::size_t count, const Func & func, std::size_t blockSize = 16) {
+	if (blockSize == 0)
+		blockSize = 1;
+	std::size_t blocks = (count + blockSize - 1) / blockSize;
+	std::size_t threadCount = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), blocks);
+	if (threadCount <= 1 || ParallelForPool::isWorkerThread()) {
+		for (std::size_t i = 0; i < count; ++i)
+			func(i);
+		return;
+	}
+
+	std::atomic<std::size_t> nextIndex(0);
+	std::exception_ptr error;
+	std::mutex errorMutex;
+
+	std::function<void()> worker = [&]() {
+		for (;;) {
+			std::size_t first = nextIndex.fetch_add(blockSize);
+			if (first >= count)
+				return;
+			std::size_t last = std::min(count, first + blockSize);
+			try {
+				for (std::size_t i = first; i < last; ++i)
+					func(i);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!error)
+					error = std::current_exception();
+				nextIndex = count;
+				return;
+			}
+		}
+	};
+
+	ParallelForPool::instance().run(worker, threadCount - 1);
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+#endif // ParallelForH
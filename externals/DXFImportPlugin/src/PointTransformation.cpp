@@ -0,0 +1,71 @@
+#include "PointTransformation.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define POINT_TRANSFORMATION_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POINT_TRANSFORMATION_SSE2
+#endif
+
+namespace PointTransformation {
+
+void transform(const glm::dmat4 & m, double zOffset, const IBKMK::Vector2D * src, std::size_t count,
+			   IBKMK::Vector3D * dst)
+{
+	// rows of the affine map, glm matrices are indexed m[column][row]
+	const double ax = m[0][0], bx = m[1][0], cx = m[3][0];
+	const double ay = m[0][1], by = m[1][1], cy = m[3][1];
+	const double az = m[0][2], bz = m[1][2], cz = m[3][2] + zOffset;
+
+	std::size_t i = 0;
+
+#if defined(POINT_TRANSFORMATION_AVX2)
+	const __m256d vax = _mm256_set1_pd(ax), vbx = _mm256_set1_pd(bx), vcx = _mm256_set1_pd(cx);
+	const __m256d vay = _mm256_set1_pd(ay), vby = _mm256_set1_pd(by), vcy = _mm256_set1_pd(cy);
+	const __m256d vaz = _mm256_set1_pd(az), vbz = _mm256_set1_pd(bz), vcz = _mm256_set1_pd(cz);
+
+	for (; i + 4 <= count; i += 4) {
+		const IBKMK::Vector2D * s = src + i;
+		__m256d x = _mm256_setr_pd(s[0].m_x, s[1].m_x, s[2].m_x, s[3].m_x);
+		__m256d y = _mm256_setr_pd(s[0].m_y, s[1].m_y, s[2].m_y, s[3].m_y);
+
+		// same operation order as the scalar code: (a*x + b*y) + c
+		alignas(32) double rx[4], ry[4], rz[4];
+		_mm256_store_pd(rx, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vax, x), _mm256_mul_pd(vbx, y)), vcx));
+		_mm256_store_pd(ry, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vay, x), _mm256_mul_pd(vby, y)), vcy));
+		_mm256_store_pd(rz, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vaz, x), _mm256_mul_pd(vbz, y)), vcz));
+
+		for (unsigned int k = 0; k < 4; ++k)
+			dst[i + k] = IBKMK::Vector3D(rx[k], ry[k], rz[k]);
+	}
+#elif defined(POINT_TRANSFORMATION_SSE2)
+	const __m128d vax = _mm_set1_pd(ax), vbx = _mm_set1_pd(bx), vcx = _mm_set1_pd(cx);
+	const __m128d vay = _mm_set1_pd(ay), vby = _mm_set1_pd(by), vcy = _mm_set1_pd(cy);
+	const __m128d vaz = _mm_set1_pd(az), vbz = _mm_set1_pd(bz), vcz = _mm_set1_pd(cz);
+
+	for (; i + 2 <= count; i += 2) {
+		const IBKMK::Vector2D * s = src + i;
+		__m128d x = _mm_setr_pd(s[0].m_x, s[1].m_x);
+		__m128d y = _mm_setr_pd(s[0].m_y, s[1].m_y);
+
+		alignas(16) double rx[2], ry[2], rz[2];
+		_mm_store_pd(rx, _mm_add_pd(_mm_add_pd(_mm_mul_pd(vax, x), _mm_mul_pd(vbx, y)), vcx));
+		_mm_store_pd(ry, _mm_add_pd(_mm_add_pd(_mm_mul_pd(vay, x), _mm_mul_pd(vby, y)), vcy));
+		_mm_store_pd(rz, _mm_add_pd(_mm_add_pd(_mm_mul_pd(vaz, x), _mm_mul_pd(vbz, y)), vcz));
+
+		dst[i    ] = IBKMK::Vector3D(rx[0], ry[0], rz[0]);
+		dst[i + 1] = IBKMK::Vector3D(rx[1], ry[1], rz[1]);
+	}
+#endif
+
+	for (; i < count; ++i) {
+		const double x = src[i].m_x;
+		const double y = src[i].m_y;
+		dst[i] = IBKMK::Vector3D(ax*x + bx*y + cx,
+								 ay*x + by*y + cy,
+								 az*x + bz*y + cz);
+	}
+}
+
+} // namespace PointTransformation
@@ -0,0 +1,32 @@
+#ifndef PointTransformationH
+#define PointTransformationH
+
+#include <cstddef>
+
+#include <IBKMK_Vector2D.h>
+#include <IBKMK_Vector3D.h>
+
+#include <glm.hpp>
+
+/*! Batched transformation of 2D drawing points into 3D.
+
+	Drawing entities are planar (z = 0, w = 1), hence the 4x4 transformation reduces to a
+	2D affine map with three output rows: p' = a*x + b*y + c. Perspective entries of the
+	matrix are ignored, drawing and insert transformations are always affine.
+
+	The kernel processes 4 points per iteration with AVX2 and 2 points with SSE2, depending on
+	the instruction sets enabled at compile time (e.g. -mavx2 or /arch:AVX2), remaining points
+	are transformed with the scalar code. All paths compute in double precision.
+*/
+namespace PointTransformation {
+
+/*! Transforms count points from src into dst (buffers must not overlap).
+	\param m Transformation matrix (column major, as glm).
+	\param zOffset Offset added to the z coordinate of all points.
+*/
+void transform(const glm::dmat4 & m, double zOffset, const IBKMK::Vector2D * src, std::size_t count,
+			   IBKMK::Vector3D * dst);
+
+} // namespace PointTransformation
+
+#endif // PointTransformationH
@@ -0,0 +1,182 @@
+#include "PolylineSimplification.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace PolylineSimplification {
+
+/*! Fraction of the tolerance used to detect duplicates and collinear points. */
+static const double EXACT_TOLERANCE_FRACTION = 1e-3;
+
+
+/*! Squared distance of point p from segment a-b. */
+static double distanceSquared(const IBKMK::Vector2D & p, const IBKMK::Vector2D & a, const IBKMK::Vector2D & b) {
+	double dx = b.m_x - a.m_x;
+	double dy = b.m_y - a.m_y;
+	double px = p.m_x - a.m_x;
+	double py = p.m_y - a.m_y;
+	double len2 = dx*dx + dy*dy;
+	if (len2 > 0) {
+		double t = std::max(0.0, std::min(1.0, (px*dx + py*dy) / len2));
+		px -= t*dx;
+		py -= t*dy;
+	}
+	return px*px + py*py;
+}
+
+
+/*! Squared distance between two points. */
+static double distanceSquared(const IBKMK::Vector2D & a, const IBKMK::Vector2D & b) {
+	double dx = b.m_x - a.m_x;
+	double dy = b.m_y - a.m_y;
+	return dx*dx + dy*dy;
+}
+
+
+/*! Removes all vertices with keep[i] == 0, returns number of removed vertices. */
+static std::size_t compact(std::vector<IBKMK::Vector2D> & points, const std::vector<char> & keep) {
+	std::size_t j = 0;
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		if (keep[i])
+			points[j++] = points[i];
+	}
+	std::size_t removed = points.size() - j;
+	points.resize(j);
+	return removed;
+}
+
+
+/*! Removes consecutive duplicates (and the repeated first vertex of closed polylines). */
+static std::size_t removeDuplicates(std::vector<IBKMK::Vector2D> & points, bool closed, double eps2) {
+	if (points.empty())
+		return 0;
+
+	std::size_t n = points.size();
+	std::size_t j = 0;
+	for (std::size_t i = 1; i < n; ++i) {
+		if (distanceSquared(points[j], points[i]) > eps2)
+			points[++j] = points[i];
+	}
+	++j;
+	if (closed) {
+		while (j > 1 && distanceSquared(points[j-1], points[0]) <= eps2)
+			--j;
+	}
+	points.resize(j);
+	return n - j;
+}
+
+
+/*! Removes vertices lying on the segment between the last kept vertex and the following vertex.
+	Vertices where the polyline reverses its direction are kept.
+*/
+static std::size_t removeCollinear(std::vector<IBKMK::Vector2D> & points, std::size_t minCount, double eps2) {
+	std::size_t n = points.size();
+	if (n <= minCount)
+		return 0;
+
+	std::vector<char> keep(n, 1);
+	std::size_t last = 0;
+	std::size_t count = n;
+	for (std::size_t i = 1; i + 1 < n; ++i) {
+		if (distanceSquared(points[i], points[last], points[i+1]) <= eps2) {
+			keep[i] = 0;
+			--count;
+		}
+		else
+			last = i;
+	}
+
+	if (count < minCount)
+		return 0;
+	return compact(points, keep);
+}
+
+
+/*! Douglas-Peucker simplification with explicit stack. Closed polylines are split at the
+	vertex farthest from the first vertex, the closing segment is handled via index n.
+*/
+static std::size_t douglasPeucker(std::vector<IBKMK::Vector2D> & points, bool closed, double tol2) {
+	std::size_t n = points.size();
+	std::size_t minCount = closed ? 3 : 2;
+	if (n <= minCount)
+		return 0;
+
+	std::vector<char> keep(n, 0);
+	std::vector<std::pair<std::size_t, std::size_t> > ranges;
+	keep[0] = 1;
+	if (closed) {
+		std::size_t farthest = 1;
+		double maxDist = -1;
+		for (std::size_t i = 1; i < n; ++i) {
+			double d = distanceSquared(points[0], points[i]);
+			if (d > maxDist) {
+				maxDist = d;
+				farthest = i;
+			}
+		}
+		keep[farthest] = 1;
+		ranges.push_back(std::make_pair(std::size_t(0), farthest));
+		ranges.push_back(std::make_pair(farthest, n));
+	}
+	else {
+		keep[n-1] = 1;
+		ranges.push_back(std::make_pair(std::size_t(0), n-1));
+	}
+
+	std::size_t count = 2;
+	while (!ranges.empty()) {
+		std::pair<std::size_t, std::size_t> r = ranges.back();
+		ranges.pop_back();
+
+		const IBKMK::Vector2D & a = points[r.first];
+		const IBKMK::Vector2D & b = points[r.second % n];
+		double maxDist = tol2;
+		std::size_t idx = 0;
+		for (std::size_t i = r.first + 1; i < r.second; ++i) {
+			double d = distanceSquared(points[i], a, b);
+			if (d > maxDist) {
+				maxDist = d;
+				idx = i;
+			}
+		}
+		if (idx != 0) {
+			keep[idx] = 1;
+			++count;
+			ranges.push_back(std::make_pair(r.first, idx));
+			ranges.push_back(std::make_pair(idx, r.second));
+		}
+	}
+
+	// degenerated closed polyline, keep it unchanged
+	if (count < minCount)
+		return 0;
+	return compact(points, keep);
+}
+
+
+bool simplify(std::vector<IBKMK::Vector2D> & points, bool closed, double tolerance, Statistics & stats) {
+	++stats.m_polylines;
+	stats.m_vertices += points.size();
+
+	double tol = std::max(tolerance, 0.0);
+	double exact2 = tol * EXACT_TOLERANCE_FRACTION;
+	exact2 *= exact2;
+
+	std::size_t duplicates = removeDuplicates(points, closed, exact2);
+	std::size_t collinear = removeCollinear(points, closed ? 3 : 2, exact2);
+	std::size_t simplified = 0;
+	if (tol > 0)
+		simplified = douglasPeucker(points, closed, tol * tol);
+
+	stats.m_duplicates += duplicates;
+	stats.m_collinear += collinear;
+	stats.m_simplified += simplified;
+
+	bool modified = duplicates + collinear + simplified > 0;
+	if (modified)
+		++stats.m_modifiedPolylines;
+	return modified;
+}
+
+} // namespace PolylineSimplification
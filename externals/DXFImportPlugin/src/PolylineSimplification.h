@@ -0,0 +1,56 @@
+#ifndef PolylineSimplificationH
+#define PolylineSimplificationH
+
+#include <cstddef>
+#include <vector>
+
+#include <IBKMK_Vector2D.h>
+
+/*! Simplification of polylines during import.
+
+	Survey and GIS exports often contain polylines with thousands of duplicate or collinear
+	vertices. Vertices are removed in three stages:
+	- consecutive duplicates,
+	- points lying on the segment between their neighbours,
+	- Douglas-Peucker simplification, no vertex of the original polyline deviates more than
+	  the tolerance from the simplified polyline.
+	Duplicates and collinear points are detected with a small fraction of the tolerance only,
+	so that their removal does not add to the deviation of the Douglas-Peucker stage.
+
+	The tolerance is in drawing units, callers convert the tolerance in metres with the
+	drawing scaling factor.
+*/
+namespace PolylineSimplification {
+
+/*! Number of removed vertices per stage, accumulated over all simplified polylines. */
+struct Statistics {
+	/*! Number of processed polylines. */
+	std::size_t		m_polylines = 0;
+	/*! Number of polylines with removed vertices. */
+	std::size_t		m_modifiedPolylines = 0;
+	/*! Number of vertices before simplification. */
+	std::size_t		m_vertices = 0;
+	/*! Removed consecutive duplicates. */
+	std::size_t		m_duplicates = 0;
+	/*! Removed points on the segment between their neighbours. */
+	std::size_t		m_collinear = 0;
+	/*! Removed by Douglas-Peucker simplification. */
+	std::size_t		m_simplified = 0;
+
+	/*! Number of vertices after simplification. */
+	std::size_t remainingVertices() const { return m_vertices - m_duplicates - m_collinear - m_simplified; }
+};
+
+/*! Simplifies a polyline in place.
+	\param points Vertices of the polyline.
+	\param closed If true, the last vertex is connected to the first one. At least 3 vertices are kept,
+		a repeated first vertex at the end is removed.
+	\param tolerance Maximum deviation in drawing units, if <= 0 only exact duplicates are removed.
+	\param stats Statistics are added to.
+	\returns true, if vertices were removed.
+*/
+bool simplify(std::vector<IBKMK::Vector2D> & points, bool closed, double tolerance, Statistics & stats);
+
+} // namespace PolylineSimplification
+
+#endif // PolylineSimplificationH
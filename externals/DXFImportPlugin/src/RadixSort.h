@@ -0,0 +1,72 @@
+#ifndef RadixSortH
+#define RadixSortH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ParallelFor.h"
+
+/*! Sorts items stably by a key of keyWords 32 bit words, word(item, w) returns word w of the key of item,
+	word 0 is the most significant one.
+
+	LSD radix sort with 8 bit digits. Every pass counts the digits of blocks of items in separate histograms
+	and scatters each block to its own precomputed offsets, hence both steps run on parallelFor() without any
+	synchronisation. Passes in which all items have the same digit are skipped, so keys with common high bits
+	(e.g. grid cells of a drawing) need only a few passes. buffer is used as scratch space.
+*/
+template <typename T, typename WordFunc>
+void parallelRadixSort(std::vector<T> & items, std::vector<T> & buffer, unsigned int keyWords, const WordFunc & word) {
+	const std::size_t BLOCK_SIZE = 4096;
+	const std::size_t RADIX = 256;
+
+	std::size_t count = items.size();
+	if (count < 2)
+		return;
+	buffer.resize(count);
+
+	std::size_t blocks = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	// counts[b*RADIX + d]: number of items with digit d in block b, then offset of these items in the output
+	std::vector<std::size_t> counts(blocks * RADIX);
+
+	for (unsigned int w = keyWords; w-- > 0; ) {
+		for (unsigned int shift = 0; shift < 32; shift += 8) {
+			std::fill(counts.begin(), counts.end(), 0);
+			parallelFor(blocks, [&](std::size_t b) {
+				std::size_t * c = &counts[b * RADIX];
+				std::size_t last = std::min(count, (b + 1) * BLOCK_SIZE);
+				for (std::size_t i = b * BLOCK_SIZE; i < last; ++i)
+					++c[(word(items[i], w) >> shift) & (RADIX - 1)];
+			}, 1);
+
+			// exclusive prefix sum, digit-major, so that blocks keep their order within a digit (stable)
+			std::size_t offset = 0;
+			bool sameDigit = false;
+			for (std::size_t d = 0; d < RADIX; ++d) {
+				std::size_t digitCount = 0;
+				for (std::size_t b = 0; b < blocks; ++b) {
+					std::size_t c = counts[b * RADIX + d];
+					counts[b * RADIX + d] = offset;
+					offset += c;
+					digitCount += c;
+				}
+				if (digitCount == count)
+					sameDigit = true;
+			}
+			if (sameDigit)
+				continue;
+
+			parallelFor(blocks, [&](std::size_t b) {
+				std::size_t * offsets = &counts[b * RADIX];
+				std::size_t last = std::min(count, (b + 1) * BLOCK_SIZE);
+				for (std::size_t i = b * BLOCK_SIZE; i < last; ++i)
+					buffer[offsets[(word(items[i], w) >> shift) & (RADIX - 1)]++] = std::move(items[i]);
+			}, 1);
+			items.swap(buffer);
+		}
+	}
+}
+
+#endif // RadixSortH
@@ -0,0 +1,192 @@
+#include "SplineTessellation.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <algorithm>
+
+#include "Constants.h"
+
+namespace SplineTessellation {
+
+/*! Maximum number of cached knot vectors, further knot vectors are computed for each call. */
+static const std::size_t MAX_CACHED_KNOT_VECTORS = 4096;
+
+
+/*! Computes spans and reciprocal knot differences of a knot vector. */
+static void computeKnotVector(unsigned int degree, const std::vector<double> & knots, KnotVector & kv) {
+	kv.m_degree = degree;
+	kv.m_knots = knots;
+
+	// valid parameter range is [knots[degree], knots[n]], n number of control points
+	unsigned int n = (unsigned int)knots.size() - degree - 1;
+	for (unsigned int k = degree; k < n; ++k) {
+		if (!(knots[k] < knots[k+1]))
+			continue;
+		kv.m_spans.push_back(k);
+		// same loop order as in Evaluator::point()
+		for (unsigned int r = 1; r <= degree; ++r) {
+			for (unsigned int j = degree; j >= r; --j) {
+				double d = knots[j+1+k-r] - knots[j+k-degree];
+				kv.m_reciprocals.push_back(d > 0 ? 1.0 / d : 0.0);
+			}
+		}
+	}
+}
+
+
+std::shared_ptr<const KnotVector> knotVector(unsigned int degree, const std::vector<double> & knots) {
+	typedef std::pair<unsigned int, std::vector<double> > Key;
+	static std::map<Key, std::shared_ptr<const KnotVector> > cache;
+	static std::mutex cacheMutex;
+
+	Key key(degree, knots);
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		std::map<Key, std::shared_ptr<const KnotVector> >::const_iterator it = cache.find(key);
+		if (it != cache.end())
+			return it->second;
+	}
+
+	// computed outside the lock, another thread may insert the same knot vector meanwhile
+	std::shared_ptr<KnotVector> kv = std::make_shared<KnotVector>();
+	computeKnotVector(degree, knots, *kv);
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	if (cache.size() < MAX_CACHED_KNOT_VECTORS)
+		cache.insert(std::make_pair(std::move(key), kv));
+	return kv;
+}
+
+
+/*! Evaluates points of one spline with de Boor's algorithm. */
+class Evaluator {
+public:
+	Evaluator(const KnotVector & kv, const std::vector<IBKMK::Vector2D> & controlPoints,
+			  const std::vector<double> & weights) :
+		m_kv(kv), m_controlPoints(controlPoints), m_weights(weights),
+		m_x(kv.m_degree + 1), m_y(kv.m_degree + 1), m_w(kv.m_degree + 1)
+	{
+	}
+
+	/*! Evaluates the polynomial piece of span 'span' (index into KnotVector::m_spans) at u. */
+	IBKMK::Vector2D point(unsigned int span, double u) {
+		const unsigned int p = m_kv.m_degree;
+		const unsigned int k = m_kv.m_spans[span];
+		const double * reciprocal = m_kv.m_reciprocals.data() + span * (p * (p + 1) / 2);
+		const std::vector<double> & knots = m_kv.m_knots;
+
+		// homogeneous coordinates of the affected control points
+		for (unsigned int j = 0; j <= p; ++j) {
+			const IBKMK::Vector2D & cp = m_controlPoints[j+k-p];
+			double w = m_weights.empty() ? 1.0 : m_weights[j+k-p];
+			m_x[j] = cp.m_x * w;
+			m_y[j] = cp.m_y * w;
+			m_w[j] = w;
+		}
+		for (unsigned int r = 1; r <= p; ++r) {
+			for (unsigned int j = p; j >= r; --j) {
+				double alpha = (u - knots[j+k-p]) * *reciprocal++;
+				m_x[j] = (1 - alpha) * m_x[j-1] + alpha * m_x[j];
+				m_y[j] = (1 - alpha) * m_y[j-1] + alpha * m_y[j];
+				m_w[j] = (1 - alpha) * m_w[j-1] + alpha * m_w[j];
+			}
+		}
+		return IBKMK::Vector2D(m_x[p] / m_w[p], m_y[p] / m_w[p]);
+	}
+
+private:
+	const KnotVector &						m_kv;
+	const std::vector<IBKMK::Vector2D> &	m_controlPoints;
+	const std::vector<double> &				m_weights;
+	/*! Scratch space of de Boor's algorithm. */
+	std::vector<double>						m_x;
+	std::vector<double>						m_y;
+	std::vector<double>						m_w;
+};
+
+
+/*! Squared distance of p from the line segment a-b. */
+static double distanceToChord2(const IBKMK::Vector2D & a, const IBKMK::Vector2D & b, const IBKMK::Vector2D & p) {
+	double dx = b.m_x - a.m_x;
+	double dy = b.m_y - a.m_y;
+	double px = p.m_x - a.m_x;
+	double py = p.m_y - a.m_y;
+	double len2 = dx * dx + dy * dy;
+	double t = len2 > 0 ? std::max(0.0, std::min(1.0, (px * dx + py * dy) / len2)) : 0.0;
+	double ex = px - t * dx;
+	double ey = py - t * dy;
+	return ex * ex + ey * ey;
+}
+
+
+/*! Appends the points of the curve between t0 and t1 to points, p0 is already part of the
+	points, pm is the curve point at the middle of the parameter interval.
+*/
+static void subdivide(Evaluator & eval, unsigned int span, double t0, const IBKMK::Vector2D & p0,
+					  double t1, const IBKMK::Vector2D & p1, const IBKMK::Vector2D & pm,
+					  double maxDeviation2, unsigned int depth, std::vector<IBKMK::Vector2D> & points)
+{
+	if (depth < MAX_SPLINE_SUBDIVISION_DEPTH) {
+		double tm = 0.5 * (t0 + t1);
+		// quarter points catch inflections where the middle point lies on the chord
+		IBKMK::Vector2D q1 = eval.point(span, 0.5 * (t0 + tm));
+		IBKMK::Vector2D q3 = eval.point(span, 0.5 * (tm + t1));
+		if (distanceToChord2(p0, p1, pm) > maxDeviation2 ||
+			distanceToChord2(p0, p1, q1) > maxDeviation2 ||
+			distanceToChord2(p0, p1, q3) > maxDeviation2)
+		{
+			subdivide(eval, span, t0, p0, tm, pm, q1, maxDeviation2, depth + 1, points);
+			subdivide(eval, span, tm, pm, t1, p1, q3, maxDeviation2, depth + 1, points);
+			return;
+		}
+	}
+	points.push_back(p1);
+}
+
+
+bool spline(unsigned int degree, const std::vector<double> & knots, const std::vector<IBKMK::Vector2D> & controlPoints,
+			const std::vector<double> & weights, double maxDeviation, std::vector<IBKMK::Vector2D> & points)
+{
+	// check definition
+	if (degree < 1 || controlPoints.size() < degree + 1 || knots.size() != controlPoints.size() + degree + 1)
+		return false;
+	if (!weights.empty() && weights.size() != controlPoints.size())
+		return false;
+	for (unsigned int i = 1; i < knots.size(); ++i) {
+		if (knots[i] < knots[i-1])
+			return false;
+	}
+	for (double w : weights) {
+		if (!(w > 0))
+			return false;
+	}
+
+	std::shared_ptr<const KnotVector> kv = knotVector(degree, knots);
+	if (kv->m_spans.empty())
+		return false;
+
+	Evaluator eval(*kv, controlPoints, weights);
+	double maxDeviation2 = maxDeviation * maxDeviation;
+
+	points.clear();
+	for (unsigned int s = 0; s < kv->m_spans.size(); ++s) {
+		unsigned int k = kv->m_spans[s];
+		double t0 = knots[k];
+		double t1 = knots[k+1];
+		IBKMK::Vector2D p0 = eval.point(s, t0);
+		IBKMK::Vector2D p1 = eval.point(s, t1);
+		if (points.empty())
+			points.push_back(p0);
+		// linear pieces are exact
+		if (degree == 1) {
+			points.push_back(p1);
+			continue;
+		}
+		IBKMK::Vector2D pm = eval.point(s, 0.5 * (t0 + t1));
+		subdivide(eval, s, t0, p0, t1, p1, pm, maxDeviation2, 0, points);
+	}
+	return true;
+}
+
+} // namespace SplineTessellation
@@ -0,0 +1,55 @@
+#ifndef SplineTessellationH
+#define SplineTessellationH
+
+#include <memory>
+#include <vector>
+
+#include <IBKMK_Vector2D.h>
+
+/*! Tessellation of (rational) B-spline curves into polyline vertices.
+
+	Curve points are evaluated with de Boor's algorithm in homogeneous coordinates. The
+	reciprocal knot differences of the algorithm only depend on the degree and the knot vector.
+	They are precomputed once per knot vector and cached, splines sharing a knot vector (e.g.
+	uniform clamped splines with equal number of control points) share this data.
+
+	Each non-empty knot span is subdivided recursively until the quarter, middle and three quarter
+	points of a chord deviate less than the tolerance from it. Straight parts thus result in
+	single segments, strongly curved parts are refined.
+
+	All functions are reentrant, splines can be tessellated in parallel.
+*/
+namespace SplineTessellation {
+
+/*! Precomputed data of a knot vector, see knotVector(). */
+struct KnotVector {
+	unsigned int				m_degree = 0;
+	std::vector<double>			m_knots;
+	/*! Index of the first knot of each non-empty span within the valid parameter range. */
+	std::vector<unsigned int>	m_spans;
+	/*! Reciprocal knot differences used by de Boor's algorithm, degree*(degree+1)/2 values per
+		entry of m_spans, 0 for coinciding knots.
+	*/
+	std::vector<double>			m_reciprocals;
+};
+
+/*! Returns the precomputed data of the knot vector. Results are cached, the returned
+	data is shared by all callers with the same degree and knots.
+*/
+std::shared_ptr<const KnotVector> knotVector(unsigned int degree, const std::vector<double> & knots);
+
+/*! Tessellates a B-spline.
+	\param degree Degree of the spline.
+	\param knots Knot vector, must hold controlPoints.size() + degree + 1 values.
+	\param controlPoints Control points.
+	\param weights Weights of the control points, empty for non-rational splines.
+	\param maxDeviation Maximum distance between chords and curve in drawing units.
+	\param points Receives the points, including both end points.
+	\return False if the spline definition is invalid, points are not modified then.
+*/
+bool spline(unsigned int degree, const std::vector<double> & knots, const std::vector<IBKMK::Vector2D> & controlPoints,
+			const std::vector<double> & weights, double maxDeviation, std::vector<IBKMK::Vector2D> & points);
+
+} // namespace SplineTessellation
+
+#endif // SplineTessellationH
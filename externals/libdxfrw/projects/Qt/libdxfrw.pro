@@ -21,6 +21,7 @@ HEADERS += \
 ../../src/drw_header.h \
 	../../src/drw_interface.h \
 	../../src/drw_objects.h \
+	../../src/intern/drw_arena.h \
 	../../src/intern/drw_cptable932.h \
 	../../src/intern/drw_cptable936.h \
 	../../src/intern/drw_cptable949.h \
@@ -48,6 +49,7 @@ SOURCES += \
 ../../src/drw_entities.cpp \
 ../../src/drw_header.cpp \
 	../../src/drw_objects.cpp \
+	../../src/intern/drw_arena.cpp \
 	../../src/intern/drw_dbg.cpp \
 	../../src/intern/drw_textcodec.cpp \
 	../../src/intern/dwgbuffer.cpp \
@@ -20,6 +20,7 @@
 #include <string>
 #include <list>
 #include <cmath>
+#include <utility>
 
 #ifdef DRW_ASSERTS
 # define drw_assert(a) assert(a)
@@ -230,6 +231,44 @@ public:
             content.s = &sdata;
     }
 
+    // content points into sdata/vdata, so copies and moves have to redirect it
+    DRW_Variant(DRW_Variant&& d) noexcept: sdata(std::move(d.sdata)), vdata(d.vdata), content(d.content), vType(d.vType), vCode(d.vCode) {
+        if (d.vType == COORD)
+            content.v = &vdata;
+        if (d.vType == STRING)
+            content.s = &sdata;
+    }
+
+    DRW_Variant& operator=(const DRW_Variant& d) {
+        if (this != &d) {
+            sdata = d.sdata;
+            vdata = d.vdata;
+            content = d.content;
+            vType = d.vType;
+            vCode = d.vCode;
+            if (vType == COORD)
+                content.v = &vdata;
+            if (vType == STRING)
+                content.s = &sdata;
+        }
+        return *this;
+    }
+
+    DRW_Variant& operator=(DRW_Variant&& d) noexcept {
+        if (this != &d) {
+            sdata = std::move(d.sdata);
+            vdata = d.vdata;
+            content = d.content;
+            vType = d.vType;
+            vCode = d.vCode;
+            if (vType == COORD)
+                content.v = &vdata;
+            if (vType == STRING)
+                content.s = &sdata;
+        }
+        return *this;
+    }
+
     ~DRW_Variant() {
     }
 
@@ -240,8 +279,8 @@ public:
     void setCoordX(double d) { if (vType == COORD) vdata.x = d;}
     void setCoordY(double d) { if (vType == COORD) vdata.y = d;}
     void setCoordZ(double d) { if (vType == COORD) vdata.z = d;}
-    enum TYPE type() { return vType;}
-    int code() { return vCode;}            /*!< returns dxf code of this value*/
+    enum TYPE type() const { return vType;}
+    int code() const { return vCode;}            /*!< returns dxf code of this value*/
 
 private:
     std::string sdata;
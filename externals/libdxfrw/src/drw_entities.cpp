@@ -110,14 +110,13 @@ bool DRW_Entity::parseCode(int code, dxfReader *reader){
     case 1003:
     case 1004:
     case 1005:
-        extData.push_back(new DRW_Variant(code, reader->getString()));
+        addExtData(code, reader->getString());
         break;
     case 1010:
     case 1011:
     case 1012:
     case 1013:
-        curr = new DRW_Variant(code, DRW_Coord(reader->getDouble(), 0.0, 0.0));
-        extData.push_back(curr);
+        curr = addExtData(code, DRW_Coord(reader->getDouble(), 0.0, 0.0));
         break;
     case 1020:
     case 1021:
@@ -137,11 +136,11 @@ bool DRW_Entity::parseCode(int code, dxfReader *reader){
     case 1040:
     case 1041:
     case 1042:
-        extData.push_back(new DRW_Variant(code, reader->getDouble() ));
+        addExtData(code, reader->getDouble());
         break;
     case 1070:
     case 1071:
-        extData.push_back(new DRW_Variant(code, reader->getInt32() ));
+        addExtData(code, reader->getInt32());
         break;
     default:
         break;
@@ -1119,11 +1118,11 @@ void DRW_LWPolyline::applyExtrusion(){
     if (haveExtrusion) {
         calculateAxis(extPoint);
         for (unsigned int i=0; i<vertlist.size(); i++) {
-            DRW_Vertex2D *vert = vertlist.at(i);
-            DRW_Coord v(vert->x, vert->y, elevation);
+            DRW_Vertex2D &vert = vertlist[i];
+            DRW_Coord v(vert.x, vert.y, elevation);
             extrudePoint(extPoint, &v);
-            vert->x = v.x;
-            vert->y = v.y;
+            vert.x = v.x;
+            vert.y = v.y;
         }
     }
 }
@@ -1131,8 +1130,8 @@ void DRW_LWPolyline::applyExtrusion(){
 void DRW_LWPolyline::parseCode(int code, dxfReader *reader){
     switch (code) {
     case 10: {
-        vertex = new DRW_Vertex2D();
-        vertlist.push_back(vertex);
+        vertlist.push_back(DRW_Vertex2D());
+        vertex = &vertlist.back();
         vertex->x = reader->getDouble();
         break; }
     case 20:
@@ -1223,29 +1222,26 @@ bool DRW_LWPolyline::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
 
     if (vertexnum > 0) { //verify if is lwpol without vertex (empty)
         // add vertexs
-        vertex = new DRW_Vertex2D();
-        vertex->x = buf->getRawDouble();
-        vertex->y = buf->getRawDouble();
-        vertlist.push_back(vertex);
-        DRW_Vertex2D* pv = vertex;
+        DRW_Vertex2D v;
+        v.x = buf->getRawDouble();
+        v.y = buf->getRawDouble();
+        vertlist.push_back(v);
         for (int i = 1; i< vertexnum; i++){
-            vertex = new DRW_Vertex2D();
             if (version < DRW::AC1015) {//14-
-                vertex->x = buf->getRawDouble();
-                vertex->y = buf->getRawDouble();
+                v.x = buf->getRawDouble();
+                v.y = buf->getRawDouble();
             } else {
-//                DRW_Vertex2D *pv = vertlist.back();
-                vertex->x = buf->getDefaultDouble(pv->x);
-                vertex->y = buf->getDefaultDouble(pv->y);
+                v.x = buf->getDefaultDouble(v.x);
+                v.y = buf->getDefaultDouble(v.y);
             }
-            pv = vertex;
-            vertlist.push_back(vertex);
+            vertlist.push_back(v);
         }
+        vertex = NULL;
         //add bulges
         for (unsigned int i = 0; i < bulgesnum; i++){
             double bulge = buf->getBitDouble();
             if (vertlist.size()> i)
-                vertlist.at(i)->bulge = bulge;
+                vertlist[i].bulge = bulge;
         }
         //add vertexId
         if (version > DRW::AC1021) {//2010+
@@ -1262,15 +1258,15 @@ bool DRW_LWPolyline::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
             double staW = buf->getBitDouble();
             double endW = buf->getBitDouble();
             if (vertlist.size()< i) {
-                vertlist.at(i)->stawidth = staW;
-                vertlist.at(i)->endwidth = endW;
+                vertlist[i].stawidth = staW;
+                vertlist[i].endwidth = endW;
             }
         }
     }
     if (DRW_DBGGL == DRW_dbg::DEBUG){
         DRW_DBG("\nVertex list: ");
-        for (std::vector<DRW_Vertex2D *>::iterator it = vertlist.begin() ; it != vertlist.end(); ++it){
-            DRW_Vertex2D* pv = *it;
+        for (unsigned int i = 0; i < vertlist.size(); ++i){
+            const DRW_Vertex2D* pv = &vertlist[i];
             DRW_DBG("\n   x: "); DRW_DBG(pv->x); DRW_DBG(" y: "); DRW_DBG(pv->y); DRW_DBG(" bulge: "); DRW_DBG(pv->bulge);
             DRW_DBG(" stawidth: "); DRW_DBG(pv->stawidth); DRW_DBG(" endwidth: "); DRW_DBG(pv->endwidth);
         }
@@ -1770,6 +1766,7 @@ void DRW_Hatch::parseCode(int code, dxfReader *reader){
         break;
     case 73:
         if (arc) arc->isccw = reader->getInt32();
+        else if (ellipse) ellipse->isccw = reader->getInt32();
         else if (pline) pline->flags = reader->getInt32();
         break;
     case 75:
@@ -1912,19 +1909,16 @@ bool DRW_Hatch::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
                     }
                     for (dint32 j = 0; j < spline->ncontrol;++j){
                         // pt0 2RD 10 control point
-                        DRW_Coord* crd = new DRW_Coord(buf->get2RawDouble());
-                        spline->controllist.push_back(crd);
+                        spline->controllist.push_back(buf->get2RawDouble());
                         if(isRational)
-                            crd->z =  buf->getBitDouble(); //RLZ: investigate how store weight
-                        spline->controllist.push_back(crd);
+                            spline->controllist.back().z =  buf->getBitDouble(); //RLZ: investigate how store weight
                     }
                     if (version > DRW::AC1021) { //2010+
                         spline->nfit = buf->getBitLong();
                         spline->fitlist.reserve(spline->nfit);
                         for (dint32 j = 0; j < spline->nfit;++j){
                             // Fitpoint 2RD 11
-                            DRW_Coord* crd = new DRW_Coord(buf->get2RawDouble());
-                            spline->fitlist.push_back (crd);
+                            spline->fitlist.push_back(buf->get2RawDouble());
                         }
                         spline->tgStart = buf->get2RawDouble();
                         spline->tgEnd = buf->get2RawDouble();
@@ -2060,8 +2054,8 @@ void DRW_Spline::parseCode(int code, dxfReader *reader){
         tolfit = reader->getDouble();
         break;
     case 10: {
-        controlpoint = new DRW_Coord();
-        controllist.push_back(controlpoint);
+        controllist.push_back(DRW_Coord());
+        controlpoint = &controllist.back();
         controlpoint->x = reader->getDouble();
         break; }
     case 20:
@@ -2073,8 +2067,8 @@ void DRW_Spline::parseCode(int code, dxfReader *reader){
             controlpoint->z = reader->getDouble();
         break;
     case 11: {
-        fitpoint = new DRW_Coord();
-        fitlist.push_back(fitpoint);
+        fitlist.push_back(DRW_Coord());
+        fitpoint = &fitlist.back();
         fitpoint->x = reader->getDouble();
         break; }
     case 21:
@@ -2088,8 +2082,9 @@ void DRW_Spline::parseCode(int code, dxfReader *reader){
     case 40:
         knotslist.push_back(reader->getDouble());
         break;
-//    case 41:
-//        break;
+    case 41:
+        weightlist.push_back(reader->getDouble());
+        break;
     default:
         DRW_Entity::parseCode(code, reader);
         break;
@@ -2150,17 +2145,18 @@ bool DRW_Spline::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
         knotslist.push_back (buf->getBitDouble());
     }
     controllist.reserve(ncontrol);
+    if (weight)
+        weightlist.reserve(ncontrol);
     for (dint32 i= 0; i<ncontrol; ++i){
-        DRW_Coord* crd = new DRW_Coord(buf->get3BitDouble());
-        controllist.push_back(crd);
+        controllist.push_back(buf->get3BitDouble());
         if (weight){
-            DRW_DBG("\n w: "); DRW_DBG(buf->getBitDouble()); //RLZ Warning: D (BD or RD)
+            weightlist.push_back(buf->getBitDouble()); //RLZ Warning: D (BD or RD)
+            DRW_DBG("\n w: "); DRW_DBG(weightlist.back());
         }
     }
     fitlist.reserve(nfit);
     for (dint32 i= 0; i<nfit; ++i){
-        DRW_Coord* crd = new DRW_Coord(buf->get3BitDouble());
-        fitlist.push_back (crd);
+        fitlist.push_back(buf->get3BitDouble());
     }
     if (DRW_DBGGL == DRW_dbg::DEBUG){
         DRW_DBG("\nknots list: ");
@@ -2168,12 +2164,12 @@ bool DRW_Spline::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
             DRW_DBG("\n"); DRW_DBG(*it);
         }
         DRW_DBG("\ncontrol point list: ");
-        for (std::vector<DRW_Coord *>::iterator it = controllist.begin() ; it != controllist.end(); ++it){
-            DRW_DBG("\n"); DRW_DBGPT((*it)->x,(*it)->y,(*it)->z);
+        for (unsigned int i = 0; i < controllist.size(); ++i){
+            DRW_DBG("\n"); DRW_DBGPT(controllist[i].x,controllist[i].y,controllist[i].z);
         }
         DRW_DBG("\nfit point list: ");
-        for (std::vector<DRW_Coord *>::iterator it = fitlist.begin() ; it != fitlist.end(); ++it){
-            DRW_DBG("\n"); DRW_DBGPT((*it)->x,(*it)->y,(*it)->z);
+        for (unsigned int i = 0; i < fitlist.size(); ++i){
+            DRW_DBG("\n"); DRW_DBGPT(fitlist[i].x,fitlist[i].y,fitlist[i].z);
         }
     }
 
@@ -17,7 +17,9 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <utility>
 #include "drw_base.h"
+#include "intern/drw_arena.h"
 
 class dxfReader;
 class dwgBuffer;
@@ -109,7 +111,7 @@ public:
                   haveExtrusion(false), extData(), haveNextLinks(0),plotFlags(0), ltFlags(0),materialFlag(0),
                   shadowFlag(0), lTypeH(dwgHandle()), layerH(dwgHandle()), nextEntLink(0), prevEntLink(0),
                   ownerHandle(false), xDictFlag(0), numReactors(0), objSize(0), oType(0), extAxisX(DRW_Coord()),
-                  extAxisY(DRW_Coord()), curr(NULL) {}
+                  extAxisY(DRW_Coord()), curr(NULL), extArena(DRW_Arena::current()) {}
 
     DRW_Entity(const DRW_Entity& e) {
         eType = e.eType;
@@ -134,25 +136,39 @@ public:
         numReactors = e.numReactors;
         xDictFlag = e.xDictFlag;
         curr = NULL;
+        extArena = NULL; //copies own their data
         ownerHandle= false;
         for (std::vector<DRW_Variant*>::const_iterator it=e.extData.begin(); it!=e.extData.end(); ++it){
-            extData.push_back(new DRW_Variant(*(*it)));
+            addExtData(*(*it));
         }
     }
 
     virtual ~DRW_Entity() {
-        for (std::vector<DRW_Variant*>::iterator it=extData.begin(); it!=extData.end(); ++it)
-            delete *it;
-
-        extData.clear();
+        reset();
     }
 
     void reset(){
-        for (std::vector<DRW_Variant*>::iterator it=extData.begin(); it!=extData.end(); ++it)
-            delete *it;
+        for (std::vector<DRW_Variant*>::iterator it=extData.begin(); it!=extData.end(); ++it) {
+            if (extArena)
+                (*it)->~DRW_Variant();
+            else
+                delete *it;
+        }
         extData.clear();
     }
 
+    //constructs a new extended data value at the end of extData
+    template <class... Args>
+    DRW_Variant *addExtData(Args&&... args) {
+        DRW_Variant *v;
+        if (extArena)
+            v = new (extArena->allocate(sizeof(DRW_Variant), alignof(DRW_Variant))) DRW_Variant(std::forward<Args>(args)...);
+        else
+            v = new DRW_Variant(std::forward<Args>(args)...);
+        extData.push_back(v);
+        return v;
+    }
+
     virtual void applyExtrusion() = 0;
 
 protected:
@@ -215,6 +231,7 @@ private:
     DRW_Coord extAxisX;
     DRW_Coord extAxisY;
     DRW_Variant* curr;
+    DRW_Arena *extArena;  //storage of extData values, NULL for heap
 };
 
 
@@ -588,7 +605,7 @@ public:
         vertex = NULL;
     }
     
-    DRW_LWPolyline(const DRW_LWPolyline& p):DRW_Entity(p){
+    DRW_LWPolyline(const DRW_LWPolyline& p):DRW_Entity(p), vertlist(p.vertlist){
         this->eType = DRW::LWPOLYLINE;
         this->elevation = p.elevation;
         this->thickness = p.thickness;
@@ -596,34 +613,16 @@ public:
         this->flags = p.flags;
         this->extPoint = p.extPoint;
         this->vertex = NULL;
-        for (unsigned i=0; i<p.vertlist.size(); i++)// RLZ ok or new
-          this->vertlist.push_back( new DRW_Vertex2D( *(p.vertlist.at(i)) ) );
-
-        this->vertex = NULL;
     }
 
-    ~DRW_LWPolyline() {
-        while (!vertlist.empty()) {
-            vertlist.pop_back();
-        }
-    }
     virtual void applyExtrusion();
     void addVertex (DRW_Vertex2D v) {
-        DRW_Vertex2D *vert = new DRW_Vertex2D();
-        vert->x = v.x;
-        vert->y = v.y;
-        vert->stawidth = v.stawidth;
-        vert->endwidth = v.endwidth;
-        vert->bulge = v.bulge;
-        vertlist.push_back(vert);
+        vertlist.push_back(v);
     }
+    //returned pointer is valid until next vertex is added
     DRW_Vertex2D *addVertex () {
-        DRW_Vertex2D *vert = new DRW_Vertex2D();
-        vert->stawidth = 0;
-        vert->endwidth = 0;
-        vert->bulge = 0;
-        vertlist.push_back(vert);
-        return vert;
+        vertlist.push_back(DRW_Vertex2D());
+        return &vertlist.back();
     }
 
 protected:
@@ -638,7 +637,7 @@ public:
     double thickness;         /*!< thickness, code 39 */
     DRW_Coord extPoint;       /*!<  Dir extrusion normal vector, code 210, 220 & 230 */
     DRW_Vertex2D *vertex;       /*!< current vertex to add data */
-    std::vector<DRW_Vertex2D *> vertlist;  /*!< vertex list */
+    std::vector<DRW_Vertex2D, DRW_ArenaAllocator<DRW_Vertex2D> > vertlist;  /*!< vertex list */
 };
 
 //! Class to handle insert entries
@@ -796,23 +795,41 @@ public:
         flags = vertexcount = facecount = 0;
         smoothM = smoothN = curvetype = 0;
     }
+    DRW_Polyline(const DRW_Polyline& p):DRW_Point(p), flags(p.flags), defstawidth(p.defstawidth),
+        defendwidth(p.defendwidth), vertexcount(p.vertexcount), facecount(p.facecount), smoothM(p.smoothM),
+        smoothN(p.smoothN), curvetype(p.curvetype), vertlist(DRW_ArenaAllocator<DRW_Vertex *>(NULL)),
+        hadlesList(p.hadlesList), firstEH(p.firstEH), lastEH(p.lastEH), seqEndH(p.seqEndH) {
+        for (std::vector<DRW_Vertex *>::size_type i = 0; i < p.vertlist.size(); ++i)
+            vertlist.push_back(new DRW_Vertex(*p.vertlist[i]));
+    }
     ~DRW_Polyline() {
-        while (!vertlist.empty()) {
-           vertlist.pop_back();
-         }
+        DRW_Arena *arena = vertlist.get_allocator().arena;
+        for (std::vector<DRW_Vertex *>::size_type i = 0; i < vertlist.size(); ++i) {
+            if (arena)
+                vertlist[i]->~DRW_Vertex();
+            else
+                delete vertlist[i];
+        }
     }
     void addVertex (DRW_Vertex v) {
-        DRW_Vertex *vert = new DRW_Vertex();
+        DRW_Vertex *vert = newVertex();
         vert->basePoint.x = v.basePoint.x;
         vert->basePoint.y = v.basePoint.y;
         vert->basePoint.z = v.basePoint.z;
         vert->stawidth = v.stawidth;
         vert->endwidth = v.endwidth;
         vert->bulge = v.bulge;
-        vertlist.push_back(vert);
     }
-    void appendVertex (DRW_Vertex *v) {
-        vertlist.push_back(v);
+    //appends a default vertex owned by the polyline, allocated from the same storage as vertlist
+    DRW_Vertex *newVertex () {
+        DRW_Arena *arena = vertlist.get_allocator().arena;
+        DRW_Vertex *vert;
+        if (arena)
+            vert = new (arena->allocate(sizeof(DRW_Vertex), alignof(DRW_Vertex))) DRW_Vertex();
+        else
+            vert = new DRW_Vertex();
+        vertlist.push_back(vert);
+        return vert;
     }
 
 protected:
@@ -829,13 +846,15 @@ public:
     int smoothN;             /*!< smooth surface M density, code 74, default 0 */
     int curvetype;           /*!< curves & smooth surface type, code 75, default 0 */
 
-    std::vector<DRW_Vertex *> vertlist;  /*!< vertex list */
+    std::vector<DRW_Vertex *, DRW_ArenaAllocator<DRW_Vertex *> > vertlist;  /*!< vertex list */
 
 private:
     std::list<duint32>hadlesList; //list of handles, only in 2004+
     duint32 firstEH;      //handle of first entity, only in pre-2004
     duint32 lastEH;       //handle of last entity, only in pre-2004
     dwgHandle seqEndH;    //handle of SEQEND entity
+
+    DRW_Polyline& operator=(const DRW_Polyline&); //vertices are owned, not assignable
 };
 
 
@@ -851,16 +870,9 @@ public:
         eType = DRW::SPLINE;
         flags = nknots = ncontrol = nfit = 0;
         tolknot = tolcontrol = tolfit = 0.0000001;
+        controlpoint = fitpoint = NULL;
 
     }
-    ~DRW_Spline() {
-        while (!controllist.empty()) {
-           controllist.pop_back();
-        }
-        while (!fitlist.empty()) {
-           fitlist.pop_back();
-        }
-    }
     virtual void applyExtrusion(){}
 
 protected:
@@ -890,8 +902,9 @@ public:
     double tolfit;            /*!< fit point tolerance, code 44, default 0.0000001 */
 
     std::vector<double> knotslist;           /*!< knots list, code 40 */
-    std::vector<DRW_Coord *> controllist;  /*!< control points list, code 10, 20 & 30 */
-    std::vector<DRW_Coord *> fitlist;      /*!< fit points list, code 11, 21 & 31 */
+    std::vector<double> weightlist;          /*!< weight list, code 41, empty if not rational */
+    std::vector<DRW_Coord, DRW_ArenaAllocator<DRW_Coord> > controllist;  /*!< control points list, code 10, 20 & 30 */
+    std::vector<DRW_Coord, DRW_ArenaAllocator<DRW_Coord> > fitlist;      /*!< fit points list, code 11, 21 & 31 */
 
 private:
     DRW_Coord *controlpoint;   /*!< current control point to add data */
@@ -914,9 +927,8 @@ public:
 /*        while (!pollist.empty()) {
            pollist.pop_back();
          }*/
-        while (!objlist.empty()) {
-           objlist.pop_back();
-         }
+        for (std::vector<DRW_Entity *>::iterator it = objlist.begin(); it != objlist.end(); ++it)
+            delete *it;
     }
 
     void update() {
@@ -952,9 +964,9 @@ public:
     }
 
     ~DRW_Hatch() {
-        while (!looplist.empty()) {
-           looplist.pop_back();
-         }
+        //loops are created by parseCode()/parseDwg() and owned by the hatch
+        for (std::vector<DRW_HatchLoop *>::iterator it = looplist.begin(); it != looplist.end(); ++it)
+            delete *it;
     }
 
     void appendLoop (DRW_HatchLoop *v) {
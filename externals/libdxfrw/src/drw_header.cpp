@@ -16,10 +16,61 @@
 #include "intern/drw_dbg.h"
 #include "intern/dwgbuffer.h"
 
+#include <algorithm>
+
+DRW_HeaderVars::iterator DRW_HeaderVars::find(const std::string &key) {
+    iterator it = std::lower_bound(entries.begin(), entries.end(), key,
+                                   [](const value_type &e, const std::string &k) { return e.first < k; });
+    if (it != entries.end() && it->first == key)
+        return it;
+    return entries.end();
+}
+
+DRW_HeaderVars::const_iterator DRW_HeaderVars::find(const std::string &key) const {
+    const_iterator it = std::lower_bound(entries.begin(), entries.end(), key,
+                                         [](const value_type &e, const std::string &k) { return e.first < k; });
+    if (it != entries.end() && it->first == key)
+        return it;
+    return entries.end();
+}
+
+const DRW_Variant *DRW_HeaderVars::get(const std::string &key) const {
+    const_iterator it = find(key);
+    return it != entries.end() ? &it->second : NULL;
+}
+
+DRW_Variant &DRW_HeaderVars::operator[](const std::string &key) {
+    // fast path for sorted input
+    if (entries.empty() || entries.back().first < key) {
+        entries.emplace_back(key, DRW_Variant());
+        return entries.back().second;
+    }
+    iterator it = std::lower_bound(entries.begin(), entries.end(), key,
+                                   [](const value_type &e, const std::string &k) { return e.first < k; });
+    if (it == entries.end() || it->first != key)
+        it = entries.emplace(it, key, DRW_Variant());
+    return it->second;
+}
+
 DRW_Header::DRW_Header() {
     linetypeCtrl = layerCtrl = styleCtrl = dimstyleCtrl = appidCtrl = 0;
     blockCtrl = viewCtrl = ucsCtrl = vportCtrl = vpEntHeaderCtrl = 0;
     version = DRW::AC1021;
+    curr = NULL;
+}
+
+void DRW_Header::setFilter(const std::vector<std::string> &names){
+    filter = names;
+    if (!filter.empty()) {
+        filter.push_back("$ACADVER");
+        filter.push_back("$DWGCODEPAGE");
+    }
+    std::sort(filter.begin(), filter.end());
+    filter.erase(std::unique(filter.begin(), filter.end()), filter.end());
+}
+
+bool DRW_Header::isFiltered(const std::string &key) const {
+    return !filter.empty() && !std::binary_search(filter.begin(), filter.end(), key);
 }
 
 void DRW_Header::addComment(std::string c){
@@ -29,13 +80,15 @@ void DRW_Header::addComment(std::string c){
 }
 
 void DRW_Header::parseCode(int code, dxfReader *reader){
+    // values of skipped variables are not converted
+    if (code != 9 && curr == NULL)
+        return;
     switch (code) {
     case 9:
-        curr = new DRW_Variant();
         name = reader->getString();
         if (version < DRW::AC1015 && name == "$DIMUNIT")
             name="$DIMLUNIT";
-        vars[name]=curr;
+        curr = isFiltered(name) ? NULL : &vars[name];
         break;
     case 1:
         curr->addString(code, reader->getUtf8String());
@@ -1661,7 +1714,7 @@ void DRW_Header::write(dxfWriter *writer, DRW::Version ver){
     }
 
 #ifdef DRW_DBG
-    std::map<std::string,DRW_Variant *>::const_iterator it;
+    DRW_HeaderVars::const_iterator it;
     for ( it=vars.begin() ; it != vars.end(); ++it ){
         DRW_DBG((*it).first); DRW_DBG("\n");
     }
@@ -1669,87 +1722,59 @@ void DRW_Header::write(dxfWriter *writer, DRW::Version ver){
 }
 
 void DRW_Header::addDouble(std::string key, double value, int code){
-    curr = new DRW_Variant(code, value);
-    vars[key] =curr;
+    vars[key] = DRW_Variant(code, value);
+    curr = NULL;
 }
 
 void DRW_Header::addInt(std::string key, int value, int code){
-    curr = new DRW_Variant(code, value);
-    vars[key] =curr;
+    vars[key] = DRW_Variant(code, value);
+    curr = NULL;
 }
 
 void DRW_Header::addStr(std::string key, std::string value, int code){
-    curr = new DRW_Variant(code, value);
-    vars[key] =curr;
+    vars[key] = DRW_Variant(code, value);
+    curr = NULL;
 }
 
 void DRW_Header::addCoord(std::string key, DRW_Coord value, int code){
-    curr = new DRW_Variant(code, value);
-    vars[key] =curr;
+    vars[key] = DRW_Variant(code, value);
+    curr = NULL;
 }
 
-bool DRW_Header::getDouble(std::string key, double *varDouble){
-    bool result = false;
-    std::map<std::string,DRW_Variant *>::iterator it;
-    it=vars.find( key);
-    if (it != vars.end()) {
-        DRW_Variant *var = (*it).second;
-        if (var->type() == DRW_Variant::DOUBLE) {
-            *varDouble = var->content.d;
-            result = true;
-        }
-        delete var;
-        vars.erase (it);
+bool DRW_Header::getDouble(std::string key, double *varDouble) const {
+    const DRW_Variant *var = vars.get(key);
+    if (var != NULL && var->type() == DRW_Variant::DOUBLE) {
+        *varDouble = var->content.d;
+        return true;
     }
-    return result;
+    return false;
 }
 
-bool DRW_Header::getInt(std::string key, int *varInt){
-    bool result = false;
-    std::map<std::string,DRW_Variant *>::iterator it;
-    it=vars.find( key);
-    if (it != vars.end()) {
-        DRW_Variant *var = (*it).second;
-        if (var->type() == DRW_Variant::INTEGER) {
-            *varInt = var->content.i;
-            result = true;
-        }
-        delete var;
-        vars.erase (it);
+bool DRW_Header::getInt(std::string key, int *varInt) const {
+    const DRW_Variant *var = vars.get(key);
+    if (var != NULL && var->type() == DRW_Variant::INTEGER) {
+        *varInt = var->content.i;
+        return true;
     }
-    return result;
+    return false;
 }
 
-bool DRW_Header::getStr(std::string key, std::string *varStr){
-    bool result = false;
-    std::map<std::string,DRW_Variant *>::iterator it;
-    it=vars.find( key);
-    if (it != vars.end()) {
-        DRW_Variant *var = (*it).second;
-        if (var->type() == DRW_Variant::STRING) {
-            *varStr = *var->content.s;
-            result = true;
-        }
-        delete var;
-        vars.erase (it);
+bool DRW_Header::getStr(std::string key, std::string *varStr) const {
+    const DRW_Variant *var = vars.get(key);
+    if (var != NULL && var->type() == DRW_Variant::STRING) {
+        *varStr = *var->content.s;
+        return true;
     }
-    return result;
+    return false;
 }
 
-bool DRW_Header::getCoord(std::string key, DRW_Coord *varCoord){
-    bool result = false;
-    std::map<std::string,DRW_Variant *>::iterator it;
-    it=vars.find( key);
-    if (it != vars.end()) {
-        DRW_Variant *var = (*it).second;
-        if (var->type() == DRW_Variant::COORD) {
-            *varCoord = *var->content.v;
-            result = true;
-        }
-        delete var;
-        vars.erase (it);
+bool DRW_Header::getCoord(std::string key, DRW_Coord *varCoord) const {
+    const DRW_Variant *var = vars.get(key);
+    if (var != NULL && var->type() == DRW_Variant::COORD) {
+        *varCoord = *var->content.v;
+        return true;
     }
-    return result;
+    return false;
 }
 
 bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf, duint8 mv){
@@ -1800,128 +1825,128 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         dwgHandle hcv = hBbuf->getHandle();
         DRW_DBG("\nhandle of current view: "); DRW_DBGHL(hcv.code, hcv.size, hcv.ref);
     }
-    vars["DIMASO"]=new DRW_Variant(70, buf->getBit());
-    vars["DIMSHO"]=new DRW_Variant(70, buf->getBit());
+    vars["DIMASO"]=DRW_Variant(70, buf->getBit());
+    vars["DIMSHO"]=DRW_Variant(70, buf->getBit());
     if (version < DRW::AC1015) {//pre 2000
-        vars["DIMSAV"]=new DRW_Variant(70, buf->getBit());
-    }
-    vars["PLINEGEN"]=new DRW_Variant(70, buf->getBit());
-    vars["ORTHOMODE"]=new DRW_Variant(70, buf->getBit());
-    vars["REGENMODE"]=new DRW_Variant(70, buf->getBit());
-    vars["FILLMODE"]=new DRW_Variant(70, buf->getBit());
-    vars["QTEXTMODE"]=new DRW_Variant(70, buf->getBit());
-    vars["PSLTSCALE"]=new DRW_Variant(70, buf->getBit());
-    vars["LIMCHECK"]=new DRW_Variant(70, buf->getBit());
+        vars["DIMSAV"]=DRW_Variant(70, buf->getBit());
+    }
+    vars["PLINEGEN"]=DRW_Variant(70, buf->getBit());
+    vars["ORTHOMODE"]=DRW_Variant(70, buf->getBit());
+    vars["REGENMODE"]=DRW_Variant(70, buf->getBit());
+    vars["FILLMODE"]=DRW_Variant(70, buf->getBit());
+    vars["QTEXTMODE"]=DRW_Variant(70, buf->getBit());
+    vars["PSLTSCALE"]=DRW_Variant(70, buf->getBit());
+    vars["LIMCHECK"]=DRW_Variant(70, buf->getBit());
     if (version < DRW::AC1015) {//pre 2000
-        vars["BLIPMODE"]=new DRW_Variant(70, buf->getBit());
+        vars["BLIPMODE"]=DRW_Variant(70, buf->getBit());
     }
     if (version > DRW::AC1015) {//2004+
          DRW_DBG("\nUndocumented: "); DRW_DBG(buf->getBit());
     }
-    vars["USRTIMER"]=new DRW_Variant(70, buf->getBit());
-    vars["SKPOLY"]=new DRW_Variant(70, buf->getBit());
-    vars["ANGDIR"]=new DRW_Variant(70, buf->getBit());
-    vars["SPLFRAME"]=new DRW_Variant(70, buf->getBit());
+    vars["USRTIMER"]=DRW_Variant(70, buf->getBit());
+    vars["SKPOLY"]=DRW_Variant(70, buf->getBit());
+    vars["ANGDIR"]=DRW_Variant(70, buf->getBit());
+    vars["SPLFRAME"]=DRW_Variant(70, buf->getBit());
     if (version < DRW::AC1015) {//pre 2000
-        vars["ATTREQ"]=new DRW_Variant(70, buf->getBit());
-        vars["ATTDIA"]=new DRW_Variant(70, buf->getBit());
+        vars["ATTREQ"]=DRW_Variant(70, buf->getBit());
+        vars["ATTDIA"]=DRW_Variant(70, buf->getBit());
     }
-    vars["MIRRTEXT"]=new DRW_Variant(70, buf->getBit());
-    vars["WORLDVIEW"]=new DRW_Variant(70, buf->getBit());
+    vars["MIRRTEXT"]=DRW_Variant(70, buf->getBit());
+    vars["WORLDVIEW"]=DRW_Variant(70, buf->getBit());
     if (version < DRW::AC1015) {//pre 2000
-        vars["WIREFRAME"]=new DRW_Variant(70, buf->getBit());
+        vars["WIREFRAME"]=DRW_Variant(70, buf->getBit());
     }
-    vars["TILEMODE"]=new DRW_Variant(70, buf->getBit());
-    vars["PLIMCHECK"]=new DRW_Variant(70, buf->getBit());
-    vars["VISRETAIN"]=new DRW_Variant(70, buf->getBit());
+    vars["TILEMODE"]=DRW_Variant(70, buf->getBit());
+    vars["PLIMCHECK"]=DRW_Variant(70, buf->getBit());
+    vars["VISRETAIN"]=DRW_Variant(70, buf->getBit());
     if (version < DRW::AC1015) {//pre 2000
-        vars["DELOBJ"]=new DRW_Variant(70, buf->getBit());
+        vars["DELOBJ"]=DRW_Variant(70, buf->getBit());
     }
-    vars["DISPSILH"]=new DRW_Variant(70, buf->getBit());
-    vars["PELLIPSE"]=new DRW_Variant(70, buf->getBit());
-    vars["PROXIGRAPHICS"]=new DRW_Variant(70, buf->getBitShort());//RLZ short or bit??
+    vars["DISPSILH"]=DRW_Variant(70, buf->getBit());
+    vars["PELLIPSE"]=DRW_Variant(70, buf->getBit());
+    vars["PROXIGRAPHICS"]=DRW_Variant(70, buf->getBitShort());//RLZ short or bit??
     if (version < DRW::AC1015) {//pre 2000
-        vars["DRAGMODE"]=new DRW_Variant(70, buf->getBitShort());//RLZ short or bit??
+        vars["DRAGMODE"]=DRW_Variant(70, buf->getBitShort());//RLZ short or bit??
     }
-    vars["TREEDEPTH"]=new DRW_Variant(70, buf->getBitShort());//RLZ short or bit??
-    vars["LUNITS"]=new DRW_Variant(70, buf->getBitShort());
-    vars["LUPREC"]=new DRW_Variant(70, buf->getBitShort());
-    vars["AUNITS"]=new DRW_Variant(70, buf->getBitShort());
-    vars["AUPREC"]=new DRW_Variant(70, buf->getBitShort());
+    vars["TREEDEPTH"]=DRW_Variant(70, buf->getBitShort());//RLZ short or bit??
+    vars["LUNITS"]=DRW_Variant(70, buf->getBitShort());
+    vars["LUPREC"]=DRW_Variant(70, buf->getBitShort());
+    vars["AUNITS"]=DRW_Variant(70, buf->getBitShort());
+    vars["AUPREC"]=DRW_Variant(70, buf->getBitShort());
     if (version < DRW::AC1015) {//pre 2000
-        vars["OSMODE"]=new DRW_Variant(70, buf->getBitShort());
+        vars["OSMODE"]=DRW_Variant(70, buf->getBitShort());
     }
-    vars["ATTMODE"]=new DRW_Variant(70, buf->getBitShort());
+    vars["ATTMODE"]=DRW_Variant(70, buf->getBitShort());
     if (version < DRW::AC1015) {//pre 2000
-        vars["COORDS"]=new DRW_Variant(70, buf->getBitShort());
+        vars["COORDS"]=DRW_Variant(70, buf->getBitShort());
     }
-    vars["PDMODE"]=new DRW_Variant(70, buf->getBitShort());
+    vars["PDMODE"]=DRW_Variant(70, buf->getBitShort());
     if (version < DRW::AC1015) {//pre 2000
-        vars["PICKSTYLE"]=new DRW_Variant(70, buf->getBitShort());
+        vars["PICKSTYLE"]=DRW_Variant(70, buf->getBitShort());
     }
     if (version > DRW::AC1015) {//2004+
          DRW_DBG("\nUnknown long 1: "); DRW_DBG(buf->getBitLong());
          DRW_DBG("\nUnknown long 2: "); DRW_DBG(buf->getBitLong());
          DRW_DBG("\nUnknown long 3: "); DRW_DBG(buf->getBitLong());
     }
-    vars["USERI1"]=new DRW_Variant(70, buf->getBitShort());
-    vars["USERI2"]=new DRW_Variant(70, buf->getBitShort());
-    vars["USERI3"]=new DRW_Variant(70, buf->getBitShort());
-    vars["USERI4"]=new DRW_Variant(70, buf->getBitShort());
-    vars["USERI5"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SPLINESEGS"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SURFU"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SURFV"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SURFTYPE"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SURFTAB1"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SURFTAB2"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SPLINETYPE"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SHADEDGE"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SHADEDIF"]=new DRW_Variant(70, buf->getBitShort());
-    vars["UNITMODE"]=new DRW_Variant(70, buf->getBitShort());
-    vars["MAXACTVP"]=new DRW_Variant(70, buf->getBitShort());
-    vars["ISOLINES"]=new DRW_Variant(70, buf->getBitShort());//////////////////
-    vars["CMLJUST"]=new DRW_Variant(70, buf->getBitShort());
-    vars["TEXTQLTY"]=new DRW_Variant(70, buf->getBitShort());/////////////////////
-    vars["LTSCALE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["TEXTSIZE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["TRACEWID"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["SKETCHINC"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["FILLETRAD"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["THICKNESS"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["ANGBASE"]=new DRW_Variant(50, buf->getBitDouble());
-    vars["PDSIZE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["PLINEWID"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["USERR1"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["USERR2"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["USERR3"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["USERR4"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["USERR5"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["CHAMFERA"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["CHAMFERB"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["CHAMFERC"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["CHAMFERD"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["FACETRES"]=new DRW_Variant(40, buf->getBitDouble());/////////////////////////
-    vars["CMLSCALE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["CELTSCALE"]=new DRW_Variant(40, buf->getBitDouble());
+    vars["USERI1"]=DRW_Variant(70, buf->getBitShort());
+    vars["USERI2"]=DRW_Variant(70, buf->getBitShort());
+    vars["USERI3"]=DRW_Variant(70, buf->getBitShort());
+    vars["USERI4"]=DRW_Variant(70, buf->getBitShort());
+    vars["USERI5"]=DRW_Variant(70, buf->getBitShort());
+    vars["SPLINESEGS"]=DRW_Variant(70, buf->getBitShort());
+    vars["SURFU"]=DRW_Variant(70, buf->getBitShort());
+    vars["SURFV"]=DRW_Variant(70, buf->getBitShort());
+    vars["SURFTYPE"]=DRW_Variant(70, buf->getBitShort());
+    vars["SURFTAB1"]=DRW_Variant(70, buf->getBitShort());
+    vars["SURFTAB2"]=DRW_Variant(70, buf->getBitShort());
+    vars["SPLINETYPE"]=DRW_Variant(70, buf->getBitShort());
+    vars["SHADEDGE"]=DRW_Variant(70, buf->getBitShort());
+    vars["SHADEDIF"]=DRW_Variant(70, buf->getBitShort());
+    vars["UNITMODE"]=DRW_Variant(70, buf->getBitShort());
+    vars["MAXACTVP"]=DRW_Variant(70, buf->getBitShort());
+    vars["ISOLINES"]=DRW_Variant(70, buf->getBitShort());//////////////////
+    vars["CMLJUST"]=DRW_Variant(70, buf->getBitShort());
+    vars["TEXTQLTY"]=DRW_Variant(70, buf->getBitShort());/////////////////////
+    vars["LTSCALE"]=DRW_Variant(40, buf->getBitDouble());
+    vars["TEXTSIZE"]=DRW_Variant(40, buf->getBitDouble());
+    vars["TRACEWID"]=DRW_Variant(40, buf->getBitDouble());
+    vars["SKETCHINC"]=DRW_Variant(40, buf->getBitDouble());
+    vars["FILLETRAD"]=DRW_Variant(40, buf->getBitDouble());
+    vars["THICKNESS"]=DRW_Variant(40, buf->getBitDouble());
+    vars["ANGBASE"]=DRW_Variant(50, buf->getBitDouble());
+    vars["PDSIZE"]=DRW_Variant(40, buf->getBitDouble());
+    vars["PLINEWID"]=DRW_Variant(40, buf->getBitDouble());
+    vars["USERR1"]=DRW_Variant(40, buf->getBitDouble());
+    vars["USERR2"]=DRW_Variant(40, buf->getBitDouble());
+    vars["USERR3"]=DRW_Variant(40, buf->getBitDouble());
+    vars["USERR4"]=DRW_Variant(40, buf->getBitDouble());
+    vars["USERR5"]=DRW_Variant(40, buf->getBitDouble());
+    vars["CHAMFERA"]=DRW_Variant(40, buf->getBitDouble());
+    vars["CHAMFERB"]=DRW_Variant(40, buf->getBitDouble());
+    vars["CHAMFERC"]=DRW_Variant(40, buf->getBitDouble());
+    vars["CHAMFERD"]=DRW_Variant(40, buf->getBitDouble());
+    vars["FACETRES"]=DRW_Variant(40, buf->getBitDouble());/////////////////////////
+    vars["CMLSCALE"]=DRW_Variant(40, buf->getBitDouble());
+    vars["CELTSCALE"]=DRW_Variant(40, buf->getBitDouble());
     if (version < DRW::AC1021) {//2004-
-        vars["MENU"]=new DRW_Variant(1, buf->getCP8Text());
+        vars["MENU"]=DRW_Variant(1, buf->getCP8Text());
     }
     ddouble64 msec, day;
     day = buf->getBitLong();
     msec = buf->getBitLong();
     while (msec > 0)
         msec /=10;
-    vars["TDCREATE"]=new DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
-//    vars["TDCREATE"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
-//    vars["TDCREATE"]=new DRW_Variant(40, buf->getBitLong());
+    vars["TDCREATE"]=DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
+//    vars["TDCREATE"]=DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
+//    vars["TDCREATE"]=DRW_Variant(40, buf->getBitLong());
     day = buf->getBitLong();
     msec = buf->getBitLong();
     while (msec > 0)
         msec /=10;
-    vars["TDUPDATE"]=new DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
-//    vars["TDUPDATE"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
-//    vars["TDUPDATE"]=new DRW_Variant(40, buf->getBitLong());
+    vars["TDUPDATE"]=DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
+//    vars["TDUPDATE"]=DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
+//    vars["TDUPDATE"]=DRW_Variant(40, buf->getBitLong());
     if (version > DRW::AC1015) {//2004+
          DRW_DBG("\nUnknown long 4: "); DRW_DBG(buf->getBitLong());
          DRW_DBG("\nUnknown long 5: "); DRW_DBG(buf->getBitLong());
@@ -1931,17 +1956,17 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
     msec = buf->getBitLong();
     while (msec > 0)
         msec /=10;
-    vars["TDINDWG"]=new DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
-//    vars["TDINDWG"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
-//    vars["TDINDWG"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
+    vars["TDINDWG"]=DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
+//    vars["TDINDWG"]=DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
+//    vars["TDINDWG"]=DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
     day = buf->getBitLong();
     msec = buf->getBitLong();
     while (msec > 0)
         msec /=10;
-    vars["TDUSRTIMER"]=new DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
-//    vars["TDUSRTIMER"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
-//    vars["TDUSRTIMER"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
-    vars["CECOLOR"]=new DRW_Variant(62, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
+    vars["TDUSRTIMER"]=DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
+//    vars["TDUSRTIMER"]=DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
+//    vars["TDUSRTIMER"]=DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
+    vars["CECOLOR"]=DRW_Variant(62, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
     dwgHandle HANDSEED = buf->getHandle();//allways present in data stream
     DRW_DBG("\nHANDSEED: "); DRW_DBGHL(HANDSEED.code, HANDSEED.size, HANDSEED.ref);
     dwgHandle CLAYER = hBbuf->getHandle();
@@ -1959,177 +1984,177 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
     dwgHandle CMLSTYLE = hBbuf->getHandle();
     DRW_DBG("\nCMLSTYLE: "); DRW_DBGHL(CMLSTYLE.code, CMLSTYLE.size, CMLSTYLE.ref);
     if (version > DRW::AC1014) {//2000+
-        vars["PSVPSCALE"]=new DRW_Variant(40, buf->getBitDouble());
-    }
-    vars["PINSBASE"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["PEXTMIN"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["PEXTMAX"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["PLIMMIN"]=new DRW_Variant(10, buf->get2RawDouble());
-    vars["PLIMMAX"]=new DRW_Variant(10, buf->get2RawDouble());
-    vars["PELEVATION"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["PUCSORG"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["PUCSXDIR"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["PUCSYDIR"]=new DRW_Variant(10, buf->get3BitDouble());
+        vars["PSVPSCALE"]=DRW_Variant(40, buf->getBitDouble());
+    }
+    vars["PINSBASE"]=DRW_Variant(10, buf->get3BitDouble());
+    vars["PEXTMIN"]=DRW_Variant(10, buf->get3BitDouble());
+    vars["PEXTMAX"]=DRW_Variant(10, buf->get3BitDouble());
+    vars["PLIMMIN"]=DRW_Variant(10, buf->get2RawDouble());
+    vars["PLIMMAX"]=DRW_Variant(10, buf->get2RawDouble());
+    vars["PELEVATION"]=DRW_Variant(40, buf->getBitDouble());
+    vars["PUCSORG"]=DRW_Variant(10, buf->get3BitDouble());
+    vars["PUCSXDIR"]=DRW_Variant(10, buf->get3BitDouble());
+    vars["PUCSYDIR"]=DRW_Variant(10, buf->get3BitDouble());
     dwgHandle PUCSNAME = hBbuf->getHandle();
     DRW_DBG("\nPUCSNAME: "); DRW_DBGHL(PUCSNAME.code, PUCSNAME.size, PUCSNAME.ref);
     if (version > DRW::AC1014) {//2000+
         dwgHandle PUCSORTHOREF = hBbuf->getHandle();
         DRW_DBG("\nPUCSORTHOREF: "); DRW_DBGHL(PUCSORTHOREF.code, PUCSORTHOREF.size, PUCSORTHOREF.ref);
-        vars["PUCSORTHOVIEW"]=new DRW_Variant(70, buf->getBitShort());
+        vars["PUCSORTHOVIEW"]=DRW_Variant(70, buf->getBitShort());
         dwgHandle PUCSBASE = hBbuf->getHandle();
         DRW_DBG("\nPUCSBASE: "); DRW_DBGHL(PUCSBASE.code, PUCSBASE.size, PUCSBASE.ref);
-        vars["PUCSORGTOP"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["PUCSORGBOTTOM"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["PUCSORGLEFT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["PUCSORGRIGHT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["PUCSORGFRONT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["PUCSORGBACK"]=new DRW_Variant(10, buf->get3BitDouble());
-    }
-    vars["INSBASE"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["EXTMIN"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["EXTMAX"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["LIMMIN"]=new DRW_Variant(10, buf->get2RawDouble());
-    vars["LIMMAX"]=new DRW_Variant(10, buf->get2RawDouble());
-    vars["ELEVATION"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["UCSORG"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["UCSXDIR"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["UCSYDIR"]=new DRW_Variant(10, buf->get3BitDouble());
+        vars["PUCSORGTOP"]=DRW_Variant(10, buf->get3BitDouble());
+        vars["PUCSORGBOTTOM"]=DRW_Variant(10, buf->get3BitDouble());
+        vars["PUCSORGLEFT"]=DRW_Variant(10, buf->get3BitDouble());
+        vars["PUCSORGRIGHT"]=DRW_Variant(10, buf->get3BitDouble());
+        vars["PUCSORGFRONT"]=DRW_Variant(10, buf->get3BitDouble());
+        vars["PUCSORGBACK"]=DRW_Variant(10, buf->get3BitDouble());
+    }
+    vars["INSBASE"]=DRW_Variant(10, buf->get3BitDouble());
+    vars["EXTMIN"]=DRW_Variant(10, buf->get3BitDouble());
+    vars["EXTMAX"]=DRW_Variant(10, buf->get3BitDouble());
+    vars["LIMMIN"]=DRW_Variant(10, buf->get2RawDouble());
+    vars["LIMMAX"]=DRW_Variant(10, buf->get2RawDouble());
+    vars["ELEVATION"]=DRW_Variant(40, buf->getBitDouble());
+    vars["UCSORG"]=DRW_Variant(10, buf->get3BitDouble());
+    vars["UCSXDIR"]=DRW_Variant(10, buf->get3BitDouble());
+    vars["UCSYDIR"]=DRW_Variant(10, buf->get3BitDouble());
     dwgHandle UCSNAME = hBbuf->getHandle();
     DRW_DBG("\nUCSNAME: "); DRW_DBGHL(UCSNAME.code, UCSNAME.size, UCSNAME.ref);
     if (version > DRW::AC1014) {//2000+
         dwgHandle UCSORTHOREF = hBbuf->getHandle();
         DRW_DBG("\nUCSORTHOREF: "); DRW_DBGHL(UCSORTHOREF.code, UCSORTHOREF.size, UCSORTHOREF.ref);
-        vars["UCSORTHOVIEW"]=new DRW_Variant(70, buf->getBitShort());
+        vars["UCSORTHOVIEW"]=DRW_Variant(70, buf->getBitShort());
         dwgHandle UCSBASE = hBbuf->getHandle();
         DRW_DBG("\nUCSBASE: "); DRW_DBGHL(UCSBASE.code, UCSBASE.size, UCSBASE.ref);
-        vars["UCSORGTOP"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["UCSORGBOTTOM"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["UCSORGLEFT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["UCSORGRIGHT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["UCSORGFRONT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["UCSORGBACK"]=new DRW_Variant(10, buf->get3BitDouble());
+        vars["UCSORGTOP"]=DRW_Variant(10, buf->get3BitDouble());
+        vars["UCSORGBOTTOM"]=DRW_Variant(10, buf->get3BitDouble());
+        vars["UCSORGLEFT"]=DRW_Variant(10, buf->get3BitDouble());
+        vars["UCSORGRIGHT"]=DRW_Variant(10, buf->get3BitDouble());
+        vars["UCSORGFRONT"]=DRW_Variant(10, buf->get3BitDouble());
+        vars["UCSORGBACK"]=DRW_Variant(10, buf->get3BitDouble());
         if (version < DRW::AC1021) {//2004-
-            vars["DIMPOST"]=new DRW_Variant(1, buf->getCP8Text());
-            vars["DIMAPOST"]=new DRW_Variant(1, buf->getCP8Text());
+            vars["DIMPOST"]=DRW_Variant(1, buf->getCP8Text());
+            vars["DIMAPOST"]=DRW_Variant(1, buf->getCP8Text());
         }
     }
     if (version < DRW::AC1015) {//r14-
-        vars["DIMTOL"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMLIM"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTIH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTOH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSE1"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSE2"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMALT"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTOFL"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSAH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTIX"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSOXD"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMALTD"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMZIN"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMSD1"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSD2"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTOLJ"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMJUST"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMFIT"]=new DRW_Variant(70, buf->getRawChar8());///////////
-        vars["DIMUPT"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTZIN"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMALTZ"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMALTTZ"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMTAD"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMUNIT"]=new DRW_Variant(70, buf->getBitShort());///////////
-        vars["DIMAUNIT"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMDEC"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTDEC"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTU"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTTD"]=new DRW_Variant(70, buf->getBitShort());
+        vars["DIMTOL"]=DRW_Variant(70, buf->getBit());
+        vars["DIMLIM"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTIH"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTOH"]=DRW_Variant(70, buf->getBit());
+        vars["DIMSE1"]=DRW_Variant(70, buf->getBit());
+        vars["DIMSE2"]=DRW_Variant(70, buf->getBit());
+        vars["DIMALT"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTOFL"]=DRW_Variant(70, buf->getBit());
+        vars["DIMSAH"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTIX"]=DRW_Variant(70, buf->getBit());
+        vars["DIMSOXD"]=DRW_Variant(70, buf->getBit());
+        vars["DIMALTD"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DIMZIN"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DIMSD1"]=DRW_Variant(70, buf->getBit());
+        vars["DIMSD2"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTOLJ"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DIMJUST"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DIMFIT"]=DRW_Variant(70, buf->getRawChar8());///////////
+        vars["DIMUPT"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTZIN"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DIMALTZ"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DIMALTTZ"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DIMTAD"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DIMUNIT"]=DRW_Variant(70, buf->getBitShort());///////////
+        vars["DIMAUNIT"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMDEC"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMTDEC"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMALTU"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMALTTD"]=DRW_Variant(70, buf->getBitShort());
         dwgHandle DIMTXSTY = hBbuf->getHandle();
         DRW_DBG("\nDIMTXSTY: "); DRW_DBGHL(DIMTXSTY.code, DIMTXSTY.size, DIMTXSTY.ref);
     }
-    vars["DIMSCALE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMASZ"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMEXO"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMDLI"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMEXE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMRND"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMDLE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMTP"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMTM"]=new DRW_Variant(40, buf->getBitDouble());
+    vars["DIMSCALE"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMASZ"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMEXO"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMDLI"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMEXE"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMRND"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMDLE"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMTP"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMTM"]=DRW_Variant(40, buf->getBitDouble());
     if (version > DRW::AC1018) {//2007+
-        vars["DIMFXL"]=new DRW_Variant(40, buf->getBitDouble());//////////////////
-        vars["DIMJOGANG"]=new DRW_Variant(40, buf->getBitDouble());///////////////
-        vars["DIMTFILL"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTFILLCLR"]=new DRW_Variant(62, buf->getCmColor(version));
+        vars["DIMFXL"]=DRW_Variant(40, buf->getBitDouble());//////////////////
+        vars["DIMJOGANG"]=DRW_Variant(40, buf->getBitDouble());///////////////
+        vars["DIMTFILL"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMTFILLCLR"]=DRW_Variant(62, buf->getCmColor(version));
     }
     if (version > DRW::AC1014) {//2000+
-        vars["DIMTOL"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMLIM"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTIH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTOH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSE1"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSE2"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTAD"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMZIN"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMAZIN"]=new DRW_Variant(70, buf->getBitShort());
+        vars["DIMTOL"]=DRW_Variant(70, buf->getBit());
+        vars["DIMLIM"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTIH"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTOH"]=DRW_Variant(70, buf->getBit());
+        vars["DIMSE1"]=DRW_Variant(70, buf->getBit());
+        vars["DIMSE2"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTAD"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMZIN"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMAZIN"]=DRW_Variant(70, buf->getBitShort());
     }
     if (version > DRW::AC1018) {//2007+
-        vars["DIMARCSYM"]=new DRW_Variant(70, buf->getBitShort());
-    }
-    vars["DIMTXT"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMCEN"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMTSZ"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMALTF"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMLFAC"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMTVP"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMTFAC"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMGAP"]=new DRW_Variant(40, buf->getBitDouble());
+        vars["DIMARCSYM"]=DRW_Variant(70, buf->getBitShort());
+    }
+    vars["DIMTXT"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMCEN"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMTSZ"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMALTF"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMLFAC"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMTVP"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMTFAC"]=DRW_Variant(40, buf->getBitDouble());
+    vars["DIMGAP"]=DRW_Variant(40, buf->getBitDouble());
     if (version < DRW::AC1015) {//r14-
-        vars["DIMPOST"]=new DRW_Variant(1, buf->getCP8Text());
-        vars["DIMAPOST"]=new DRW_Variant(1, buf->getCP8Text());
-        vars["DIMBLK"]=new DRW_Variant(1, buf->getCP8Text());
-        vars["DIMBLK1"]=new DRW_Variant(1, buf->getCP8Text());
-        vars["DIMBLK2"]=new DRW_Variant(1, buf->getCP8Text());
+        vars["DIMPOST"]=DRW_Variant(1, buf->getCP8Text());
+        vars["DIMAPOST"]=DRW_Variant(1, buf->getCP8Text());
+        vars["DIMBLK"]=DRW_Variant(1, buf->getCP8Text());
+        vars["DIMBLK1"]=DRW_Variant(1, buf->getCP8Text());
+        vars["DIMBLK2"]=DRW_Variant(1, buf->getCP8Text());
     }
     if (version > DRW::AC1014) {//2000+
-        vars["DIMALTRND"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["DIMALT"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMALTD"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTOFL"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSAH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTIX"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSOXD"]=new DRW_Variant(70, buf->getBit());
-    }
-    vars["DIMCLRD"]=new DRW_Variant(70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
-    vars["DIMCLRE"]=new DRW_Variant(70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
-    vars["DIMCLRT"]=new DRW_Variant(70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
+        vars["DIMALTRND"]=DRW_Variant(40, buf->getBitDouble());
+        vars["DIMALT"]=DRW_Variant(70, buf->getBit());
+        vars["DIMALTD"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMTOFL"]=DRW_Variant(70, buf->getBit());
+        vars["DIMSAH"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTIX"]=DRW_Variant(70, buf->getBit());
+        vars["DIMSOXD"]=DRW_Variant(70, buf->getBit());
+    }
+    vars["DIMCLRD"]=DRW_Variant(70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
+    vars["DIMCLRE"]=DRW_Variant(70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
+    vars["DIMCLRT"]=DRW_Variant(70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
     if (version > DRW::AC1014) {//2000+
-        vars["DIAMDEC"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMDEC"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTDEC"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTU"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTTD"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMAUNIT"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMFAC"]=new DRW_Variant(70, buf->getBitShort());///////////////// DIMFAC O DIMFRAC
-        vars["DIMLUNIT"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMDSEP"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTMOVE"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMJUST"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMSD1"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSD2"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTOLJ"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTZIN"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTZ"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTTZ"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMUPT"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMATFIT"]=new DRW_Variant(70, buf->getBitShort());
+        vars["DIAMDEC"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMDEC"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMTDEC"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMALTU"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMALTTD"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMAUNIT"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMFAC"]=DRW_Variant(70, buf->getBitShort());///////////////// DIMFAC O DIMFRAC
+        vars["DIMLUNIT"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMDSEP"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMTMOVE"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMJUST"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMSD1"]=DRW_Variant(70, buf->getBit());
+        vars["DIMSD2"]=DRW_Variant(70, buf->getBit());
+        vars["DIMTOLJ"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMTZIN"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMALTZ"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMALTTZ"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMUPT"]=DRW_Variant(70, buf->getBit());
+        vars["DIMATFIT"]=DRW_Variant(70, buf->getBitShort());
     }
     if (version > DRW::AC1018) {//2007+
-        vars["DIMFXLON"]=new DRW_Variant(70, buf->getBit());////////////////
+        vars["DIMFXLON"]=DRW_Variant(70, buf->getBit());////////////////
     }
     if (version > DRW::AC1021) {//2010+
-        vars["DIMTXTDIRECTION"]=new DRW_Variant(70, buf->getBit());////////////////
-        vars["DIMALTMZF"]=new DRW_Variant(40, buf->getBitDouble());////////////////
-        vars["DIMMZF"]=new DRW_Variant(40, buf->getBitDouble());////////////////
+        vars["DIMTXTDIRECTION"]=DRW_Variant(70, buf->getBit());////////////////
+        vars["DIMALTMZF"]=DRW_Variant(40, buf->getBitDouble());////////////////
+        vars["DIMMZF"]=DRW_Variant(40, buf->getBitDouble());////////////////
     }
     if (version > DRW::AC1014) {//2000+
         dwgHandle DIMTXSTY = hBbuf->getHandle();
@@ -2152,8 +2177,8 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         DRW_DBG("\nDIMLTEX2: "); DRW_DBGHL(DIMLTEX2.code, DIMLTEX2.size, DIMLTEX2.ref);
     }
     if (version > DRW::AC1014) {//2000+
-        vars["DIMLWD"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMLWE"]=new DRW_Variant(70, buf->getBitShort());
+        vars["DIMLWD"]=DRW_Variant(70, buf->getBitShort());
+        vars["DIMLWE"]=DRW_Variant(70, buf->getBitShort());
     }
     dwgHandle CONTROL = hBbuf->getHandle();
     DRW_DBG("\nBLOCK CONTROL: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
@@ -2195,11 +2220,11 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
     DRW_DBG("\nDICT NAMED OBJS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
 
     if (version > DRW::AC1014) {//2000+
-        vars["TSTACKALIGN"]=new DRW_Variant(70, buf->getBitShort());
-        vars["TSTACKSIZE"]=new DRW_Variant(70, buf->getBitShort());
+        vars["TSTACKALIGN"]=DRW_Variant(70, buf->getBitShort());
+        vars["TSTACKSIZE"]=DRW_Variant(70, buf->getBitShort());
         if (version < DRW::AC1021) {//2004-
-            vars["HYPERLINKBASE"]=new DRW_Variant(1, buf->getCP8Text());
-            vars["STYLESHEET"]=new DRW_Variant(1, buf->getCP8Text());
+            vars["HYPERLINKBASE"]=DRW_Variant(1, buf->getCP8Text());
+            vars["STYLESHEET"]=DRW_Variant(1, buf->getCP8Text());
         }
         CONTROL = hBbuf->getHandle();
         DRW_DBG("\nDICT LAYOUTS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
@@ -2224,31 +2249,31 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
     }
     if (version > DRW::AC1014) {//2000+
         DRW_DBG("\nFlags: "); DRW_DBGH(buf->getBitLong());//RLZ TODO change to 8 vars
-        vars["INSUNITS"]=new DRW_Variant(70, buf->getBitShort());
+        vars["INSUNITS"]=DRW_Variant(70, buf->getBitShort());
         duint16 cepsntype = buf->getBitShort();
-        vars["CEPSNTYPE"]=new DRW_Variant(70, cepsntype);
+        vars["CEPSNTYPE"]=DRW_Variant(70, cepsntype);
         if (cepsntype == 3){
             CONTROL = hBbuf->getHandle();
             DRW_DBG("\nCPSNID HANDLE: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
         }
         if (version < DRW::AC1021) {//2004-
-            vars["FINGERPRINTGUID"]=new DRW_Variant(1, buf->getCP8Text());
-            vars["VERSIONGUID"]=new DRW_Variant(1, buf->getCP8Text());
+            vars["FINGERPRINTGUID"]=DRW_Variant(1, buf->getCP8Text());
+            vars["VERSIONGUID"]=DRW_Variant(1, buf->getCP8Text());
         }
     }
     if (version > DRW::AC1015) {//2004+
-        vars["SORTENTS"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["INDEXCTL"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["HIDETEXT"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["XCLIPFRAME"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMASSOC"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["HALOGAP"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["OBSCUREDCOLOR"]=new DRW_Variant(70, buf->getBitShort());
-        vars["INTERSECTIONCOLOR"]=new DRW_Variant(70, buf->getBitShort());
-        vars["OBSCUREDLTYPE"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["INTERSECTIONDISPLAY"]=new DRW_Variant(70, buf->getRawChar8());
+        vars["SORTENTS"]=DRW_Variant(70, buf->getRawChar8());
+        vars["INDEXCTL"]=DRW_Variant(70, buf->getRawChar8());
+        vars["HIDETEXT"]=DRW_Variant(70, buf->getRawChar8());
+        vars["XCLIPFRAME"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DIMASSOC"]=DRW_Variant(70, buf->getRawChar8());
+        vars["HALOGAP"]=DRW_Variant(70, buf->getRawChar8());
+        vars["OBSCUREDCOLOR"]=DRW_Variant(70, buf->getBitShort());
+        vars["INTERSECTIONCOLOR"]=DRW_Variant(70, buf->getBitShort());
+        vars["OBSCUREDLTYPE"]=DRW_Variant(70, buf->getRawChar8());
+        vars["INTERSECTIONDISPLAY"]=DRW_Variant(70, buf->getRawChar8());
         if (version < DRW::AC1021) {//2004-
-            vars["PROJECTNAME"]=new DRW_Variant(1, buf->getCP8Text());
+            vars["PROJECTNAME"]=DRW_Variant(1, buf->getCP8Text());
         }
     }
     CONTROL = hBbuf->getHandle();
@@ -2262,42 +2287,42 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
     CONTROL = hBbuf->getHandle();
     DRW_DBG("\nLTYPE CONTINUOUS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
     if (version > DRW::AC1018) {//2007+
-        vars["CAMERADISPLAY"]=new DRW_Variant(70, buf->getBit());
+        vars["CAMERADISPLAY"]=DRW_Variant(70, buf->getBit());
         DRW_DBG("\nUnknown 2007+ long1: "); DRW_DBG(buf->getBitLong());
         DRW_DBG("\nUnknown 2007+ long2: "); DRW_DBG(buf->getBitLong());
         DRW_DBG("\nUnknown 2007+ double2: "); DRW_DBG(buf->getBitDouble());
-        vars["STEPSPERSEC"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["STEPSIZE"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["3DDWFPREC"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LENSLENGTH"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["CAMERAHEIGHT"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["SOLIDHIST"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["SHOWHIST"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["PSOLWIDTH"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["PSOLHEIGHT"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LOFTANG1"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LOFTANG2"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LOFTMAG1"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LOFTMAG2"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LOFTPARAM"]=new DRW_Variant(70, buf->getBitShort());
-        vars["LOFTNORMALS"]=new DRW_Variant(40, buf->getRawChar8());
-        vars["LATITUDE"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LONGITUDE"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["NORTHDIRECTION"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["TIMEZONE"]=new DRW_Variant(70, buf->getBitLong());
-        vars["LIGHTGLYPHDISPLAY"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["TILEMODELIGHTSYNCH"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DWFFRAME"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DGNFRAME"]=new DRW_Variant(70, buf->getRawChar8());
+        vars["STEPSPERSEC"]=DRW_Variant(40, buf->getBitDouble());
+        vars["STEPSIZE"]=DRW_Variant(40, buf->getBitDouble());
+        vars["3DDWFPREC"]=DRW_Variant(40, buf->getBitDouble());
+        vars["LENSLENGTH"]=DRW_Variant(40, buf->getBitDouble());
+        vars["CAMERAHEIGHT"]=DRW_Variant(40, buf->getBitDouble());
+        vars["SOLIDHIST"]=DRW_Variant(70, buf->getRawChar8());
+        vars["SHOWHIST"]=DRW_Variant(70, buf->getRawChar8());
+        vars["PSOLWIDTH"]=DRW_Variant(40, buf->getBitDouble());
+        vars["PSOLHEIGHT"]=DRW_Variant(40, buf->getBitDouble());
+        vars["LOFTANG1"]=DRW_Variant(40, buf->getBitDouble());
+        vars["LOFTANG2"]=DRW_Variant(40, buf->getBitDouble());
+        vars["LOFTMAG1"]=DRW_Variant(40, buf->getBitDouble());
+        vars["LOFTMAG2"]=DRW_Variant(40, buf->getBitDouble());
+        vars["LOFTPARAM"]=DRW_Variant(70, buf->getBitShort());
+        vars["LOFTNORMALS"]=DRW_Variant(40, buf->getRawChar8());
+        vars["LATITUDE"]=DRW_Variant(40, buf->getBitDouble());
+        vars["LONGITUDE"]=DRW_Variant(40, buf->getBitDouble());
+        vars["NORTHDIRECTION"]=DRW_Variant(40, buf->getBitDouble());
+        vars["TIMEZONE"]=DRW_Variant(70, buf->getBitLong());
+        vars["LIGHTGLYPHDISPLAY"]=DRW_Variant(70, buf->getRawChar8());
+        vars["TILEMODELIGHTSYNCH"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DWFFRAME"]=DRW_Variant(70, buf->getRawChar8());
+        vars["DGNFRAME"]=DRW_Variant(70, buf->getRawChar8());
         DRW_DBG("\nUnknown 2007+ BIT: "); DRW_DBG(buf->getBit());
-        vars["INTERFERECOLOR"]=new DRW_Variant(70, buf->getCmColor(version));
+        vars["INTERFERECOLOR"]=DRW_Variant(70, buf->getCmColor(version));
         CONTROL = hBbuf->getHandle();
         DRW_DBG("\nINTERFEREOBJVS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
         CONTROL = hBbuf->getHandle();
         DRW_DBG("\nINTERFEREVPVS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
         CONTROL = hBbuf->getHandle();
         DRW_DBG("\nDRAGVS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
-        vars["CSHADOW"]=new DRW_Variant(70, buf->getRawChar8());
+        vars["CSHADOW"]=DRW_Variant(70, buf->getRawChar8());
         DRW_DBG("\nUnknown 2007+ double2: "); DRW_DBG(buf->getBitDouble());
     }
     if (version > DRW::AC1012) {//R14+
@@ -2341,49 +2366,49 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         DRW_DBG("\nUnknown text2: "); DRW_DBG(buf->getUCSText(false));
         DRW_DBG("\nUnknown text3: "); DRW_DBG(buf->getUCSText(false));
         DRW_DBG("\nUnknown text4: "); DRW_DBG(buf->getUCSText(false));
-        vars["MENU"]=new DRW_Variant(1, buf->getUCSText(false));
-        vars["DIMPOST"]=new DRW_Variant(1, buf->getUCSText(false));
-        vars["DIMAPOST"]=new DRW_Variant(1, buf->getUCSText(false));
+        vars["MENU"]=DRW_Variant(1, buf->getUCSText(false));
+        vars["DIMPOST"]=DRW_Variant(1, buf->getUCSText(false));
+        vars["DIMAPOST"]=DRW_Variant(1, buf->getUCSText(false));
         if (version > DRW::AC1021) {//2010+
-            vars["DIMALTMZS"]=new DRW_Variant(70, buf->getUCSText(false));//RLZ: pending to verify//////////////
-            vars["DIMMZS"]=new DRW_Variant(70, buf->getUCSText(false));//RLZ: pending to verify//////////////
+            vars["DIMALTMZS"]=DRW_Variant(70, buf->getUCSText(false));//RLZ: pending to verify//////////////
+            vars["DIMMZS"]=DRW_Variant(70, buf->getUCSText(false));//RLZ: pending to verify//////////////
         }
-        vars["HYPERLINKBASE"]=new DRW_Variant(1, buf->getUCSText(false));
-        vars["STYLESHEET"]=new DRW_Variant(1, buf->getUCSText(false));
-        vars["FINGERPRINTGUID"]=new DRW_Variant(1, buf->getUCSText(false));
+        vars["HYPERLINKBASE"]=DRW_Variant(1, buf->getUCSText(false));
+        vars["STYLESHEET"]=DRW_Variant(1, buf->getUCSText(false));
+        vars["FINGERPRINTGUID"]=DRW_Variant(1, buf->getUCSText(false));
         DRW_DBG("\nstring buf position: "); DRW_DBG(buf->getPosition());
         DRW_DBG("  string buf bit position: "); DRW_DBG(buf->getBitPos());
-        vars["VERSIONGUID"]=new DRW_Variant(1, buf->getUCSText(false));
+        vars["VERSIONGUID"]=DRW_Variant(1, buf->getUCSText(false));
         DRW_DBG("\nstring buf position: "); DRW_DBG(buf->getPosition());
         DRW_DBG("  string buf bit position: "); DRW_DBG(buf->getBitPos());
-        vars["PROJECTNAME"]=new DRW_Variant(1, buf->getUCSText(false));
+        vars["PROJECTNAME"]=DRW_Variant(1, buf->getUCSText(false));
     }
 /***    ****/
     DRW_DBG("\nstring buf position: "); DRW_DBG(buf->getPosition());
     DRW_DBG("  string buf bit position: "); DRW_DBG(buf->getBitPos());
 
     if (DRW_DBGGL == DRW_dbg::DEBUG){
-        for (std::map<std::string,DRW_Variant*>::iterator it=vars.begin(); it!=vars.end(); ++it){
+        for (DRW_HeaderVars::const_iterator it=vars.begin(); it!=vars.end(); ++it){
             DRW_DBG("\n"); DRW_DBG(it->first); DRW_DBG(": ");
-            switch (it->second->type()){
+            switch (it->second.type()){
             case DRW_Variant::INTEGER:
-                DRW_DBG(it->second->content.i);
+                DRW_DBG(it->second.content.i);
                 break;
             case DRW_Variant::DOUBLE:
-                DRW_DBG(it->second->content.d);
+                DRW_DBG(it->second.content.d);
                 break;
             case DRW_Variant::STRING:
-                DRW_DBG(it->second->content.s->c_str());
+                DRW_DBG(it->second.content.s->c_str());
                 break;
             case DRW_Variant::COORD:
-                 DRW_DBG("x= "); DRW_DBG(it->second->content.v->x);
-                 DRW_DBG(", y= "); DRW_DBG(it->second->content.v->y);
-                 DRW_DBG(", z= "); DRW_DBG(it->second->content.v->z);
+                 DRW_DBG("x= "); DRW_DBG(it->second.content.v->x);
+                 DRW_DBG(", y= "); DRW_DBG(it->second.content.v->y);
+                 DRW_DBG(", z= "); DRW_DBG(it->second.content.v->z);
                 break;
             default:
                 break;
             }
-             DRW_DBG(" code: ");DRW_DBG(it->second->code());
+             DRW_DBG(" code: ");DRW_DBG(it->second.code());
         }
     }
 
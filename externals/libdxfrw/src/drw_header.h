@@ -14,7 +14,8 @@
 #define DRW_HEADER_H
 
 
-#include <map>
+#include <string>
+#include <vector>
 #include "drw_base.h"
 
 class dxfReader;
@@ -24,41 +25,74 @@ class dwgBuffer;
 #define SETHDRFRIENDS  friend class dxfRW; \
                        friend class dwgReader;
 
+//! Flat store of header variables
+/*!
+*  Header variables are kept inline in a vector sorted by name, lookup is
+*  a binary search. Files list the variables (mostly) sorted, so inserting
+*  while parsing usually appends at the end.
+*/
+class DRW_HeaderVars {
+public:
+    typedef std::pair<std::string, DRW_Variant> value_type;
+    typedef std::vector<value_type>::iterator iterator;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    iterator begin() {return entries.begin();}
+    iterator end() {return entries.end();}
+    const_iterator begin() const {return entries.begin();}
+    const_iterator end() const {return entries.end();}
+    size_t size() const {return entries.size();}
+    bool empty() const {return entries.empty();}
+    void clear() {entries.clear();}
+
+    iterator find(const std::string &key);
+    const_iterator find(const std::string &key) const;
+    /*! returns the variable 'key' or NULL if it was not read */
+    const DRW_Variant *get(const std::string &key) const;
+    /*! returns the variable 'key', inserts an empty one if missing */
+    DRW_Variant &operator[](const std::string &key);
+    void erase(iterator it) {entries.erase(it);}
+
+private:
+    std::vector<value_type> entries;
+};
+
 //! Class to handle header entries
 /*!
-*  Class to handle header vars, to read iterate over "std::map vars"
-*  to write add a DRW_Variant* into "std::map vars" (do not delete it, are cleared in dtor)
+*  Class to handle header vars, to read iterate over "vars" or look up a
+*  variable with vars.get(), to write assign a DRW_Variant to "vars[key]"
 *  or use add* helper functions.
+*  Before reading, setFilter() limits the stored variables to the given names,
+*  all others are skipped without converting their values.
 *  @author Rallaz
 */
 class DRW_Header {
     SETHDRFRIENDS
 public:
     DRW_Header();
-    ~DRW_Header() {
-        clearVars();
-    }
+    ~DRW_Header() {}
 
     DRW_Header(const DRW_Header& h){
         this->version = h.version;
         this->comments = h.comments;
-        for (std::map<std::string,DRW_Variant*>::const_iterator it=h.vars.begin(); it!=h.vars.end(); ++it){
-            this->vars[it->first] = new DRW_Variant( *(it->second) );
-        }
+        this->vars = h.vars;
+        this->filter = h.filter;
         this->curr = NULL;
     }
     DRW_Header& operator=(const DRW_Header &h) {
        if(this != &h) {
-           clearVars();
            this->version = h.version;
            this->comments = h.comments;
-           for (std::map<std::string,DRW_Variant*>::const_iterator it=h.vars.begin(); it!=h.vars.end(); ++it){
-               this->vars[it->first] = new DRW_Variant( *(it->second) );
-           }
+           this->vars = h.vars;
+           this->filter = h.filter;
+           this->curr = NULL;
        }
        return *this;
     }
 
+    /*! Only store the variables 'names' (e.g. "$INSUNITS") when reading dxf, an empty list stores all.
+     * $ACADVER and $DWGCODEPAGE are always read, the reader needs them. */
+    void setFilter(const std::vector<std::string> &names);
     void addDouble(std::string key, double value, int code);
     void addInt(std::string key, int value, int code);
     void addStr(std::string key, std::string value, int code);
@@ -71,22 +105,18 @@ protected:
     void parseCode(int code, dxfReader *reader);
     bool parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf, duint8 mv=0);
 private:
-    bool getDouble(std::string key, double *varDouble);
-    bool getInt(std::string key, int *varInt);
-    bool getStr(std::string key, std::string *varStr);
-    bool getCoord(std::string key, DRW_Coord *varStr);
-    void clearVars(){
-        for (std::map<std::string,DRW_Variant*>::iterator it=vars.begin(); it!=vars.end(); ++it)
-            delete it->second;
-
-        vars.clear();
-    }
+    bool getDouble(std::string key, double *varDouble) const;
+    bool getInt(std::string key, int *varInt) const;
+    bool getStr(std::string key, std::string *varStr) const;
+    bool getCoord(std::string key, DRW_Coord *varStr) const;
+    bool isFiltered(const std::string &key) const;
 
 public:
-    std::map<std::string,DRW_Variant*> vars;
+    DRW_HeaderVars vars;
 private:
     std::string comments;
     std::string name;
+    std::vector<std::string> filter; /*!< sorted names of variables to read, empty to read all */
     DRW_Variant* curr;
     int version; //to use on read
 
@@ -0,0 +1,62 @@
+/******************************************************************************
+**  libDXFrw - Library to read/write DXF files (ascii & binary)              **
+**                                                                           **
+**  Copyright (C) 2011-2015 José F. Soriano, rallazz@gmail.com               **
+**                                                                           **
+**  This library is free software, licensed under the terms of the GNU       **
+**  General Public License as published by the Free Software Foundation,     **
+**  either version 2 of the License, or (at your option) any later version.  **
+**  You should have received a copy of the GNU General Public License        **
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
+******************************************************************************/
+
+#include "drw_arena.h"
+
+namespace {
+thread_local DRW_Arena *currentArena = NULL;
+}
+
+DRW_Arena::DRW_Arena(size_t blockSize): blockIdx(0), offset(0), blockSize(blockSize) {
+}
+
+DRW_Arena::~DRW_Arena() {
+    for (std::vector<Block>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+        ::operator delete(it->data);
+}
+
+void *DRW_Arena::allocate(size_t size, size_t align) {
+    if (!blocks.empty()) {
+        size_t start = (offset + align - 1) & ~(align - 1);
+        if (start + size <= blocks[blockIdx].size) {
+            offset = start + size;
+            return blocks[blockIdx].data + start;
+        }
+        ++blockIdx;
+    }
+    //next kept block if large enough, otherwise insert a new one (oversized requests get their own)
+    if (blockIdx >= blocks.size() || blocks[blockIdx].size < size) {
+        Block b;
+        b.size = size > blockSize ? size : blockSize;
+        b.data = static_cast<char*>(::operator new(b.size));
+        blocks.insert(blocks.begin() + blockIdx, b);
+    }
+    offset = size;
+    return blocks[blockIdx].data;
+}
+
+void DRW_Arena::reset() {
+    blockIdx = 0;
+    offset = 0;
+}
+
+DRW_Arena *DRW_Arena::current() {
+    return currentArena;
+}
+
+DRW_Arena::Scope::Scope(DRW_Arena *a): prev(currentArena) {
+    currentArena = a;
+}
+
+DRW_Arena::Scope::~Scope() {
+    currentArena = prev;
+}
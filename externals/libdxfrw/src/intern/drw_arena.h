@@ -0,0 +1,108 @@
+/******************************************************************************
+**  libDXFrw - Library to read/write DXF files (ascii & binary)              **
+**                                                                           **
+**  Copyright (C) 2011-2015 José F. Soriano, rallazz@gmail.com               **
+**                                                                           **
+**  This library is free software, licensed under the terms of the GNU       **
+**  General Public License as published by the Free Software Foundation,     **
+**  either version 2 of the License, or (at your option) any later version.  **
+**  You should have received a copy of the GNU General Public License        **
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
+******************************************************************************/
+
+#ifndef DRW_ARENA_H
+#define DRW_ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <type_traits>
+
+//! Monotonic memory arena for parser temporaries
+/*!
+*  Memory is handed out by bumping a pointer inside large blocks, deallocation
+*  is a no-op. reset() rewinds to the first block, blocks are kept for reuse,
+*  so a parse that resets after every entity callback allocates from the heap
+*  only until the largest entity fits.
+*  The arena does not call destructors, owners of non trivial objects must
+*  destroy them before reset().
+*/
+class DRW_Arena {
+public:
+    explicit DRW_Arena(size_t blockSize = 64*1024);
+    ~DRW_Arena();
+
+    void *allocate(size_t size, size_t align);
+    void reset();
+
+    //! Arena used by default constructed DRW_ArenaAllocator in this thread, NULL if none
+    static DRW_Arena *current();
+
+    //! Makes an arena current for the lifetime of the scope
+    class Scope {
+    public:
+        explicit Scope(DRW_Arena *a);
+        ~Scope();
+    private:
+        DRW_Arena *prev;
+    };
+
+private:
+    DRW_Arena(const DRW_Arena&);
+    DRW_Arena& operator=(const DRW_Arena&);
+
+    struct Block {
+        char *data;
+        size_t size;
+    };
+    std::vector<Block> blocks;
+    size_t blockIdx;    //block in use
+    size_t offset;      //first free byte in blocks[blockIdx]
+    size_t blockSize;
+};
+
+//! std allocator on top of DRW_Arena
+/*!
+*  Default constructed allocators bind to DRW_Arena::current() and fall back
+*  to the heap if there is no current arena. Copies of a container get a heap
+*  allocator, so entities copied by the client outlive the arena reset.
+*/
+template <class T>
+class DRW_ArenaAllocator {
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    DRW_ArenaAllocator(): arena(DRW_Arena::current()) {}
+    explicit DRW_ArenaAllocator(DRW_Arena *a): arena(a) {}
+    template <class U>
+    DRW_ArenaAllocator(const DRW_ArenaAllocator<U> &o): arena(o.arena) {}
+
+    T *allocate(size_t n) {
+        if (arena)
+            return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T *p, size_t) {
+        if (!arena)
+            ::operator delete(p);
+    }
+    DRW_ArenaAllocator select_on_container_copy_construction() const {
+        return DRW_ArenaAllocator(NULL);
+    }
+
+    DRW_Arena *arena;
+};
+
+template <class T, class U>
+bool operator==(const DRW_ArenaAllocator<T> &a, const DRW_ArenaAllocator<U> &b) {
+    return a.arena == b.arena;
+}
+
+template <class T, class U>
+bool operator!=(const DRW_ArenaAllocator<T> &a, const DRW_ArenaAllocator<U> &b) {
+    return a.arena != b.arena;
+}
+
+#endif // DRW_ARENA_H
@@ -37,7 +37,8 @@ public:
     void setLevel(LEVEL lvl);
     LEVEL getLevel();
     static DRW_dbg *getInstance();
-    void print(std::string s);
+    void print(const std::string &s);
+    void print(const char *s);
     void print(int i);
     void print(unsigned int i);
     void print(long long int i);
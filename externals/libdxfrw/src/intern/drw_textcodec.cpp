@@ -5,6 +5,10 @@
 #include <cstring>
 #include <locale>
 #include <codecvt>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DRW_USE_SSE2
+#endif
 
 #include "../drw_base.h"
 #include "drw_cptables.h"
@@ -16,6 +20,7 @@
 DRW_TextCodec::DRW_TextCodec() {
 	version = DRW::AC1021;
 	conv = new DRW_Converter(NULL, 0);
+	asciiPassThrough = true;
 }
 
 DRW_TextCodec::~DRW_TextCodec() {
@@ -62,6 +67,7 @@ void DRW_TextCodec::setCodePage(std::string *c, bool dxfFormat){
 
 	cp = correctCodePage(*c);
 	delete conv;
+	asciiPassThrough = true;
 	if (version == DRW::AC1009 || version == DRW::AC1015) {
 		if (cp == "ANSI_874")
 			conv = new DRW_ConvTable(DRW_Table874, CPLENGHTCOMMON);
@@ -105,21 +111,52 @@ void DRW_TextCodec::setCodePage(std::string *c, bool dxfFormat){
 		} else {
 			if (dxfFormat)
 				conv = new DRW_Converter(NULL, 0);//utf16 to utf8
-			else
+			else {
 				conv = new DRW_ConvUTF16();//utf16 to utf8
+				asciiPassThrough = false;
+			}
 		}
 	}
 }
 
-std::string DRW_TextCodec::toUtf8(std::string s) {
+std::string DRW_TextCodec::toUtf8(const std::string &s) {
+	if (asciiPassThrough && isPlainAscii(s.data(), s.size()))
+		return s;
 	return conv->toUtf8(&s);
 }
 
+bool DRW_TextCodec::toUtf8(const std::string &s, std::string &out) {
+	if (asciiPassThrough && isPlainAscii(s.data(), s.size()))
+		return false;
+	out = conv->toUtf8(&s);
+	return true;
+}
+
+bool DRW_TextCodec::isPlainAscii(const char *s, size_t len) {
+	size_t i = 0;
+#ifdef DRW_USE_SSE2
+	//16 bytes at once: high bit set or backslash
+	const __m128i backslash = _mm_set1_epi8('\\');
+	for (; i + 16 <= len; i += 16) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+		int mask = _mm_movemask_epi8(v) | _mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash));
+		if (mask != 0)
+			return false;
+	}
+#endif
+	for (; i < len; ++i) {
+		unsigned char c = s[i];
+		if (c > 0x7F || c == '\\')
+			return false;
+	}
+	return true;
+}
+
 std::string DRW_TextCodec::fromUtf8(std::string s) {
 	return conv->fromUtf8(&s);
 }
 
-std::string DRW_Converter::toUtf8(std::string *s) {
+std::string DRW_Converter::toUtf8(const std::string *s) {
 	std::string result;
 	int j = 0;
 	unsigned int i= 0;
@@ -177,9 +214,18 @@ std::string DRW_ConvTable::fromUtf8(std::string *s) {
 	return result;
 }
 
-std::string DRW_ConvTable::toUtf8(std::string *s) {
+DRW_ConvTable::DRW_ConvTable(const int *t, int l):DRW_Converter(t, l) {
+	for (int i=0; i < 128; i++) {
+		std::string enc = encodeNum(table[i]);
+		utf8Lenght[i] = (unsigned char)enc.size();
+		memcpy(utf8Table[i], enc.data(), enc.size());
+	}
+}
+
+std::string DRW_ConvTable::toUtf8(const std::string *s) {
 	std::string res;
-	std::string::iterator it;
+	res.reserve(s->size() + s->size()/2);
+	std::string::const_iterator it;
 	for ( it=s->begin() ; it < s->end(); ++it ) {
 		unsigned char c = *it;
 		if (c < 0x80) {
@@ -194,7 +240,7 @@ std::string DRW_ConvTable::toUtf8(std::string *s) {
 			} else
 				res +=c; //c!='\' ascii char write
 		} else {//end c < 0x80
-			res += encodeNum(table[c-0x80]); //translate from table
+			res.append(utf8Table[c-0x80], utf8Lenght[c-0x80]); //translate from table
 		}
 	} //end for
 
@@ -318,9 +364,21 @@ std::string DRW_ConvDBCSTable::fromUtf8(std::string *s) {
 	return result;
 }
 
-std::string DRW_ConvDBCSTable::toUtf8(std::string *s) {
+void DRW_ConvDBCSTable::buildDirectTable() {
+	directTable.assign(0x8000, 0);
+	for (int k=0; k<cpLenght; k++){
+		int code = doubleTable[k][0];
+		if (code >= 0x8000 && directTable[code-0x8000] == 0)
+			directTable[code-0x8000] = (unsigned short)doubleTable[k][1];
+	}
+}
+
+std::string DRW_ConvDBCSTable::toUtf8(const std::string *s) {
+	if (directTable.empty())
+		buildDirectTable();
 	std::string res;
-	std::string::iterator it;
+	res.reserve(s->size() + s->size()/2);
+	std::string::const_iterator it;
 	for ( it=s->begin() ; it < s->end(); ++it ) {
 		bool notFound = true;
 		unsigned char c = *it;
@@ -339,17 +397,13 @@ std::string DRW_ConvDBCSTable::toUtf8(std::string *s) {
 		} else if(c == 0x80 ){//1 byte table
 			notFound = false;
 			res += encodeNum(0x20AC);//euro sign
-		} else {//2 bytes
+		} else if (it+1 < s->end()) {//2 bytes
 			++it;
 			int code = (c << 8) | (unsigned char )(*it);
-			int sta = leadTable[c-0x81];
-			int end = leadTable[c-0x80];
-			for (int k=sta; k<end; k++){
-				if(doubleTable[k][0] == code) {
-					res += encodeNum(doubleTable[k][1]); //translate from table
-					notFound = false;
-					break;
-				}
+			int uc = directTable[code-0x8000];
+			if (uc != 0) {
+				res += encodeNum(uc); //translate from table
+				notFound = false;
 			}
 		}
 		//not found
@@ -404,9 +458,21 @@ std::string DRW_Conv932Table::fromUtf8(std::string *s) {
 	return result;
 }
 
-std::string DRW_Conv932Table::toUtf8(std::string *s) {
+void DRW_Conv932Table::buildDirectTable() {
+	directTable.assign(0x8000, 0);
+	for (int k=0; k<cpLenght; k++){
+		int code = doubleTable[k][0];
+		if (code >= 0x8000 && directTable[code-0x8000] == 0)
+			directTable[code-0x8000] = (unsigned short)doubleTable[k][1];
+	}
+}
+
+std::string DRW_Conv932Table::toUtf8(const std::string *s) {
+	if (directTable.empty())
+		buildDirectTable();
 	std::string res;
-	std::string::iterator it;
+	res.reserve(s->size() + s->size()/2);
+	std::string::const_iterator it;
 	for ( it=s->begin() ; it < s->end(); ++it ) {
 		bool notFound = true;
 		unsigned char c = *it;
@@ -425,25 +491,15 @@ std::string DRW_Conv932Table::toUtf8(std::string *s) {
 		} else if(c > 0xA0 && c < 0xE0 ){//1 byte table
 			notFound = false;
 			res += encodeNum(c + CPOFFSET932); //translate from table
-		} else {//2 bytes
+		} else if (it+1 < s->end()) {//2 bytes
 			++it;
 			int code = (c << 8) | (unsigned char )(*it);
-			int sta;
-			int end=0;
-			if (c > 0x80 && c < 0xA0) {
-				sta = DRW_LeadTable932[c-0x81];
-				end = DRW_LeadTable932[c-0x80];
-			} else if (c > 0xDF && c < 0xFD){
-				sta = DRW_LeadTable932[c-0xC1];
-				end = DRW_LeadTable932[c-0xC0];
-			}
-			if (end > 0) {
-				for (int k=sta; k<end; k++){
-					if(DRW_DoubleTable932[k][0] == code) {
-						res += encodeNum(DRW_DoubleTable932[k][1]); //translate from table
-						notFound = false;
-						break;
-					}
+			//valid lead bytes 0x81-0x9F and 0xE0-0xFC
+			if ((c > 0x80 && c < 0xA0) || (c > 0xDF && c < 0xFD)) {
+				int uc = directTable[code-0x8000];
+				if (uc != 0) {
+					res += encodeNum(uc); //translate from table
+					notFound = false;
 				}
 			}
 		}
@@ -460,9 +516,9 @@ std::string DRW_ConvUTF16::fromUtf8(std::string *s){
 	return std::string();
 }
 
-std::string DRW_ConvUTF16::toUtf8(std::string *s){//RLZ: pending to write
+std::string DRW_ConvUTF16::toUtf8(const std::string *s){//RLZ: pending to write
 	std::string res;
-	std::string::iterator it;
+	std::string::const_iterator it;
 	for ( it=s->begin() ; it < s->end(); ++it ) {
 		unsigned char c1 = *it;
 		unsigned char c2 = *(++it);
@@ -504,7 +560,7 @@ std::string DRW_ExtConverter::fromUtf8(std::string *s){
 	return convertByiconv("UTF8", this->encoding, s);
 }
 
-std::string DRW_ExtConverter::toUtf8(std::string *s){
+std::string DRW_ExtConverter::toUtf8(const std::string *s){
 	return convertByiconv(this->encoding, "UTF8", s);
 }
 
@@ -2,6 +2,7 @@
 #define DRW_TEXTCODEC_H
 
 #include <string>
+#include <vector>
 
 class DRW_Converter;
 
@@ -11,7 +12,11 @@ public:
     DRW_TextCodec();
     ~DRW_TextCodec();
     std::string fromUtf8(std::string s);
-    std::string toUtf8(std::string s);
+    std::string toUtf8(const std::string &s);
+    //return true and decode in 'out' if 's' need conversion, false if 's' is already valid utf8
+    bool toUtf8(const std::string &s, std::string &out);
+    //true if 's' has no byte > 0x7F and no '\\' (no \U+ escape), valid utf8 in all code pages
+    static bool isPlainAscii(const char *s, size_t len);
     int getVersion(){return version;}
     void setVersion(std::string *v, bool dxfFormat);
     void setVersion(int v, bool dxfFormat);
@@ -26,6 +31,7 @@ private:
     int version;
     std::string cp;
     DRW_Converter *conv;
+    bool asciiPassThrough; //false if plain ascii must be converted too (utf16)
 };
 
 class DRW_Converter
@@ -35,7 +41,7 @@ public:
                                cpLenght = l;}
     virtual ~DRW_Converter(){}
     virtual std::string fromUtf8(std::string *s) {return *s;}
-    virtual std::string toUtf8(std::string *s);
+    virtual std::string toUtf8(const std::string *s);
     std::string encodeText(std::string stmp);
     std::string decodeText(int c);
     std::string encodeNum(int c);
@@ -48,14 +54,18 @@ class DRW_ConvUTF16 : public DRW_Converter {
 public:
     DRW_ConvUTF16():DRW_Converter(NULL, 0) {}
     virtual std::string fromUtf8(std::string *s);
-    virtual std::string toUtf8(std::string *s);
+    virtual std::string toUtf8(const std::string *s);
 };
 
 class DRW_ConvTable : public DRW_Converter {
 public:
-    DRW_ConvTable(const int *t, int l):DRW_Converter(t, l) {}
+    DRW_ConvTable(const int *t, int l);
     virtual std::string fromUtf8(std::string *s);
-    virtual std::string toUtf8(std::string *s);
+    virtual std::string toUtf8(const std::string *s);
+private:
+    //utf8 sequence of bytes 0x80-0xFF, precomputed from table
+    char utf8Table[128][4];
+    unsigned char utf8Lenght[128];
 };
 
 class DRW_ConvDBCSTable : public DRW_Converter {
@@ -66,10 +76,13 @@ public:
     }
 
     virtual std::string fromUtf8(std::string *s);
-    virtual std::string toUtf8(std::string *s);
+    virtual std::string toUtf8(const std::string *s);
 private:
+    void buildDirectTable();
     const int *leadTable;
     const int (*doubleTable)[2];
+    //unicode of double byte code 0x8000-0xFFFF, 0 if not found, built on first use
+    std::vector<unsigned short> directTable;
 
 };
 
@@ -81,10 +94,13 @@ public:
     }
 
     virtual std::string fromUtf8(std::string *s);
-    virtual std::string toUtf8(std::string *s);
+    virtual std::string toUtf8(const std::string *s);
 private:
+    void buildDirectTable();
     const int *leadTable;
     const int (*doubleTable)[2];
+    //unicode of double byte code 0x8000-0xFFFF, 0 if not found, built on first use
+    std::vector<unsigned short> directTable;
 
 };
 
@@ -94,7 +110,7 @@ public:
         encoding = enc;
     }
     virtual std::string fromUtf8(std::string *s);
-    virtual std::string toUtf8(std::string *s);
+    virtual std::string toUtf8(const std::string *s);
  private:
     const char *encoding;
     std::string convertByiconv(const char *in_encode,
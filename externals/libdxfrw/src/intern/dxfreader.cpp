@@ -11,6 +11,7 @@
 ******************************************************************************/
 
 #include <cstdlib>
+#include <limits>
 #include <fstream>
 #include <string>
 #include <sstream>
@@ -18,6 +19,91 @@
 #include "drw_textcodec.h"
 #include "drw_dbg.h"
 
+namespace {
+
+//same result as atoi, without locale and errno handling
+int parseInt(const char *p) {
+    while (*p == ' ' || *p == '\t')
+        ++p;
+    bool neg = false;
+    if (*p == '-' || *p == '+')
+        neg = (*p++ == '-');
+    long long v = 0;
+    while (*p >= '0' && *p <= '9')
+        v = v * 10 + (*p++ - '0');
+    return static_cast<int>(neg ? -v : v);
+}
+
+/* Parses plain decimal numbers with up to 19 significant digits. If the
+ * mantissa fits in 53 bits and the decimal exponent in [-22, 22], one exact
+ * multiplication or division gives the correctly rounded value. Returns false
+ * for everything else, the caller then uses the stream conversion.
+ */
+bool parseDouble(const char *p, double *d) {
+    static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                   1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    while (*p == ' ' || *p == '\t')
+        ++p;
+    bool neg = false;
+    if (*p == '-' || *p == '+')
+        neg = (*p++ == '-');
+    unsigned long long mant = 0;
+    int digits = 0; //significant digits in mant
+    int exp10 = 0;
+    bool any = false;
+    for (; *p >= '0' && *p <= '9'; ++p) {
+        any = true;
+        if (mant == 0 && *p == '0')
+            continue;
+        if (++digits > 19)
+            return false;
+        mant = mant * 10 + (*p - '0');
+    }
+    if (*p == '.') {
+        for (++p; *p >= '0' && *p <= '9'; ++p) {
+            any = true;
+            --exp10;
+            if (mant == 0 && *p == '0')
+                continue;
+            if (++digits > 19)
+                return false;
+            mant = mant * 10 + (*p - '0');
+        }
+    }
+    if (!any)
+        return false;
+    if (*p == 'e' || *p == 'E') {
+        ++p;
+        bool eneg = false;
+        if (*p == '-' || *p == '+')
+            eneg = (*p++ == '-');
+        if (*p < '0' || *p > '9')
+            return false;
+        int e = 0;
+        for (; *p >= '0' && *p <= '9'; ++p) {
+            if (e < 10000)
+                e = e * 10 + (*p - '0');
+        }
+        exp10 += eneg ? -e : e;
+    }
+    while (*p == ' ' || *p == '\t')
+        ++p;
+    if (*p != '\0')
+        return false;
+    if (mant == 0) {
+        *d = neg ? -0.0 : 0.0;
+        return true;
+    }
+    if (mant > (1ULL << 53) || exp10 < -22 || exp10 > 22)
+        return false;
+    double v = static_cast<double>(mant);
+    v = exp10 < 0 ? v / pow10[-exp10] : v * pow10[exp10];
+    *d = neg ? -v : v;
+    return true;
+}
+
+}
+
 bool dxfReader::readRec(int *codeData) {
 //    std::string text;
     int code;
@@ -87,6 +173,18 @@ bool dxfReader::readRec(int *codeData) {
 
     return (filestr->good());
 }
+bool dxfReader::skipRec(int *codeData) {
+    //binary values have a type dependent size
+    if (!skip)
+        return readRec(codeData);
+    if (!readCode(codeData))
+        return false;
+    if (*codeData < 10)
+        return readString();
+    filestr->ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    return (filestr->good());
+}
+
 int dxfReader::getHandleString(){
     int res;
 #if defined(__APPLE__)
@@ -184,12 +282,18 @@ bool dxfReaderBinary::readBool() {
     return (filestr->good());
 }
 
+bool dxfReaderAscii::readLine() {
+    std::getline(*filestr, lineBuf);
+    if (!lineBuf.empty() && lineBuf[lineBuf.size()-1] == '\r')
+        lineBuf.erase(lineBuf.size()-1);
+    return (filestr->good());
+}
+
 bool dxfReaderAscii::readCode(int *code) {
-    std::string text;
-    std::getline(*filestr, text);
-    *code = atoi(text.c_str());
+    bool ok = readLine();
+    *code = parseInt(lineBuf.c_str());
     DRW_DBG(*code); DRW_DBG("\n");
-    return (filestr->good());
+    return ok;
 }
 bool dxfReaderAscii::readString(std::string *text) {
     type = STRING;
@@ -210,9 +314,8 @@ bool dxfReaderAscii::readString() {
 
 bool dxfReaderAscii::readInt16() {
     type = INT32;
-    std::string text;
-    if (readString(&text)){
-        intData = atoi(text.c_str());
+    if (readLine()){
+        intData = parseInt(lineBuf.c_str());
         DRW_DBG(intData); DRW_DBG("\n");
         return true;
     } else
@@ -231,18 +334,21 @@ bool dxfReaderAscii::readInt64() {
 
 bool dxfReaderAscii::readDouble() {
     type = DOUBLE;
-    std::string text;
-    if (readString(&text)){
+    if (readLine()){
+        if (parseDouble(lineBuf.c_str(), &doubleData))
+            return true;
+        //exponent or digits out of the exact range, let the library round
 #if defined(__APPLE__)
-        int succeeded=sscanf( & (text[0]), "%lg", &doubleData);
+        int succeeded=sscanf( lineBuf.c_str(), "%lg", &doubleData);
         if(succeeded != 1) {
             DRW_DBG("dxfReaderAscii::readDouble(): reading double error: ");
-            DRW_DBG(text);
+            DRW_DBG(lineBuf);
             DRW_DBG('\n');
         }
 #else
-        std::istringstream sd(text);
-        sd >> doubleData;
+        numStream.clear();
+        numStream.str(lineBuf);
+        numStream >> doubleData;
         DRW_DBG(doubleData); DRW_DBG('\n');
 #endif
         return true;
@@ -253,12 +359,10 @@ bool dxfReaderAscii::readDouble() {
 //saved as int or add a bool member??
 bool dxfReaderAscii::readBool() {
     type = BOOL;
-    std::string text;
-    if (readString(&text)){
-        intData = atoi(text.c_str());
+    if (readLine()){
+        intData = parseInt(lineBuf.c_str());
         DRW_DBG(intData); DRW_DBG("\n");
         return true;
     } else
         return false;
 }
-
@@ -13,6 +13,7 @@
 #ifndef DXFREADER_H
 #define DXFREADER_H
 
+#include <sstream>
 #include "drw_textcodec.h"
 
 class dxfReader {
@@ -33,11 +34,17 @@ public:
     }
     virtual ~dxfReader(){}
     bool readRec(int *code);
+    //reads the next group like readRec, in ascii files only string values (code < 10) are read
+    bool skipRec(int *code);
 
-    std::string getString() {return strData;}
+    //valid until the next readRec
+    const std::string &getString() {return strData;}
     int getHandleString();//Convert hex string to int
-    std::string toUtf8String(std::string t) {return decoder.toUtf8(t);}
-    std::string getUtf8String() {return decoder.toUtf8(strData);}
+    std::string toUtf8String(const std::string &t) {return decoder.toUtf8(t);}
+    //plain ascii is returned as is, no copy
+    const std::string &getUtf8String() {
+        return decoder.toUtf8(strData, utf8Data) ? utf8Data : strData;
+    }
     double getDouble() {return doubleData;}
     int getInt32() {return intData;}
     unsigned long long int getInt64() {return int64;}
@@ -60,6 +67,7 @@ protected:
 protected:
     std::ifstream *filestr;
     std::string strData;
+    std::string utf8Data; //decoded strData, only valid after getUtf8String
     double doubleData;
     signed int intData; //32 bits integer
     unsigned long long int int64; //64 bits integer
@@ -84,7 +92,10 @@ public:
 
 class dxfReaderAscii : public dxfReader {
 public:
-    dxfReaderAscii(std::ifstream *stream):dxfReader(stream){skip = true; }
+    dxfReaderAscii(std::ifstream *stream):dxfReader(stream){
+        skip = true;
+        numStream.imbue(std::locale::classic());
+    }
     virtual ~dxfReaderAscii(){}
     virtual bool readCode(int *code);
     virtual bool readString(std::string *text);
@@ -94,6 +105,11 @@ public:
     virtual bool readInt32();
     virtual bool readInt64();
     virtual bool readBool();
+private:
+    bool readLine();
+    //scratch buffers reused for every group, no allocation once grown
+    std::string lineBuf;
+    std::istringstream numStream;
 };
 
 #endif // DXFREADER_H
@@ -11,6 +11,9 @@
 ******************************************************************************/
 
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
 #include <fstream>
 #include <string>
 #include <algorithm>
@@ -91,6 +94,14 @@
     return (filestr->good());
 }*/
 
+bool dxfWriter::flush() {
+    if (!buffer.empty()) {
+        filestr->write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+    return filestr->good();
+}
+
 bool dxfWriter::writeUtf8String(int code, std::string text) {
     std::string t = encoder.fromUtf8(text);
     return writeString(code, t);
@@ -107,9 +118,9 @@ bool dxfWriterBinary::writeString(int code, std::string text) {
     char bufcode[2];
     bufcode[0] =code & 0xFF;
     bufcode[1] =code  >> 8;
-    filestr->write(bufcode, 2);
-    *filestr << text << '\0';
-    return (filestr->good());
+    put(bufcode, 2);
+    put(text.c_str(), text.size() + 1); //incl. terminating '\0'
+    return good();
 }
 
 /*bool dxfWriterBinary::readCode(int *code) {
@@ -143,99 +154,102 @@ bool dxfWriterBinary::writeString(int code, std::string text) {
 }*/
 
 bool dxfWriterBinary::writeInt16(int code, int data) {
-    char bufcode[2];
-    char buffer[2];
-    bufcode[0] =code & 0xFF;
-    bufcode[1] =code  >> 8;
-    buffer[0] =data & 0xFF;
-    buffer[1] =data  >> 8;
-    filestr->write(bufcode, 2);
-    filestr->write(buffer, 2);
-    return (filestr->good());
+    char buffer[4];
+    buffer[0] =code & 0xFF;
+    buffer[1] =code  >> 8;
+    buffer[2] =data & 0xFF;
+    buffer[3] =data  >> 8;
+    put(buffer, 4);
+    return good();
 }
 
 bool dxfWriterBinary::writeInt32(int code, int data) {
-    char buffer[4];
+    char buffer[6];
     buffer[0] =code & 0xFF;
     buffer[1] =code  >> 8;
-    filestr->write(buffer, 2);
-
-    buffer[0] =data & 0xFF;
-    buffer[1] =data  >> 8;
-    buffer[2] =data  >> 16;
-    buffer[3] =data  >> 24;
-    filestr->write(buffer, 4);
-    return (filestr->good());
+    buffer[2] =data & 0xFF;
+    buffer[3] =data  >> 8;
+    buffer[4] =data  >> 16;
+    buffer[5] =data  >> 24;
+    put(buffer, 6);
+    return good();
 }
 
 bool dxfWriterBinary::writeInt64(int code, unsigned long long int data) {
-    char buffer[8];
+    char buffer[10];
     buffer[0] =code & 0xFF;
     buffer[1] =code  >> 8;
-    filestr->write(buffer, 2);
-
-    buffer[0] =data & 0xFF;
-    buffer[1] =data  >> 8;
-    buffer[2] =data  >> 16;
-    buffer[3] =data  >> 24;
-    buffer[4] =data  >> 32;
-    buffer[5] =data  >> 40;
-    buffer[6] =data  >> 48;
-    buffer[7] =data  >> 56;
-    filestr->write(buffer, 8);
-    return (filestr->good());
+    for (int i=0; i<8; i++)
+        buffer[2+i] =data >> (8*i);
+    put(buffer, 10);
+    return good();
 }
 
 bool dxfWriterBinary::writeDouble(int code, double data) {
-    char bufcode[2];
-    char buffer[8];
-    bufcode[0] =code & 0xFF;
-    bufcode[1] =code  >> 8;
-    filestr->write(bufcode, 2);
-
-    unsigned char *val;
-    val = (unsigned char *) &data;
-    for (int i=0; i<8; i++) {
-        buffer[i] =val[i];
-    }
-    filestr->write(buffer, 8);
-    return (filestr->good());
+    char buffer[10];
+    buffer[0] =code & 0xFF;
+    buffer[1] =code  >> 8;
+    memcpy(buffer + 2, &data, 8);
+    put(buffer, 10);
+    return good();
 }
 
 //saved as int or add a bool member??
 bool dxfWriterBinary::writeBool(int code, bool data) {
-    char buffer[1];
-    char bufcode[2];
-    bufcode[0] =code & 0xFF;
-    bufcode[1] =code  >> 8;
-    filestr->write(bufcode, 2);
-    buffer[0] = data;
-    filestr->write(buffer, 1);
-    return (filestr->good());
+    char buffer[3];
+    buffer[0] =code & 0xFF;
+    buffer[1] =code  >> 8;
+    buffer[2] = data;
+    put(buffer, 3);
+    return good();
 }
 
 dxfWriterAscii::dxfWriterAscii(std::ofstream *stream):dxfWriter(stream){
-    filestr->precision(16);
+}
+
+void dxfWriterAscii::putUInt(unsigned long long int value, int width) {
+    char buf[32];
+    char *end = buf + sizeof(buf);
+    char *p = end;
+    *--p = '\n';
+    do {
+        *--p = '0' + (value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (end - p - 1 < width)
+        *--p = ' ';
+    put(p, end - p);
+}
+
+void dxfWriterAscii::putInt(long long int value, int width) {
+    char buf[32];
+    char *end = buf + sizeof(buf);
+    char *p = end;
+    *--p = '\n';
+    //negate as unsigned, also valid for the smallest value
+    unsigned long long int u = value < 0 ? 0ULL - (unsigned long long int)value : (unsigned long long int)value;
+    do {
+        *--p = '0' + (u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (value < 0)
+        *--p = '-';
+    while (end - p - 1 < width)
+        *--p = ' ';
+    put(p, end - p);
 }
 
 bool dxfWriterAscii::writeString(int code, std::string text) {
-//    *filestr << code << std::endl << text << std::endl ;
-    filestr->width(3);
-    *filestr << std::right << code << std::endl;
-    filestr->width(0);
-    *filestr << std::left << text << std::endl;
-    /*    std::getline(*filestr, strData, '\0');
-    DBG(strData); DBG("\n");*/
-    return (filestr->good());
+    putInt(code, 3);
+    put(text.c_str(), text.size());
+    put("\n", 1);
+    return good();
 }
 
 bool dxfWriterAscii::writeInt16(int code, int data) {
-//    *filestr << std::right << code << std::endl << data << std::endl;
-    filestr->width(3);
-    *filestr << std::right << code << std::endl;
-    filestr->width(5);
-    *filestr << data << std::endl;
-    return (filestr->good());
+    putInt(code, 3);
+    putInt(data, 5);
+    return good();
 }
 
 bool dxfWriterAscii::writeInt32(int code, int data) {
@@ -243,28 +257,37 @@ bool dxfWriterAscii::writeInt32(int code, int data) {
 }
 
 bool dxfWriterAscii::writeInt64(int code, unsigned long long int data) {
-//    *filestr << code << std::endl << data << std::endl;
-    filestr->width(3);
-    *filestr << std::right << code << std::endl;
-    filestr->width(5);
-    *filestr << data << std::endl;
-    return (filestr->good());
+    putInt(code, 3);
+    putUInt(data, 5);
+    return good();
 }
 
 bool dxfWriterAscii::writeDouble(int code, double data) {
-//    std::streamsize prec = filestr->precision();
-//    filestr->precision(12);
-//    *filestr << code << std::endl << data << std::endl;
-    filestr->width(3);
-    *filestr << std::right << code << std::endl;
-    *filestr << data << std::endl;
-//    filestr->precision(prec);
-    return (filestr->good());
+    putInt(code, 3);
+    //integral values (coordinates, angles, flags) are formatted like integers,
+    //%.16g prints them without exponent and decimal point below 1e16
+    if (data == data && std::fabs(data) < 1e15 && data == (double)(long long int)data
+            && !(data == 0 && std::signbit(data))) {
+        putInt((long long int)data, 0);
+        return good();
+    }
+    char buf[40];
+    int n = snprintf(buf, sizeof(buf), "%.16g", data);
+    //snprintf uses the C locale, the stream always used '.' as decimal separator
+    for (int i = 0; i < n; ++i) {
+        char c = buf[i];
+        if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == 'e' || c == 'n' || c == 'a' || c == 'i' || c == 'f'))
+            buf[i] = '.';
+    }
+    buf[n] = '\n';
+    put(buf, n + 1);
+    return good();
 }
 
 //saved as int or add a bool member??
 bool dxfWriterAscii::writeBool(int code, bool data) {
-    *filestr << code << std::endl << data << std::endl;
-    return (filestr->good());
+    putInt(code, 0);
+    put(data ? "1\n" : "0\n", 2);
+    return good();
 }
 
@@ -13,12 +13,17 @@
 #ifndef DXFWRITER_H
 #define DXFWRITER_H
 
+#include <fstream>
+#include <string>
 #include "drw_textcodec.h"
 
+//All output is formatted into an in-memory buffer, which is written to the stream in
+//large blocks (BUFFER_SIZE) instead of one or two stream operations per field.
+//Stream errors are reported once the buffer has been written, call flush() before closing the stream.
 class dxfWriter {
 public:
-    dxfWriter(std::ofstream *stream){filestr = stream; /*count =0;*/}
-    virtual ~dxfWriter(){}
+    dxfWriter(std::ofstream *stream){filestr = stream; buffer.reserve(BUFFER_SIZE); /*count =0;*/}
+    virtual ~dxfWriter(){flush();}
     virtual bool writeString(int code, std::string text) = 0;
     bool writeUtf8String(int code, std::string text);
     bool writeUtf8Caps(int code, std::string text);
@@ -31,8 +36,19 @@ public:
     void setVersion(std::string *v, bool dxfFormat){encoder.setVersion(v, dxfFormat);}
     void setCodePage(std::string *c){encoder.setCodePage(c, true);}
     std::string getCodePage(){return encoder.getCodePage();}
+    bool flush(); //writes the buffered data to the stream
 protected:
+    static const std::string::size_type BUFFER_SIZE = 1 << 20;
+    //appends data to the output buffer, written when BUFFER_SIZE is exceeded
+    void put(const char *data, std::string::size_type size) {
+        buffer.append(data, size);
+        if (buffer.size() >= BUFFER_SIZE)
+            flush();
+    }
+    bool good() const { return filestr->good(); }
+
     std::ofstream *filestr;
+    std::string buffer;
 private:
     DRW_TextCodec encoder;
 };
@@ -49,6 +65,8 @@ public:
     virtual bool writeBool(int code, bool data);
 };
 
+//Same output as formatting the fields with std::ostream (group codes right aligned with width 3,
+//integers right aligned with width 5, doubles with precision 16), without flushing every line.
 class dxfWriterAscii : public dxfWriter {
 public:
     dxfWriterAscii(std::ofstream *stream);
@@ -59,6 +77,10 @@ public:
     virtual bool writeInt64(int code, unsigned long long int data);
     virtual bool writeDouble(int code, double data);
     virtual bool writeBool(int code, bool data);
+private:
+    //append an integer right aligned with the given minimum width and a line break
+    void putInt(long long int value, int width);
+    void putUInt(unsigned long long int value, int width);
 };
 
 #endif // DXFWRITER_H
@@ -42,6 +42,7 @@ dxfRW::dxfRW(const std::string &name){
 	reader = NULL;
 	writer = NULL;
 	applyExt = false;
+	filterLayers = false;
 	elParts = 128; //parts munber when convert ellipse to polyline
 }
 dxfRW::~dxfRW(){
@@ -73,15 +74,53 @@ bool dxfRW::read(DRW_Interface *interface_, bool ext){
 	if ( interface_ == NULL )
 				return isOk;
 	DRW_DBG("dxfRW::read 1def\n");
+	iface = interface_;
+	if (!openReader(filestr))
+		return isOk;
+
+	isOk = processDxf();
+	filestr.close();
+	delete reader;
+	reader = NULL;
+	return isOk;
+}
+
+void dxfRW::setLayerFilter(const std::vector<std::string> &layers){
+	layerFilter = layers;
+	std::sort(layerFilter.begin(), layerFilter.end());
+}
+
+void dxfRW::setEntityFilter(const std::vector<std::string> &types){
+	entityFilter = types;
+	std::sort(entityFilter.begin(), entityFilter.end());
+}
+
+bool dxfRW::scan(DRW_ScanInfo *info, bool countEntities){
+	drw_assert(fileName.empty() == false);
+	if (info == NULL)
+		return false;
+	*info = DRW_ScanInfo();
+	std::ifstream filestr;
+	if (!openReader(filestr))
+		return false;
+
+	bool isOk = scanDxf(info, countEntities);
+	filestr.close();
+	delete reader;
+	reader = NULL;
+	return isOk;
+}
+
+bool dxfRW::openReader(std::ifstream &filestr){
 //	filestr.open (fileName, std::ios_base::in | std::ios::binary);
 
 	// Replaced original code with IBK function to account for UTF-8
 	IBK::open_ifstream(filestr, IBK::Path(fileName), std::ios_base::in | std::ios::binary);
 
 	if (!filestr.is_open())
-		return isOk;
+		return false;
 	if (!filestr.good())
-		return isOk;
+		return false;
 
 	char line[22];
 	char line2[22] = "AutoCAD Binary DXF\r\n";
@@ -89,7 +128,6 @@ bool dxfRW::read(DRW_Interface *interface_, bool ext){
 	line2[21] = '\0';
 	filestr.read (line, 22);
 	filestr.close();
-	iface = interface_;
 	DRW_DBG("dxfRW::read 2\n");
 	if (strcmp(line, line2) == 0) {
 //		filestr.open (fileName, std::ios_base::in | std::ios::binary);
@@ -111,12 +149,7 @@ bool dxfRW::read(DRW_Interface *interface_, bool ext){
 
 		reader = new dxfReaderAscii(&filestr);
 	}
-
-	isOk = processDxf();
-	filestr.close();
-	delete reader;
-	reader = NULL;
-	return isOk;
+	return true;
 }
 
 bool dxfRW::write(DRW_Interface *interface_, DRW::Version ver, bool bin){
@@ -169,6 +202,7 @@ bool dxfRW::write(DRW_Interface *interface_, DRW::Version ver, bool bin){
 		writer->writeString(0, "ENDSEC");
 	}
 	writer->writeString(0, "EOF");
+	writer->flush();
 	filestr.flush();
 	filestr.close();
 	isOk = true;
@@ -760,7 +794,7 @@ bool dxfRW::writeLWPolyline(DRW_LWPolyline *ent){
 		if (ent->thickness != 0)
 			writer->writeDouble(39, ent->thickness);
 		for (int i = 0;  i< ent->vertexnum; i++){
-			DRW_Vertex2D *v = ent->vertlist.at(i);
+			const DRW_Vertex2D *v = &ent->vertlist.at(i);
 			writer->writeDouble(10, v->x);
 			writer->writeDouble(20, v->y);
 			if (v->stawidth != 0)
@@ -892,10 +926,12 @@ bool dxfRW::writeSpline(DRW_Spline *ent){
 			writer->writeDouble(40, ent->knotslist.at(i));
 		}
 		for (int i = 0;  i< ent->ncontrol; i++){
-			DRW_Coord *crd = ent->controllist.at(i);
+			const DRW_Coord *crd = &ent->controllist.at(i);
 			writer->writeDouble(10, crd->x);
 			writer->writeDouble(20, crd->y);
 			writer->writeDouble(30, crd->z);
+			if (ent->weightlist.size() == ent->controllist.size())
+				writer->writeDouble(41, ent->weightlist.at(i));
 		}
 	} else {
 		//RLZ: TODO convert spline in polyline (not exist in acad 12)
@@ -1893,6 +1929,74 @@ bool dxfRW::processHeader() {
 	return true;
 }
 
+/********* Quick Scan *********/
+
+bool dxfRW::scanDxf(DRW_ScanInfo *info, bool countEntities) {
+	DRW_DBG("dxfRW::scanDxf\n");
+	int code;
+	std::string sectionstr;
+	std::string table; // name of the current table in TABLES section
+	std::string section;
+	DRW_Header scanHeader;
+	std::vector<std::string> names;
+	names.push_back("$INSUNITS");
+	names.push_back("$EXTMIN");
+	names.push_back("$EXTMAX");
+	scanHeader.setFilter(names);
+	bool inLayer = false;
+	// only the header needs typed values, the other sections are skipped unconverted
+	while (section == "HEADER" ? reader->readRec(&code) : reader->skipRec(&code)) {
+		if (code == 999)
+			continue;
+		if (code != 0) {
+			if (section == "HEADER")
+				scanHeader.parseCode(code, reader);
+			else if (section.empty() && code == 2) {
+				section = reader->getString();
+				// classes and objects are not scanned, stop once the entities are counted
+				if (section == "OBJECTS" || (!countEntities && (section == "BLOCKS" || section == "ENTITIES")))
+					break;
+			}
+			else if (section == "TABLES" && code == 2) {
+				if (inLayer)
+					info->layers.push_back(reader->getUtf8String());
+				else if (table.empty())
+					table = reader->getString();
+				inLayer = false;
+			}
+			continue;
+		}
+		sectionstr = reader->getString();
+		if (sectionstr == "EOF")
+			break;
+		if (sectionstr == "SECTION") {
+			section.clear();
+		} else if (sectionstr == "ENDSEC") {
+			if (section == "HEADER")
+				info->header = scanHeader.vars;
+			if (section == "ENTITIES")
+				break;
+			section = "ENDSEC";
+		} else if (section == "TABLES") {
+			if (sectionstr == "TABLE")
+				table.clear();
+			else if (sectionstr == "ENDTAB")
+				table = "ENDTAB";
+			else
+				++info->tableEntries[sectionstr];
+			inLayer = (sectionstr == "LAYER" && table == "LAYER");
+		} else if (section == "BLOCKS" || section == "ENTITIES") {
+			if (sectionstr == "BLOCK")
+				++info->blocks;
+			else if (sectionstr != "ENDBLK")
+				++info->entities[sectionstr];
+		}
+	}
+	info->version = static_cast<DRW::Version>(reader->getVersion());
+	info->complete = countEntities;
+	return true;
+}
+
 /********* Tables Section *********/
 
 bool dxfRW::processTables() {
@@ -2158,9 +2262,17 @@ bool dxfRW::processEntities(bool isblock) {
 	} else if (!isblock) {
 			return false;  //first record in entities is 0
    }
+	//block entities are usually on layer 0 and drawn on the layer of the insert,
+	//so the layer filter only applies to the ENTITIES section
+	filterLayers = !isblock && !layerFilter.empty();
+	//vertex lists and extended data of the entities below live in entityArena
+	DRW_Arena::Scope arenaScope(&entityArena);
 	do {
 		if (nextentity == "ENDSEC" || nextentity == "ENDBLK") {
 			return true;  //found ENDSEC or ENDBLK terminate
+		} else if (!entityFilter.empty() && std::binary_search(entityFilter.begin(), entityFilter.end(), nextentity)) {
+			if (!skipEntity())
+				return false; //end of file without ENDSEC
 		} else if (nextentity == "POINT") {
 			processPoint();
 		} else if (nextentity == "LINE") {
@@ -2210,11 +2322,31 @@ bool dxfRW::processEntities(bool isblock) {
 			} else
 				return false; //end of file without ENDSEC
 		}
+		//entity and its callback are done
+		entityArena.reset();
 
 	} while (next);
 	return true;
 }
 
+bool dxfRW::skipLayer(const std::string &layer) const {
+	return filterLayers && !std::binary_search(layerFilter.begin(), layerFilter.end(), layer);
+}
+
+bool dxfRW::skipEntity() {
+	DRW_DBG("dxfRW::skipEntity\n");
+	int code;
+	while (reader->skipRec(&code)) {
+		if (code == 0) {
+			nextentity = reader->getString();
+			//vertices and attributes belong to the skipped entity
+			if (nextentity != "VERTEX" && nextentity != "ATTRIB" && nextentity != "SEQEND")
+				return true;  //found new entity or ENDSEC, terminate
+		}
+	}
+	return false;
+}
+
 bool dxfRW::processEllipse() {
 	DRW_DBG("dxfRW::processEllipse");
 	int code;
@@ -2232,6 +2364,8 @@ bool dxfRW::processEllipse() {
 		}
 		default:
 			ellipse.parseCode(code, reader);
+			if (code == 8 && skipLayer(ellipse.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2255,6 +2389,8 @@ bool dxfRW::processTrace() {
 		}
 		default:
 			trace.parseCode(code, reader);
+			if (code == 8 && skipLayer(trace.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2278,6 +2414,8 @@ bool dxfRW::processSolid() {
 		}
 		default:
 			solid.parseCode(code, reader);
+			if (code == 8 && skipLayer(solid.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2299,6 +2437,8 @@ bool dxfRW::process3dface() {
 		}
 		default:
 			face.parseCode(code, reader);
+			if (code == 8 && skipLayer(face.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2320,6 +2460,8 @@ bool dxfRW::processViewport() {
 		}
 		default:
 			vp.parseCode(code, reader);
+			if (code == 8 && skipLayer(vp.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2341,6 +2483,8 @@ bool dxfRW::processPoint() {
 		}
 		default:
 			point.parseCode(code, reader);
+			if (code == 8 && skipLayer(point.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2362,6 +2506,8 @@ bool dxfRW::processLine() {
 		}
 		default:
 			line.parseCode(code, reader);
+			if (code == 8 && skipLayer(line.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2383,6 +2529,8 @@ bool dxfRW::processRay() {
 		}
 		default:
 			line.parseCode(code, reader);
+			if (code == 8 && skipLayer(line.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2404,6 +2552,8 @@ bool dxfRW::processXline() {
 		}
 		default:
 			line.parseCode(code, reader);
+			if (code == 8 && skipLayer(line.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2427,6 +2577,8 @@ bool dxfRW::processCircle() {
 		}
 		default:
 			circle.parseCode(code, reader);
+			if (code == 8 && skipLayer(circle.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2450,6 +2602,8 @@ bool dxfRW::processArc() {
 		}
 		default:
 			arc.parseCode(code, reader);
+			if (code == 8 && skipLayer(arc.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2471,6 +2625,8 @@ bool dxfRW::processInsert() {
 		}
 		default:
 			insert.parseCode(code, reader);
+			if (code == 8 && skipLayer(insert.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2494,6 +2650,8 @@ bool dxfRW::processLWPolyline() {
 		}
 		default:
 			pl.parseCode(code, reader);
+			if (code == 8 && skipLayer(pl.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2519,6 +2677,8 @@ bool dxfRW::processPolyline() {
 		}
 		default:
 			pl.parseCode(code, reader);
+			if (code == 8 && skipLayer(pl.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2528,18 +2688,17 @@ bool dxfRW::processPolyline() {
 bool dxfRW::processVertex(DRW_Polyline *pl) {
 	DRW_DBG("dxfRW::processVertex");
 	int code;
-	DRW_Vertex *v = new DRW_Vertex();
+	DRW_Vertex *v = pl->newVertex();
 	while (reader->readRec(&code)) {
 		DRW_DBG(code); DRW_DBG("\n");
 		switch (code) {
 		case 0: {
-			pl->appendVertex(v);
 			nextentity = reader->getString();
 			DRW_DBG(nextentity); DRW_DBG("\n");
 			if (nextentity == "SEQEND") {
 			return true;  //found SEQEND no more vertex, terminate
 			} else if (nextentity == "VERTEX"){
-				v = new DRW_Vertex(); //another vertex
+				v = pl->newVertex(); //another vertex
 			}
 		}
 		default:
@@ -2565,6 +2724,8 @@ bool dxfRW::processText() {
 		}
 		default:
 			txt.parseCode(code, reader);
+			if (code == 8 && skipLayer(txt.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2587,6 +2748,8 @@ bool dxfRW::processMText() {
 		}
 		default:
 			txt.parseCode(code, reader);
+			if (code == 8 && skipLayer(txt.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2608,6 +2771,8 @@ bool dxfRW::processHatch() {
 		}
 		default:
 			hatch.parseCode(code, reader);
+			if (code == 8 && skipLayer(hatch.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2630,6 +2795,8 @@ bool dxfRW::processSpline() {
 		}
 		default:
 			sp.parseCode(code, reader);
+			if (code == 8 && skipLayer(sp.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2652,6 +2819,8 @@ bool dxfRW::processImage() {
 		}
 		default:
 			img.parseCode(code, reader);
+			if (code == 8 && skipLayer(img.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2704,6 +2873,8 @@ bool dxfRW::processDimension() {
 		}
 		default:
 			dim.parseCode(code, reader);
+			if (code == 8 && skipLayer(dim.layer))
+				return skipEntity();
 			break;
 		}
 	}
@@ -2725,6 +2896,8 @@ bool dxfRW::processLeader() {
 		}
 		default:
 			leader.parseCode(code, reader);
+			if (code == 8 && skipLayer(leader.layer))
+				return skipEntity();
 			break;
 		}
 	}
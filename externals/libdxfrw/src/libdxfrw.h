@@ -13,7 +13,10 @@
 #ifndef LIBDXFRW_H
 #define LIBDXFRW_H
 
+#include <iosfwd>
+#include <map>
 #include <string>
+#include <vector>
 #include "drw_entities.h"
 #include "drw_objects.h"
 #include "drw_header.h"
@@ -23,6 +26,26 @@
 class dxfReader;
 class dxfWriter;
 
+/// summary of a dxf file, filled by dxfRW::scan()
+struct DRW_ScanInfo {
+	DRW_ScanInfo(): version(DRW::UNKNOWNV), blocks(0), complete(false) {}
+
+	/// number of records of the given type, e.g. "LINE"
+	unsigned int count(const std::string &type) const {
+		std::map<std::string, unsigned int>::const_iterator it = entities.find(type);
+		return it != entities.end() ? it->second : 0;
+	}
+
+	DRW::Version version;
+	DRW_HeaderVars header;          ///< $INSUNITS, $EXTMIN, $EXTMAX, $ACADVER and $DWGCODEPAGE, if present
+	std::vector<std::string> layers;  ///< layer names (utf8) in file order
+	std::map<std::string, unsigned int> tableEntries; ///< records of the TABLES section by type name, e.g. "DIMSTYLE"
+	unsigned int blocks;            ///< number of block definitions
+	/// entity records of the BLOCKS and ENTITIES sections by type name, includes VERTEX and SEQEND
+	std::map<std::string, unsigned int> entities;
+	bool complete;                  ///< false if the entity sections were not scanned
+};
+
 class dxfRW {
 public:
 	dxfRW(const std::string & name);
@@ -37,7 +60,37 @@ public:
 	 * @return true for success
 	 */
 	bool read(DRW_Interface *interface_, bool ext);
+	/// reads header units and extents, layer names and entity counts of the file specified in constructor
+	/*!
+	 * Much faster than read(): no entities are created, values outside of the header
+	 * are not converted and the scan stops after the ENTITIES section.
+	 * @param info receives the result
+	 * @param countEntities if false, the scan stops after the TABLES section
+	 * @return true for success
+	 */
+	bool scan(DRW_ScanInfo *info, bool countEntities = true);
 	void setBinary(bool b) {binFile = b;}
+	/// limits the header variables passed to DRW_Interface::addHeader()
+	/*!
+	 * Must be called before read(). Values of other variables are skipped while
+	 * parsing. $ACADVER and $DWGCODEPAGE are always read.
+	 * @param names variable names including '$', empty to read all (default)
+	 */
+	void setHeaderFilter(const std::vector<std::string> &names) {header.setFilter(names);}
+	/// only reads entities on the given layers
+	/*!
+	 * Must be called before read(). Entities of other layers are skipped after
+	 * their layer (group code 8) was read, the remaining values are not converted.
+	 * Entities in block definitions are always read, they take the layer of the insert.
+	 * @param layers layer names, empty to read all layers (default)
+	 */
+	void setLayerFilter(const std::vector<std::string> &layers);
+	/// skips entities of the given types while reading
+	/*!
+	 * Must be called before read(). No values of skipped entities are converted.
+	 * @param types entity names as in the file, e.g. "TEXT" or "MTEXT"
+	 */
+	void setEntityFilter(const std::vector<std::string> &types);
 
 	bool write(DRW_Interface *interface_, DRW::Version ver, bool bin);
 	bool writeLineType(DRW_LType *ent);
@@ -72,6 +125,10 @@ public:
 	void setEllipseParts(int parts){elParts = parts;} /*!< set parts munber when convert ellipse to polyline */
 
 private:
+	/// opens fileName and creates the ascii or binary reader
+	bool openReader(std::ifstream &filestr);
+	/// used by scan() to summarize the content of the file
+	bool scanDxf(DRW_ScanInfo *info, bool countEntities);
 	/// used by read() to parse the content of the file
 	bool processDxf();
 	bool processHeader();
@@ -79,6 +136,10 @@ private:
 	bool processBlocks();
 	bool processBlock();
 	bool processEntities(bool isblock);
+	/// true if entities of layer are filtered out, see setLayerFilter()
+	bool skipLayer(const std::string &layer) const;
+	/// skips the remaining records of the current entity, including polyline vertices and attributes
+	bool skipEntity();
 	bool processObjects();
 
 	bool processLType();
@@ -136,10 +197,14 @@ private:
 	bool wlayer0;
 	bool dimstyleStd;
 	bool applyExt;
+	bool filterLayers;  /*!< true while reading entities the layer filter applies to */
+	std::vector<std::string> layerFilter;  /*!< sorted names of layers to read, empty to read all */
+	std::vector<std::string> entityFilter;  /*!< sorted names of entity types to skip */
 	bool writingBlock;
 	int elParts;  /*!< parts munber when convert ellipse to polyline */
 	std::map<std::string,int> blockMap;
 	std::vector<DRW_ImageDef*> imageDef;  /*!< imageDef list */
+	DRW_Arena entityArena;  /*!< storage of entity temporaries, reset after each entity callback */
 
 	int currHandle;
 